@@ -0,0 +1,90 @@
+/**
+ * @file control_loop.h
+ * @brief Runs app::tick() at a fixed rate on a real-time thread
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * The loop sleeps to absolute deadlines on CLOCK_MONOTONIC, so a slow cycle doesn't
+ * push every later one back. Its thread runs SCHED_FIFO above everything else in the
+ * process, pinned to one core, with its stack prefaulted and all memory locked, so
+ * neither the scheduler nor a page fault comes between it and its deadline.
+ *
+ * Without the privileges for that (CAP_SYS_NICE and CAP_IPC_LOCK, or root) the loop
+ * still runs, on a normal thread, and says so in its Stats.
+ *
+ * app:: state is only safe to touch from the control thread once it's started.
+ */
+
+#ifndef APP_CONTROL_LOOP_H_
+#define APP_CONTROL_LOOP_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace control {
+    constexpr uint32_t MIN_RATE_HZ {100};
+    constexpr uint32_t MAX_RATE_HZ {1000};
+
+    /** @brief What the loop does when a cycle ends after the next one should've started */
+    enum class eOverrunPolicy : uint8_t {
+        CATCH_UP, // Run the missed cycles back to back, keeping the original schedule
+        SKIP,     // Drop the missed cycles and carry on at the next period boundary
+        E_STOP,   // SKIP, and app::emergency_stop() after overrunLimit overruns in a row
+    };
+
+    struct Config {
+        uint32_t rateHz {100};   // MIN_RATE_HZ to MAX_RATE_HZ
+        int priority {80};       // SCHED_FIFO, 1 to 99
+        int cpu {-1};            // Core to pin the thread to, -1 for any
+        eOverrunPolicy policy {eOverrunPolicy::SKIP};
+        uint32_t overrunLimit {3}; // For eOverrunPolicy::E_STOP
+    };
+
+
+    /** @brief Histogram buckets, bucket i counts times below 2^i us */
+    constexpr size_t HISTOGRAM_BUCKETS {24};
+    using Histogram = std::array<uint64_t, HISTOGRAM_BUCKETS>;
+
+    /** @brief Upper bound of the bucket holding the given percentile (0-100), in us */
+    uint64_t percentileUs(const Histogram &histogram, double percentile) noexcept;
+
+    /** @brief Snapshot of the loop's counters */
+    struct Stats {
+        uint64_t cycles {0};
+        uint64_t overruns {0};      // Cycles that ended after the next should've started
+        uint64_t skippedCycles {0}; // Dropped by SKIP and E_STOP
+        uint64_t eStops {0};        // Times E_STOP stopped the robot
+
+        // Wake-up jitter: how late each cycle started
+        uint64_t jitterMaxNs {0};
+        uint64_t jitterTotalNs {0};
+        Histogram jitterHistUs {};
+
+        // Execution time of app::tick()
+        uint64_t execMaxNs {0};
+        uint64_t execTotalNs {0};
+        Histogram execHistUs {};
+
+        // What the thread got, false if it lacked the privileges
+        bool isRealtime {false};
+        bool isPinned {false};
+        bool isMemoryLocked {false};
+    };
+
+
+    /** @brief Locks the process's memory, see the file comment */
+    void init(const Config &config = {});
+    void deinit();
+
+    // Thread management
+    void start();
+    void stop();
+    bool isRunning();
+
+    Stats getStats();
+    void resetStats();
+
+} // namespace control
+
+#endif
@@ -0,0 +1,126 @@
+/**
+ * @file matrix.h
+ * @brief Small fixed-size matrices for filters, sized at compile time
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Just what a Kalman filter needs: products, sums, transpose and scaling, all checked
+ * for size by the compiler. Row-major floats in a std::array, so a matrix is a plain
+ * value with no heap, and loops over the fixed sizes unroll and vectorize.
+ *
+ * C++17 without exceptions, RTTI or the heap, like velocity_pid.h.
+ */
+
+#ifndef APP_MATRIX_H_
+#define APP_MATRIX_H_
+
+#include <array>
+#include <cstddef>
+
+namespace app {
+    template <size_t R, size_t C>
+    struct Matrix {
+        std::array<float, R * C> data {};
+
+        static constexpr size_t ROWS {R};
+        static constexpr size_t COLS {C};
+
+        constexpr float &operator()(size_t row, size_t col) noexcept
+        {
+            return data[row * C + col];
+        }
+
+        constexpr float operator()(size_t row, size_t col) const noexcept
+        {
+            return data[row * C + col];
+        }
+
+        static constexpr Matrix identity() noexcept
+        {
+            static_assert(R == C, "Only square matrices have an identity");
+            Matrix result {};
+            for (size_t i = 0; i < R; i++) {
+                result(i, i) = 1.0f;
+            }
+            return result;
+        }
+
+        constexpr Matrix<C, R> transpose() const noexcept
+        {
+            Matrix<C, R> result {};
+            for (size_t r = 0; r < R; r++) {
+                for (size_t c = 0; c < C; c++) {
+                    result(c, r) = (*this)(r, c);
+                }
+            }
+            return result;
+        }
+
+        constexpr Matrix &operator+=(const Matrix &other) noexcept
+        {
+            for (size_t i = 0; i < R * C; i++) {
+                data[i] += other.data[i];
+            }
+            return *this;
+        }
+
+        constexpr Matrix &operator-=(const Matrix &other) noexcept
+        {
+            for (size_t i = 0; i < R * C; i++) {
+                data[i] -= other.data[i];
+            }
+            return *this;
+        }
+
+        constexpr Matrix &operator*=(float scale) noexcept
+        {
+            for (float &value : data) {
+                value *= scale;
+            }
+            return *this;
+        }
+    };
+
+    template <size_t N>
+    using Vector = Matrix<N, 1>;
+
+
+    template <size_t R, size_t C>
+    constexpr Matrix<R, C> operator+(Matrix<R, C> left, const Matrix<R, C> &right) noexcept
+    {
+        return left += right;
+    }
+
+
+    template <size_t R, size_t C>
+    constexpr Matrix<R, C> operator-(Matrix<R, C> left, const Matrix<R, C> &right) noexcept
+    {
+        return left -= right;
+    }
+
+
+    template <size_t R, size_t C>
+    constexpr Matrix<R, C> operator*(Matrix<R, C> matrix, float scale) noexcept
+    {
+        return matrix *= scale;
+    }
+
+
+    template <size_t R, size_t N, size_t C>
+    constexpr Matrix<R, C> operator*(const Matrix<R, N> &left, const Matrix<N, C> &right) noexcept
+    {
+        Matrix<R, C> result {};
+        for (size_t r = 0; r < R; r++) {
+            for (size_t n = 0; n < N; n++) {
+                float value {left(r, n)};
+                for (size_t c = 0; c < C; c++) {
+                    result(r, c) += value * right(n, c);
+                }
+            }
+        }
+        return result;
+    }
+
+} // namespace app
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file motion_ekf.h
+ * @brief Extended Kalman filter fusing encoder speed with IMU acceleration and gyro
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * State: speed, forward acceleration, heading, yaw rate, and the accelerometer's and
+ * gyro's biases. Speed integrates acceleration and heading integrates yaw rate, with
+ * jerk and yaw acceleration as process noise. Measurements, one scalar at a time:
+ *
+ *  - encoder speed = speed
+ *  - forward accel = acceleration + accel bias
+ *  - lateral accel = speed * yaw rate (centripetal, the nonlinear one)
+ *  - gyro z        = yaw rate + gyro bias
+ *
+ * So the encoders keep the accelerometer's bias in check, the accelerometer fills in
+ * between encoder ticks and through wheel slip, and turning checks speed against the
+ * gyro.
+ *
+ * Measurements carry their own timestamps (see uart::timesync::toHostTime()) and may
+ * arrive late or out of order: each update is kept in a ring of HISTORY entries with
+ * the state after it, so a late one is slotted in at its time and the updates after
+ * it are replayed. Ones older than the whole ring are dropped.
+ *
+ * Matrices are fixed size (matrix.h), so nothing is allocated.
+ */
+
+#ifndef APP_MOTION_EKF_H_
+#define APP_MOTION_EKF_H_
+
+#include "matrix.h"
+#include "comm/uart/payloads.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace app {
+    struct MotionEkfConfig {
+        // Process noise, spectral densities
+        float jerkNoise {4.0f};       // (m/s^3)^2 / Hz
+        float yawAccelNoise {10.0f};  // (rad/s^2)^2 / Hz
+        float accelBiasNoise {1e-4f}; // (m/s^2)^2 / s
+        float gyroBiasNoise {1e-6f};  // (rad/s)^2 / s
+
+        // Measurement noise, standard deviations
+        float encoderSpeedSd {0.02f}; // m/s
+        float accelSd {0.1f};         // m/s^2
+        float gyroSd {0.005f};        // rad/s
+
+        // MPU-6050 at its default ranges, +-2 g and +-250 deg/s
+        float accelPerCount {9.80665f / 16384.0f};
+        float gyroPerCount {3.14159265f / 180.0f / 131.0f};
+    };
+
+    constexpr MotionEkfConfig MOTION_EKF_CONFIG {};
+
+
+    /**
+     * @class MotionEkf
+     * @brief Not thread safe, fed from one thread, e.g. where TELEMETRY is received.
+     */
+    class MotionEkf {
+      public:
+        static constexpr size_t STATE_SIZE {6};
+        static constexpr size_t HISTORY {32};
+
+        // Index of each value in State
+        static constexpr size_t SPEED {0};      // m/s
+        static constexpr size_t ACCEL {1};      // m/s^2, forward
+        static constexpr size_t HEADING {2};    // rad, -pi to pi, from the start
+        static constexpr size_t YAW_RATE {3};   // rad/s, counterclockwise
+        static constexpr size_t ACCEL_BIAS {4}; // m/s^2
+        static constexpr size_t GYRO_BIAS {5};  // rad/s
+
+        using State = Vector<STATE_SIZE>;
+        using Covariance = Matrix<STATE_SIZE, STATE_SIZE>;
+
+        enum class eSensor : uint8_t {
+            ENCODER_SPEED, // m/s
+            ACCEL_X,       // m/s^2, forward
+            ACCEL_Y,       // m/s^2, to the left
+            GYRO_Z,        // rad/s, counterclockwise
+        };
+
+        struct Stats {
+            uint64_t updates {0};
+            uint64_t late {0};     // Slotted in before newer measurements
+            uint64_t replayed {0}; // Updates redone because of late ones
+            uint64_t dropped {0};  // Older than the history
+        };
+
+        explicit MotionEkf(const MotionEkfConfig &config = MOTION_EKF_CONFIG) noexcept;
+
+        /**
+         * @brief Applies one measurement taken at timeS (seconds, any monotonic clock).
+         * @return false if it's older than the history and was dropped.
+         */
+        bool update(eSensor sensor, float value, double timeS) noexcept;
+
+        /** @brief Encoder speed (the average of both wheels), accel x/y and gyro z */
+        bool update(const uart::payload::Telemetry &telemetry, double timeS) noexcept;
+
+        /** @brief Estimate as of the newest measurement */
+        const State &getState() const noexcept;
+        const Covariance &getCovariance() const noexcept;
+        double getTimeS() const noexcept;
+
+        /** @brief Estimate carried forward to timeS, without changing the filter */
+        State predict(double timeS) const noexcept;
+
+        Stats getStats() const noexcept { return stats_; }
+
+        /** @brief Back to not knowing anything, biases and heading included */
+        void reset() noexcept;
+
+      private:
+        /** @brief A measurement and the estimate right after it */
+        struct Entry {
+            double timeS {0.0};
+            eSensor sensor {};
+            float value {0.0f};
+            State state {};
+            Covariance covariance {};
+        };
+
+        MotionEkfConfig config_;
+
+        // Before the first measurement
+        State initialState_ {};
+        Covariance initialCovariance_ {};
+
+        // Ring, oldest at head_
+        std::array<Entry, HISTORY> history_ {};
+        size_t head_ {0};
+        size_t count_ {0};
+
+        Stats stats_ {};
+
+        Entry &at(size_t index) noexcept { return history_[(head_ + index) % HISTORY]; }
+        const Entry &at(size_t index) const noexcept
+        {
+            return history_[(head_ + index) % HISTORY];
+        }
+
+        void predictInPlace(State &state, Covariance &covariance, double dt) const noexcept;
+        void correct(Entry &entry) const noexcept;
+    };
+
+} // namespace app
+
+#endif
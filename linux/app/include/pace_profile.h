@@ -0,0 +1,159 @@
+/**
+ * @file pace_profile.h
+ * @brief Workouts compiled into distance -> target speed tables for the control loop
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A workout is written the way runners write them, steps separated by commas or
+ * newlines:
+ *
+ *   6x400m @ 72s, 60s jog recovery
+ *   2km @ 5:30/km, 3km @ 5:00/km -> 4:30/km, 1km jog
+ *
+ *  - amount: 400m, 2.5km, 60s, 10min
+ *  - count:  6x repeats the step, a following step marked "recovery" goes between
+ *            the repeats
+ *  - target: after @, the time for the whole step (72s, 1:12, 1:02:00), a pace
+ *            (5:00/km) or a speed (3.2m/s, 12km/h). "a -> b" ramps from a to b across
+ *            the step, e.g. for progression runs and negative splits.
+ *  - jog:    instead of a target, runs the step at JOG_SPEED_MPS
+ *
+ * load() parses and compiles it once, off the control thread: the speed changes at
+ * each step are smoothed to PACE_LIMITS, centred on the step boundary so each step
+ * still averages its pace, and the result is sampled into a PaceTable. Each tick,
+ * getTarget() is then an O(1) table lookup by distance, without parsing or
+ * allocating.
+ *
+ * Plans are handed over through a triple buffer (uart::LatestValue), so load() may
+ * replace the plan mid-run: the control thread switches at its next tick, and the new
+ * plan starts from the speed the old one was at, so the target never jumps. Whatever
+ * the target did while the new plan compiled is eased out within PACE_LIMITS.
+ */
+
+#ifndef APP_PACE_PROFILE_H_
+#define APP_PACE_PROFILE_H_
+
+#include "comm/uart/payloads.h"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace app::pace {
+    constexpr size_t MAX_STEPS {64}; // After expanding repeats
+    constexpr float JOG_SPEED_MPS {2.5f};
+
+    /** @brief How quickly the target speed may change between steps */
+    struct Limits {
+        float maxAccel {0.5f}; // m/s^2
+        float maxJerk {1.0f};  // m/s^3
+    };
+
+    constexpr Limits PACE_LIMITS {};
+
+
+    /** @brief One step, at a speed that changes linearly over its distance */
+    struct Step {
+        float distanceM {0.0f};
+        float startMps {0.0f};
+        float endMps {0.0f};
+    };
+
+    struct Workout {
+        std::array<Step, MAX_STEPS> steps {};
+        size_t count {0};
+
+        float getDistance() const noexcept;
+    };
+
+
+    /**
+     * @brief Parses a workout, see the file comment. Doesn't allocate.
+     * @param error Optional, set to what's wrong when std::nullopt is returned.
+     */
+    std::optional<Workout> parse(std::string_view text, std::string *error = nullptr);
+
+
+    /**
+     * @class PaceTable
+     * @brief Target speed sampled at even distances, interpolated in between.
+     */
+    class PaceTable {
+      public:
+        static constexpr size_t CAPACITY {16384};
+        static constexpr float MIN_SPACING_M {0.25f};
+
+        /** @brief Speed at distanceM into the plan, 0 once it's over. O(1). */
+        float speedAt(float distanceM) const noexcept
+        {
+            if (distanceM >= length_ || count_ == 0) {
+                return 0.0f;
+            }
+            if (distanceM <= 0.0f) {
+                return speeds_[0];
+            }
+
+            float position {distanceM * inverseSpacing_};
+            auto index {static_cast<size_t>(position)};
+            if (index + 1 >= count_) {
+                return speeds_[count_ - 1];
+            }
+            float fraction {position - static_cast<float>(index)};
+            return speeds_[index] + fraction * (speeds_[index + 1] - speeds_[index]);
+        }
+
+        bool isEmpty() const noexcept { return count_ == 0; }
+        float getLength() const noexcept { return length_; }
+        float getSpacing() const noexcept { return spacing_; }
+
+      private:
+        friend bool compile(const Workout &workout, float startMps, PaceTable &table);
+
+        std::array<float, CAPACITY> speeds_ {};
+        size_t count_ {0};
+        float length_ {0.0f};
+        float spacing_ {MIN_SPACING_M};
+        float inverseSpacing_ {1.0f / MIN_SPACING_M};
+    };
+
+
+    /**
+     * @brief Turns a workout into a table, see the file comment.
+     * @param startMps Speed to start from, e.g. the current target. 0 starts at the
+     *                 first step's speed.
+     * @return false if the workout is empty.
+     */
+    bool compile(const Workout &workout, float startMps, PaceTable &table);
+
+
+    // Writers, from any thread but the control thread. They take turns.
+
+    /** @brief Parses, compiles and hands over a workout, replacing the current plan */
+    bool load(std::string_view workout, std::string *error = nullptr);
+
+    /** @brief Same, from a text file. '#' starts a comment. */
+    bool loadFile(const std::string &path, std::string *error = nullptr);
+
+    /**
+     * @brief Applies a CMD_NAV to the plan only: START with a speed holds that speed,
+     *        STOP and E_STOP drop the plan. START without a speed leaves the plan as it
+     *        is. Mode changes are up to the caller, e.g. app::emergency_stop().
+     */
+    void apply(const uart::payload::CmdNav &nav);
+
+    /** @brief Drops the plan, getTarget() returns std::nullopt again */
+    void clear();
+
+
+    /**
+     * @brief Control thread only, the target for this tick.
+     * @param odometerM Distance travelled so far. A new plan starts where it's first seen.
+     * @return std::nullopt without a plan, 0 once it's finished.
+     */
+    std::optional<float> getTarget(float odometerM);
+
+} // namespace app::pace
+
+#endif
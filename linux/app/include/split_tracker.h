@@ -0,0 +1,152 @@
+/**
+ * @file split_tracker.h
+ * @brief Distance, lap and split times, finish prediction and pace correction
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Fed the measured and target speed once per control cycle, SplitTracker:
+ *
+ *  - integrates encoder speed over the sample timestamps (trapezoidal) into distance
+ *  - finds each lap (400 m) and split (200 m) boundary, timed between the two samples
+ *    around it rather than at the tick, and keeps the most recent ones in fixed rings
+ *  - integrates the target the same way into the time the plan expected to take, so
+ *    the difference is how far behind (or ahead of) the plan the runner is
+ *  - predicts the finish from a smoothed speed
+ *
+ * update() returns a correction to add to the target speed that makes up the time
+ * difference over the next recoveryM, so errors don't add up lap after lap. A time
+ * error e at speed v needs roughly v^2 * e / recoveryM more speed.
+ *
+ * Everything is constant time per update, without allocation.
+ */
+
+#ifndef APP_SPLIT_TRACKER_H_
+#define APP_SPLIT_TRACKER_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace app {
+    struct SplitConfig {
+        float lapM {400.0f};
+        float splitM {200.0f};
+        float raceM {0.0f}; // 0 predicts the end of the current lap instead
+
+        float recoveryM {100.0f};        // Distance to make up a time error over
+        float maxCorrectionMps {0.3f};   // Largest correction either way
+        float speedTimeConstantS {5.0f}; // Smoothing of the speed used for predictions
+    };
+
+    constexpr SplitConfig SPLIT_CONFIG {};
+
+
+    /** @brief One lap or split */
+    struct Split {
+        uint32_t number {0}; // From 1
+        double endS {0.0};   // Timestamp it was completed at
+        float durationS {0.0f};
+        float plannedS {0.0f}; // What the target speeds would have taken
+
+        float getErrorS() const noexcept { return durationS - plannedS; }
+    };
+
+
+    /** @brief The last N items pushed, older ones are overwritten */
+    template <typename T, size_t N>
+    class History {
+      public:
+        void push(const T &item) noexcept
+        {
+            items_[total_ % N] = item;
+            total_++;
+        }
+
+        /** @brief back 0 is the latest. back must be below getSize(). */
+        const T &get(size_t back) const noexcept { return items_[(total_ - 1 - back) % N]; }
+
+        size_t getSize() const noexcept { return total_ < N ? total_ : N; }
+        uint64_t getTotal() const noexcept { return total_; }
+        void clear() noexcept { total_ = 0; }
+
+      private:
+        std::array<T, N> items_ {};
+        uint64_t total_ {0};
+    };
+
+
+    /**
+     * @class SplitTracker
+     * @brief Not thread safe, updated from the control loop.
+     */
+    class SplitTracker {
+      public:
+        static constexpr size_t HISTORY {64};
+
+        explicit SplitTracker(const SplitConfig &config = SPLIT_CONFIG) noexcept
+            : config_(config)
+        {
+        }
+
+        /**
+         * @param timeS Monotonic timestamp of the speed sample, seconds.
+         * @param speedMps Measured speed, e.g. hal::encoders::get_speed().
+         * @param targetMps Target speed before the correction. 0 pauses the plan.
+         * @return Correction to add to targetMps.
+         */
+        float update(double timeS, float speedMps, float targetMps) noexcept;
+
+        /** @brief Starts a new run, from the next update() */
+        void reset() noexcept;
+
+        double getDistance() const noexcept { return distanceM_; }
+        double getElapsedS() const noexcept { return lastTimeS_ - startS_; }
+
+        /** @brief Positive when behind the plan */
+        float getTimeErrorS() const noexcept;
+
+        /**
+         * @brief Elapsed time at raceM (or the end of the current lap) at the recent speed,
+         *        infinity while stopped.
+         */
+        double getPredictedFinishS() const noexcept;
+
+        float getCorrection() const noexcept { return correction_; }
+
+        const History<Split, HISTORY> &getLaps() const noexcept { return laps_; }
+        const History<Split, HISTORY> &getSplits() const noexcept { return splits_; }
+
+      private:
+        /** @brief Where a lap or split boundary falls next, and when the last one was */
+        struct Boundary {
+            double nextM {0.0};
+            double lastS {0.0};
+            double lastPlannedS {0.0};
+        };
+
+        SplitConfig config_;
+
+        bool isStarted_ {false};
+        double startS_ {0.0};
+        double lastTimeS_ {0.0};
+        float lastSpeed_ {0.0f};
+        float lastTarget_ {0.0f};
+
+        double distanceM_ {0.0};
+        double plannedS_ {0.0}; // Time the plan expected for distanceM_, relative to start
+        double pausedS_ {0.0};  // Time spent without a target, not held against the plan
+        float smoothedSpeed_ {0.0f};
+        float correction_ {0.0f};
+
+        Boundary lap_ {};
+        Boundary split_ {};
+        History<Split, HISTORY> laps_;
+        History<Split, HISTORY> splits_;
+
+        void crossBoundaries(Boundary &boundary, float lengthM, History<Split, HISTORY> &history,
+                             double fromM, double fromS, double fromPlannedS) noexcept;
+    };
+
+} // namespace app
+
+#endif
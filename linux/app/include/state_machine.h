@@ -1,5 +1,7 @@
 #pragma once
 
+#include "split_tracker.h"
+
 // High-level application logic
 namespace app {
 
@@ -9,19 +11,30 @@ namespace app {
         E_STOP // Emergency stop (requires reset)
     };
 
+    // Commands below may come from any thread, tick() runs on the control loop's
+    // E_STOP set by one is never overwritten by another
+
     // Set target speed in meters per second
     void set_target_speed(float mps);
 
+    // Drive at the targets of the loaded pace profile (see pace_profile.h)
+    void run_pace_profile();
+
     // Advance the state machine one cycle
     // dt = elapsed time since last tick (seconds)
     void tick(float dt);
 
-    // Immediately enter E_STOP mode
+    // Immediately enter E_STOP mode, the motors stop at the next tick()
+    // Only an atomic store, so quick enough for the I/O thread
     void emergency_stop();
 
     // Get the current operating mode
     Mode mode();
 
+    // Laps and splits of the current (or last) run
+    // Updated by tick(), so only read while tick() isn't running
+    const SplitTracker& splits();
+
     //  Reset from E_STOP back to IDLE safely
     void reset();
 
@@ -0,0 +1,193 @@
+/**
+ * @file velocity_pid.h
+ * @brief Wheel speed controller, feed-forward plus PID, run once per control cycle
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * duty = feed-forward + P + I + D, where:
+ *
+ *  - feed-forward is the motor model's duty for the target: kS against friction, kV
+ *    per m/s and kA per m/s^2. PID only corrects what the model gets wrong, e.g.
+ *    battery sag, slopes and wear.
+ *  - I integrates only while the output isn't held at a limit in the direction the
+ *    error pushes (conditional integration), so it never winds up while saturated.
+ *  - D acts on the measured speed instead of the error, so target steps don't kick it,
+ *    and is low-pass filtered against encoder quantization noise.
+ *  - The output is clamped and slew limited. Slew limits count as limits for I.
+ *  - Gains come from the band the target speed falls in. The integral is kept already
+ *    multiplied by ki, so switching bands doesn't bump the output.
+ *
+ * C++17 without exceptions, RTTI or the heap, so it would port to the STM32 as is.
+ * Configs are constexpr and checked with isValid() at compile time.
+ */
+
+#ifndef APP_VELOCITY_PID_H_
+#define APP_VELOCITY_PID_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+namespace app {
+    struct PidGains {
+        float kp {0.0f}; // Duty per m/s of error
+        float ki {0.0f}; // Duty per m/s of error per second
+        float kd {0.0f}; // Duty per m/s^2 of measured acceleration
+    };
+
+    /** @brief Gains for targets up to maxSpeedMps, and above the previous band's */
+    struct SpeedBand {
+        float maxSpeedMps {0.0f};
+        PidGains gains {};
+    };
+
+    constexpr size_t SPEED_BANDS {3};
+
+
+    struct VelocityPidConfig {
+        // Motor model feed-forward
+        float kS {0.0f}; // Duty to start moving
+        float kV {0.0f}; // Duty per m/s
+        float kA {0.0f}; // Duty per m/s^2 of target acceleration
+
+        // By increasing maxSpeedMps, the last one also covers anything faster
+        std::array<SpeedBand, SPEED_BANDS> bands {};
+
+        float derivativeCutoffHz {20.0f};
+        float outputMin {0.0f};
+        float outputMax {1.0f};
+        float slewPerSec {4.0f}; // Largest duty change per second
+    };
+
+
+    constexpr bool isValid(const VelocityPidConfig &config) noexcept
+    {
+        for (size_t i = 0; i < SPEED_BANDS; i++) {
+            const PidGains &gains {config.bands[i].gains};
+            if (gains.kp < 0.0f || gains.ki < 0.0f || gains.kd < 0.0f) {
+                return false;
+            }
+            if (i > 0 && config.bands[i].maxSpeedMps <= config.bands[i - 1].maxSpeedMps) {
+                return false;
+            }
+        }
+
+        return config.derivativeCutoffHz > 0.0f && config.outputMin < config.outputMax
+            && config.slewPerSec > 0.0f;
+    }
+
+
+    // Tuned on the mock drivetrain (hal/src/mock), where full duty is 1 m/s. Slow speeds
+    // get more integral action to hold pace against friction.
+    constexpr VelocityPidConfig VELOCITY_PID_CONFIG {
+        0.02f, // kS
+        1.0f,  // kV
+        0.05f, // kA
+        {{
+            {0.5f, {0.8f, 2.0f, 0.01f}},
+            {1.0f, {0.6f, 1.5f, 0.01f}},
+            {10.0f, {0.5f, 1.0f, 0.01f}},
+        }},
+    };
+    static_assert(isValid(VELOCITY_PID_CONFIG));
+
+
+    /**
+     * @class VelocityPid
+     * @brief One wheel (or the average of both). Allocation-free, a few dozen flops.
+     */
+    class VelocityPid {
+      public:
+        explicit constexpr VelocityPid(
+            const VelocityPidConfig &config = VELOCITY_PID_CONFIG) noexcept
+            : config_(config)
+        {
+        }
+
+        /**
+         * @param targetMps Where the robot should be going.
+         * @param measuredMps Where it is going, e.g. hal::encoders::get_speed().
+         * @param dt Seconds since the last update. The output is held if not positive.
+         * @param targetAccel How fast targetMps changes, from a speed profile, for kA.
+         * @return Duty to apply, between outputMin and outputMax.
+         */
+        constexpr float update(float targetMps, float measuredMps, float dt,
+                               float targetAccel = 0.0f) noexcept
+        {
+            if (!(dt > 0.0f)) {
+                return lastOutput_;
+            }
+
+            if (isStarted_) {
+                constexpr float TWO_PI {6.2831853f};
+                float tau {1.0f / (TWO_PI * config_.derivativeCutoffHz)};
+                float rate {(measuredMps - lastMeasured_) / dt};
+                filteredRate_ += dt / (tau + dt) * (rate - filteredRate_);
+            }
+            lastMeasured_ = measuredMps;
+            isStarted_    = true;
+
+            const PidGains &gains {getGains(targetMps)};
+            float error {targetMps - measuredMps};
+
+            float feedForward {config_.kV * targetMps + config_.kA * targetAccel};
+            if (targetMps != 0.0f) {
+                feedForward += targetMps > 0.0f ? config_.kS : -config_.kS;
+            }
+            float proportional {gains.kp * error};
+            float derivative {-gains.kd * filteredRate_};
+
+            // This cycle's limits, slew included
+            float maxStep {config_.slewPerSec * dt};
+            float low {std::max(config_.outputMin, lastOutput_ - maxStep)};
+            float high {std::min(config_.outputMax, lastOutput_ + maxStep)};
+
+            float unlimited {feedForward + proportional + integral_ + derivative};
+            bool isHeldHigh {unlimited >= high && error > 0.0f};
+            bool isHeldLow {unlimited <= low && error < 0.0f};
+            if (!isHeldHigh && !isHeldLow) {
+                integral_ += gains.ki * error * dt;
+            }
+
+            float output {feedForward + proportional + integral_ + derivative};
+            lastOutput_ = std::clamp(output, low, high);
+            return lastOutput_;
+        }
+
+        /** @brief Forgets all history, e.g. when the motors were stopped by something else */
+        constexpr void reset(float output = 0.0f) noexcept
+        {
+            integral_     = 0.0f;
+            filteredRate_ = 0.0f;
+            lastMeasured_ = 0.0f;
+            lastOutput_   = std::clamp(output, config_.outputMin, config_.outputMax);
+            isStarted_    = false;
+        }
+
+        constexpr const PidGains &getGains(float targetMps) const noexcept
+        {
+            float speed {targetMps < 0.0f ? -targetMps : targetMps};
+            for (size_t i = 0; i + 1 < SPEED_BANDS; i++) {
+                if (speed <= config_.bands[i].maxSpeedMps) {
+                    return config_.bands[i].gains;
+                }
+            }
+            return config_.bands[SPEED_BANDS - 1].gains;
+        }
+
+        float getIntegral() const noexcept { return integral_; }
+        float getOutput() const noexcept { return lastOutput_; }
+
+      private:
+        VelocityPidConfig config_;
+
+        float integral_ {0.0f};     // Already multiplied by ki
+        float filteredRate_ {0.0f}; // Measured acceleration, low-pass filtered
+        float lastMeasured_ {0.0f};
+        float lastOutput_ {0.0f};
+        bool isStarted_ {false};
+    };
+
+} // namespace app
+
+#endif
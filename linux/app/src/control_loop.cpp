@@ -0,0 +1,299 @@
+/**
+ * @file control_loop.cpp
+ * @brief Runs app::tick() at a fixed rate on a real-time thread
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "control_loop.h"
+#include "state_machine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <thread>
+
+namespace {
+    constexpr int64_t NS_PER_SEC {1'000'000'000};
+
+    // Deepest the loop and app::tick() are expected to go
+    constexpr size_t STACK_PREFAULT_BYTES {64 * 1024};
+
+    struct Counters {
+        std::atomic<uint64_t> cycles {0};
+        std::atomic<uint64_t> overruns {0};
+        std::atomic<uint64_t> skippedCycles {0};
+        std::atomic<uint64_t> eStops {0};
+        std::atomic<uint64_t> jitterMaxNs {0};
+        std::atomic<uint64_t> jitterTotalNs {0};
+        std::atomic<uint64_t> jitterHistUs[control::HISTOGRAM_BUCKETS] {};
+        std::atomic<uint64_t> execMaxNs {0};
+        std::atomic<uint64_t> execTotalNs {0};
+        std::atomic<uint64_t> execHistUs[control::HISTOGRAM_BUCKETS] {};
+    };
+
+    control::Config config_ {};
+    Counters counters_ {};
+
+    std::thread thread_;
+    std::atomic_bool isThreadRunning_ {false};
+    std::atomic_bool isRealtime_ {false};
+    std::atomic_bool isPinned_ {false};
+    bool isMemoryLocked_ {false};
+    bool isInitialized_ {false};
+
+
+    int64_t nowNs()
+    {
+        timespec now {};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return now.tv_sec * NS_PER_SEC + now.tv_nsec;
+    }
+
+
+    // Only the control thread writes, so load + store is enough
+    void record(uint64_t ns, std::atomic<uint64_t> &maxNs, std::atomic<uint64_t> &totalNs,
+                std::atomic<uint64_t> (&histUs)[control::HISTOGRAM_BUCKETS])
+    {
+        if (ns > maxNs.load(std::memory_order_relaxed)) {
+            maxNs.store(ns, std::memory_order_relaxed);
+        }
+        totalNs.fetch_add(ns, std::memory_order_relaxed);
+
+        size_t bucket {std::min<size_t>(std::bit_width(ns / 1000), control::HISTOGRAM_BUCKETS - 1)};
+        histUs[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+
+    // Touches the stack the loop will use, so it never page faults mid-cycle
+    [[gnu::noinline]] void prefaultStack()
+    {
+        volatile uint8_t stack[STACK_PREFAULT_BYTES];
+        for (size_t i = 0; i < sizeof(stack); i += 4096) {
+            stack[i] = 0;
+        }
+    }
+
+
+    void setUpThread()
+    {
+        sched_param param {};
+        param.sched_priority = config_.priority;
+        int error {pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)};
+        isRealtime_ = error == 0;
+        if (error != 0) {
+            std::cerr << "Control loop: no SCHED_FIFO (" << std::strerror(error)
+                      << "), running as a normal thread" << std::endl;
+        }
+
+        if (config_.cpu >= 0) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config_.cpu, &cpus);
+            error     = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            isPinned_ = error == 0;
+            if (error != 0) {
+                std::cerr << "Control loop: can't pin to core " << config_.cpu << " ("
+                          << std::strerror(error) << ")" << std::endl;
+            }
+        }
+
+        prefaultStack();
+    }
+
+
+    void threadLoop()
+    {
+        setUpThread();
+
+        const int64_t periodNs {NS_PER_SEC / config_.rateHz};
+        int64_t deadlineNs {nowNs() + periodNs}; // Start of the next cycle
+        int64_t lastStartNs {deadlineNs - periodNs};
+        uint32_t overrunStreak {0};
+
+        while (isThreadRunning_.load(std::memory_order_relaxed)) {
+            timespec wake {deadlineNs / NS_PER_SEC, deadlineNs % NS_PER_SEC};
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr) == EINTR) {
+            }
+
+            int64_t startNs {nowNs()};
+            record(static_cast<uint64_t>(std::max<int64_t>(startNs - deadlineNs, 0)),
+                   counters_.jitterMaxNs, counters_.jitterTotalNs, counters_.jitterHistUs);
+
+            // Actual time since the last cycle, longer than a period after skipping
+            app::tick(static_cast<float>(startNs - lastStartNs) / NS_PER_SEC);
+            lastStartNs = startNs;
+
+            int64_t endNs {nowNs()};
+            record(static_cast<uint64_t>(endNs - startNs), counters_.execMaxNs,
+                   counters_.execTotalNs, counters_.execHistUs);
+            counters_.cycles.fetch_add(1, std::memory_order_relaxed);
+
+            deadlineNs += periodNs;
+            if (endNs <= deadlineNs) {
+                overrunStreak = 0;
+                continue;
+            }
+
+            counters_.overruns.fetch_add(1, std::memory_order_relaxed);
+            overrunStreak++;
+
+            if (config_.policy == control::eOverrunPolicy::CATCH_UP) {
+                continue; // The next sleeps return at once until back on schedule
+            }
+
+            auto missed {(endNs - deadlineNs) / periodNs + 1};
+            deadlineNs += missed * periodNs;
+            counters_.skippedCycles.fetch_add(static_cast<uint64_t>(missed),
+                                              std::memory_order_relaxed);
+
+            if (config_.policy == control::eOverrunPolicy::E_STOP
+                && overrunStreak == config_.overrunLimit) {
+                app::emergency_stop();
+                counters_.eStops.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+
+    void copyHistogram(const std::atomic<uint64_t> (&from)[control::HISTOGRAM_BUCKETS],
+                       control::Histogram &to)
+    {
+        for (size_t i = 0; i < control::HISTOGRAM_BUCKETS; i++) {
+            to[i] = from[i].load(std::memory_order_relaxed);
+        }
+    }
+
+} // namespace
+
+
+namespace control {
+    uint64_t percentileUs(const Histogram &histogram, double percentile) noexcept
+    {
+        uint64_t count {0};
+        for (uint64_t bucket : histogram) {
+            count += bucket;
+        }
+        if (count == 0) {
+            return 0;
+        }
+
+        auto target {static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count))};
+        uint64_t seen {0};
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            seen += histogram[i];
+            if (seen > target || seen == count) {
+                return uint64_t {1} << i;
+            }
+        }
+        return uint64_t {1} << (HISTOGRAM_BUCKETS - 1);
+    }
+
+
+    void init(const Config &config)
+    {
+        assert(!isInitialized_);
+        assert(config.rateHz >= MIN_RATE_HZ && config.rateHz <= MAX_RATE_HZ);
+        assert(config.priority >= 1 && config.priority <= 99);
+
+        config_ = config;
+
+        // Everything mapped now and later stays in RAM, so no cycle waits on a page-in
+        isMemoryLocked_ = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+        if (!isMemoryLocked_) {
+            std::cerr << "Control loop: can't lock memory (" << std::strerror(errno) << ")"
+                      << std::endl;
+        }
+
+        resetStats();
+        isInitialized_ = true;
+    }
+
+
+    void deinit()
+    {
+        assert(isInitialized_);
+        assert(!isThreadRunning_);
+
+        if (isMemoryLocked_) {
+            munlockall();
+            isMemoryLocked_ = false;
+        }
+
+        isInitialized_ = false;
+    }
+
+
+    void start()
+    {
+        assert(isInitialized_);
+        isRealtime_      = false;
+        isPinned_        = false;
+        isThreadRunning_ = true;
+        thread_          = std::thread(threadLoop);
+    }
+
+
+    void stop()
+    {
+        assert(isInitialized_);
+
+        // Noticed within a period
+        isThreadRunning_ = false;
+        thread_.join();
+    }
+
+
+    bool isRunning()
+    {
+        assert(isInitialized_);
+        return isThreadRunning_;
+    }
+
+
+    Stats getStats()
+    {
+        Stats stats {};
+        stats.cycles        = counters_.cycles.load(std::memory_order_relaxed);
+        stats.overruns      = counters_.overruns.load(std::memory_order_relaxed);
+        stats.skippedCycles = counters_.skippedCycles.load(std::memory_order_relaxed);
+        stats.eStops        = counters_.eStops.load(std::memory_order_relaxed);
+        stats.jitterMaxNs   = counters_.jitterMaxNs.load(std::memory_order_relaxed);
+        stats.jitterTotalNs = counters_.jitterTotalNs.load(std::memory_order_relaxed);
+        stats.execMaxNs     = counters_.execMaxNs.load(std::memory_order_relaxed);
+        stats.execTotalNs   = counters_.execTotalNs.load(std::memory_order_relaxed);
+        copyHistogram(counters_.jitterHistUs, stats.jitterHistUs);
+        copyHistogram(counters_.execHistUs, stats.execHistUs);
+
+        stats.isRealtime     = isRealtime_;
+        stats.isPinned       = isPinned_;
+        stats.isMemoryLocked = isMemoryLocked_;
+        return stats;
+    }
+
+
+    void resetStats()
+    {
+        counters_.cycles.store(0, std::memory_order_relaxed);
+        counters_.overruns.store(0, std::memory_order_relaxed);
+        counters_.skippedCycles.store(0, std::memory_order_relaxed);
+        counters_.eStops.store(0, std::memory_order_relaxed);
+        counters_.jitterMaxNs.store(0, std::memory_order_relaxed);
+        counters_.jitterTotalNs.store(0, std::memory_order_relaxed);
+        counters_.execMaxNs.store(0, std::memory_order_relaxed);
+        counters_.execTotalNs.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+            counters_.jitterHistUs[i].store(0, std::memory_order_relaxed);
+            counters_.execHistUs[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace control
@@ -1,22 +1,35 @@
 #include "hal/encoders.h"
 #include "hal/motors.h"
 #include "state_machine.h"
+#include <algorithm>
 #include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <termios.h>
 #include <thread>
 
+#include "comm/shm/publisher.h"
+#include "comm/uart/baud.h"
 #include "comm/uart/manager.h"
 #include "comm/uart/packet_info.h"
 #include "comm/uart/recv.h"
+#include "comm/uart/telemetry_decoder.h"
+#include "comm/uart/timesync.h"
+#include "comm/uart/trace.h"
 
+#include "control_loop.h"
+#include "motion_ekf.h"
+#include "pace_profile.h"
 #include "timing.h"
 
 /**
  * Main demonstration program for PacerBot state machine
  * This program runs a simple sequence to test the different states
  */
-int main()
+int main(int argc, char *argv[])
 {
     /*
 using namespace std::chrono;
@@ -63,34 +76,178 @@ for (int i = 0; i < 200; ++i) {
 return 0;
     */
 
-    uart::manager::init();
+    // Optional UART device, e.g. the pty printed by stm32Emulator, --shm to share
+    // received packets with other processes (shm::Reader), and --control-hz to run
+    // app::tick() in the control loop, optionally pinned with --control-cpu, and
+    // --pace-file to run a workout (see pace_profile.h) with it
+    std::string device {uart::config::UART_DEVICE};
+    std::string paceFile;
+    bool isShmBus {false};
+    bool isControlLoop {false};
+    control::Config controlConfig {};
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--shm") == 0) {
+            isShmBus = true;
+        } else if (std::strcmp(argv[i], "--control-hz") == 0 && i + 1 < argc) {
+            isControlLoop        = true;
+            controlConfig.rateHz = std::clamp(
+                static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)),
+                control::MIN_RATE_HZ, control::MAX_RATE_HZ);
+        } else if (std::strcmp(argv[i], "--control-cpu") == 0 && i + 1 < argc) {
+            controlConfig.cpu = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pace-file") == 0 && i + 1 < argc) {
+            paceFile = argv[++i];
+        } else {
+            device = argv[i];
+        }
+    }
+
+    uart::manager::init(device);
     uart::manager::start();
+    uart::trace::dumpOnSignal(SIGUSR1); // kill -USR1 <pid> prints comm latencies
+    std::cout << "UART at " << uart::baud::negotiate() << " baud\n";
+
+    if (!paceFile.empty()) {
+        std::string error;
+        if (app::pace::loadFile(paceFile, &error)) {
+            app::run_pace_profile();
+        } else {
+            std::cerr << "Pace file: " << error << std::endl;
+        }
+    }
 
     timing::init();
+    if (isControlLoop) {
+        control::init(controlConfig);
+        control::start();
+    }
 
     std::cout << "Init done!\n";
 
-    while (uart::manager::isRunning() == uart::manager::eRunStatus::RUNNING) {
-        std::cout << "Check recv queue...\n";
-        auto newPacket = uart::recv::dequeue();
-
-        if (newPacket.has_value()) {
-            std::cout << "\nData received!! Printing packet...\n";
-            auto packet = newPacket.value();
-
-            // TODO: Print from packet class
-            const std::vector<uint8_t> &data = packet.getData();
-
-            std::cout << "Packet data: ";
-            for (uint8_t byte : data) {
-                std::cout << static_cast<char>(byte);
+    uart::TelemetryDecoder telemetryDecoder;
+    app::MotionEkf motionEkf;
+
+    // Runs on this thread, from pollMailbox() below, as soon as a packet is read
+    auto printPacket = [&telemetryDecoder, &motionEkf](const uart::DataPacket &packet) {
+        std::cout << "\nData received!! Printing packet...\n";
+
+        using uart::ePacketID;
+        using uart::PacketTag;
+
+        uart::dispatch(packet, uart::Overloaded {
+            [](PacketTag<ePacketID::DEBUG>, const uart::payload::RawBytes &text) {
+                std::cout << "Debug: ";
+                std::cout.write(reinterpret_cast<const char *>(text.data),
+                                static_cast<std::streamsize>(text.length));
+                std::cout << std::endl;
+            },
+            [&packet, &motionEkf](PacketTag<ePacketID::TELEMETRY>,
+                                  const uart::payload::Telemetry &t) {
+                std::cout << "Telemetry: speed L/R = " << t.speed_left_mmps << "/"
+                          << t.speed_right_mmps << " mm/s, gyro z = " << t.imu.gyro_z;
+
+                // Time since the STM32 sampled it, once the clocks are synced, which also
+                // places it in time for the filter
+                if (auto sampled = uart::timesync::toHostTime(packet.getTimestamp())) {
+                    auto age = std::chrono::steady_clock::now() - *sampled;
+                    std::cout << ", " << std::chrono::duration<double, std::milli>(age).count()
+                              << " ms old";
+
+                    double sampledS {
+                        std::chrono::duration<double>(sampled->time_since_epoch()).count()};
+                    if (motionEkf.update(t, sampledS)) {
+                        const auto &state = motionEkf.getState();
+                        std::cout << "\nEstimate: " << state(app::MotionEkf::SPEED, 0)
+                                  << " m/s, heading " << state(app::MotionEkf::HEADING, 0)
+                                  << " rad, yaw rate " << state(app::MotionEkf::YAW_RATE, 0)
+                                  << " rad/s";
+                    }
+                }
+                std::cout << std::endl;
+            },
+            [](PacketTag<ePacketID::BATTERY>, const uart::payload::Battery &b) {
+                std::cout << "Battery: " << b.millivolts << " mV" << std::endl;
+            },
+            [&](PacketTag<ePacketID::TELEMETRY_COMPACT>, const uart::payload::RawBytes &raw) {
+                uart::compact::Sample samples[uart::TelemetryDecoder::MAX_SAMPLES];
+                size_t count {telemetryDecoder.decode({raw.data, raw.length}, samples)};
+                for (size_t i = 0; i < count; i++) {
+                    std::cout << "Telemetry @" << samples[i].timestamp_ms
+                              << " ms: speed L/R = " << samples[i].telemetry.speed_left_mmps
+                              << "/" << samples[i].telemetry.speed_right_mmps << " mm/s"
+                              << std::endl;
+                }
+            },
+        });
+    };
+
+    for (auto id : {uart::ePacketID::DEBUG, uart::ePacketID::TELEMETRY, uart::ePacketID::BATTERY,
+                    uart::ePacketID::TELEMETRY_COMPACT}) {
+        uart::recv::subscribe(id, printPacket, uart::recv::eExecutor::MAILBOX);
+    }
+    // E-stops take effect as they're read, not behind whatever the mailbox holds
+    uart::recv::subscribe(uart::ePacketID::CMD_NAV, [](const uart::DataPacket &packet) {
+        uart::dispatch(packet, [](uart::PacketTag<uart::ePacketID::CMD_NAV>,
+                                  const uart::payload::CmdNav &nav) {
+            if (nav.action == uart::payload::eNavAction::E_STOP) {
+                app::emergency_stop();
             }
-            std::cout << std::endl;
+        });
+    });
+    // Speed commands replace the pace plan, compiled here rather than on the I/O thread,
+    // and change mode through the state machine
+    uart::recv::subscribe(
+        uart::ePacketID::CMD_NAV,
+        [](const uart::DataPacket &packet) {
+            uart::dispatch(packet, [](uart::PacketTag<uart::ePacketID::CMD_NAV>,
+                                      const uart::payload::CmdNav &nav) {
+                using uart::payload::eNavAction;
+
+                app::pace::apply(nav);
+                if (nav.action == eNavAction::START) {
+                    app::run_pace_profile();
+                } else if (nav.action == eNavAction::STOP) {
+                    app::set_target_speed(0.0f);
+                }
+            });
+        },
+        uart::recv::eExecutor::MAILBOX);
+    uart::recv::setQueueEnabled(false); // Nothing else is read
+
+    std::unique_ptr<shm::Publisher> bus;
+    if (isShmBus) {
+        try {
+            bus = std::make_unique<shm::Publisher>();
+            shm::publishFromRecv(*bus, {uart::ePacketID::TELEMETRY, uart::ePacketID::BATTERY,
+                                        uart::ePacketID::STATUS_STM32, uart::ePacketID::DEBUG});
+            std::cout << "Publishing to " << shm::DEFAULT_NAME << "\n";
+        } catch (const std::exception &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
         }
+    }
 
-        timing::sleepForMs(500);
+    while (uart::manager::isRunning() == uart::manager::eRunStatus::RUNNING) {
+        uart::recv::pollMailbox(std::chrono::milliseconds(500));
+    }
+
+    if (isControlLoop) {
+        control::stop();
+        auto stats = control::getStats();
+        std::cout << "Control loop: " << stats.cycles << " cycles, " << stats.overruns
+                  << " overruns, jitter p99 < " << control::percentileUs(stats.jitterHistUs, 99)
+                  << " us (max " << stats.jitterMaxNs / 1000 << "), tick p99 < "
+                  << control::percentileUs(stats.execHistUs, 99) << " us (max "
+                  << stats.execMaxNs / 1000 << ")" << std::endl;
+        control::deinit();
+
+        const auto &laps = app::splits().getLaps();
+        for (size_t i = laps.getSize(); i > 0; i--) {
+            const app::Split &lap {laps.get(i - 1)};
+            std::cout << "Lap " << lap.number << ": " << lap.durationS << " s ("
+                      << std::showpos << lap.getErrorS() << std::noshowpos << " s)\n";
+        }
     }
 
     timing::deinit();
-    uart::manager::deinit();
+    uart::manager::deinit(); // Drops the bus's subscriptions before the bus goes
 }
\ No newline at end of file
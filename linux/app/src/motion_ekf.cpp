@@ -0,0 +1,217 @@
+/**
+ * @file motion_ekf.cpp
+ * @brief Extended Kalman filter fusing encoder speed with IMU acceleration and gyro
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "motion_ekf.h"
+
+#include <cmath>
+
+namespace {
+    constexpr float TWO_PI {6.2831853f};
+
+    // Uncertainty before any measurement, as standard deviations. Heading is relative to
+    // the start, so it starts known.
+    constexpr float INITIAL_SPEED_SD {1.0f};
+    constexpr float INITIAL_ACCEL_SD {1.0f};
+    constexpr float INITIAL_HEADING_SD {1e-3f};
+    constexpr float INITIAL_YAW_RATE_SD {0.3f};
+    constexpr float INITIAL_ACCEL_BIAS_SD {0.5f};
+    constexpr float INITIAL_GYRO_BIAS_SD {0.05f};
+
+} // namespace
+
+
+namespace app {
+    MotionEkf::MotionEkf(const MotionEkfConfig &config) noexcept : config_(config)
+    {
+        const float initialSd[STATE_SIZE] {INITIAL_SPEED_SD,      INITIAL_ACCEL_SD,
+                                           INITIAL_HEADING_SD,    INITIAL_YAW_RATE_SD,
+                                           INITIAL_ACCEL_BIAS_SD, INITIAL_GYRO_BIAS_SD};
+        for (size_t i = 0; i < STATE_SIZE; i++) {
+            initialCovariance_(i, i) = initialSd[i] * initialSd[i];
+        }
+    }
+
+
+    bool MotionEkf::update(eSensor sensor, float value, double timeS) noexcept
+    {
+        // Goes after everything not newer than it
+        size_t index {count_};
+        while (index > 0 && at(index - 1).timeS > timeS) {
+            index--;
+        }
+        if (index == 0 && count_ == HISTORY) {
+            stats_.dropped++;
+            return false; // What came before it is gone
+        }
+
+        Entry entry {timeS, sensor, value, initialState_, initialCovariance_};
+        if (index > 0) {
+            const Entry &previous {at(index - 1)};
+            entry.state      = previous.state;
+            entry.covariance = previous.covariance;
+            predictInPlace(entry.state, entry.covariance, timeS - previous.timeS);
+        }
+        correct(entry);
+
+        if (count_ == HISTORY) {
+            head_ = (head_ + 1) % HISTORY;
+            count_--;
+            index--;
+        }
+        for (size_t i = count_; i > index; i--) {
+            at(i) = at(i - 1);
+        }
+        at(index) = entry;
+        count_++;
+        stats_.updates++;
+
+        // Redo what came after a late one, from its corrected estimate
+        if (index + 1 < count_) {
+            stats_.late++;
+        }
+        for (size_t i = index + 1; i < count_; i++) {
+            const Entry &previous {at(i - 1)};
+            Entry &next {at(i)};
+            next.state      = previous.state;
+            next.covariance = previous.covariance;
+            predictInPlace(next.state, next.covariance, next.timeS - previous.timeS);
+            correct(next);
+            stats_.replayed++;
+        }
+
+        return true;
+    }
+
+
+    bool MotionEkf::update(const uart::payload::Telemetry &telemetry, double timeS) noexcept
+    {
+        float speed {(telemetry.speed_left_mmps + telemetry.speed_right_mmps) / 2000.0f};
+
+        // All or none, as they share a timestamp
+        return update(eSensor::ENCODER_SPEED, speed, timeS)
+            && update(eSensor::ACCEL_X, telemetry.imu.accel_x * config_.accelPerCount, timeS)
+            && update(eSensor::ACCEL_Y, telemetry.imu.accel_y * config_.accelPerCount, timeS)
+            && update(eSensor::GYRO_Z, telemetry.imu.gyro_z * config_.gyroPerCount, timeS);
+    }
+
+
+    const MotionEkf::State &MotionEkf::getState() const noexcept
+    {
+        return count_ > 0 ? at(count_ - 1).state : initialState_;
+    }
+
+
+    const MotionEkf::Covariance &MotionEkf::getCovariance() const noexcept
+    {
+        return count_ > 0 ? at(count_ - 1).covariance : initialCovariance_;
+    }
+
+
+    double MotionEkf::getTimeS() const noexcept
+    {
+        return count_ > 0 ? at(count_ - 1).timeS : 0.0;
+    }
+
+
+    MotionEkf::State MotionEkf::predict(double timeS) const noexcept
+    {
+        State state {getState()};
+        Covariance covariance {getCovariance()};
+        if (count_ > 0) {
+            predictInPlace(state, covariance, timeS - getTimeS());
+        }
+        return state;
+    }
+
+
+    void MotionEkf::reset() noexcept
+    {
+        *this = MotionEkf {config_};
+    }
+
+
+    void MotionEkf::predictInPlace(State &state, Covariance &covariance,
+                                   double dtS) const noexcept
+    {
+        if (!(dtS > 0.0)) {
+            return;
+        }
+        auto dt {static_cast<float>(dtS)};
+
+        state(SPEED, 0) += state(ACCEL, 0) * dt;
+        state(HEADING, 0) = std::remainder(state(HEADING, 0) + state(YAW_RATE, 0) * dt, TWO_PI);
+
+        Covariance transition {Covariance::identity()};
+        transition(SPEED, ACCEL)      = dt;
+        transition(HEADING, YAW_RATE) = dt;
+
+        // Constant acceleration and constant yaw rate models, driven by white noise
+        Covariance noise {};
+        auto addRateNoise = [&noise, dt](size_t value, size_t rate, float density) {
+            noise(value, value) = density * dt * dt * dt / 3.0f;
+            noise(value, rate)  = density * dt * dt / 2.0f;
+            noise(rate, value)  = noise(value, rate);
+            noise(rate, rate)   = density * dt;
+        };
+        addRateNoise(SPEED, ACCEL, config_.jerkNoise);
+        addRateNoise(HEADING, YAW_RATE, config_.yawAccelNoise);
+        noise(ACCEL_BIAS, ACCEL_BIAS) = config_.accelBiasNoise * dt;
+        noise(GYRO_BIAS, GYRO_BIAS)   = config_.gyroBiasNoise * dt;
+
+        covariance = transition * covariance * transition.transpose() + noise;
+    }
+
+
+    void MotionEkf::correct(Entry &entry) const noexcept
+    {
+        State &state {entry.state};
+        Covariance &covariance {entry.covariance};
+
+        // Expected measurement and its Jacobian
+        Matrix<1, STATE_SIZE> jacobian {};
+        float expected {0.0f};
+        float sd {0.0f};
+        switch (entry.sensor) {
+        case eSensor::ENCODER_SPEED:
+            expected           = state(SPEED, 0);
+            jacobian(0, SPEED) = 1.0f;
+            sd                 = config_.encoderSpeedSd;
+            break;
+        case eSensor::ACCEL_X:
+            expected                = state(ACCEL, 0) + state(ACCEL_BIAS, 0);
+            jacobian(0, ACCEL)      = 1.0f;
+            jacobian(0, ACCEL_BIAS) = 1.0f;
+            sd                      = config_.accelSd;
+            break;
+        case eSensor::ACCEL_Y:
+            expected              = state(SPEED, 0) * state(YAW_RATE, 0);
+            jacobian(0, SPEED)    = state(YAW_RATE, 0);
+            jacobian(0, YAW_RATE) = state(SPEED, 0);
+            sd                    = config_.accelSd;
+            break;
+        case eSensor::GYRO_Z:
+            expected               = state(YAW_RATE, 0) + state(GYRO_BIAS, 0);
+            jacobian(0, YAW_RATE)  = 1.0f;
+            jacobian(0, GYRO_BIAS) = 1.0f;
+            sd                     = config_.gyroSd;
+            break;
+        }
+
+        // Scalar measurement, so the innovation covariance is a number, no inverse needed
+        Vector<STATE_SIZE> crossCovariance {covariance * jacobian.transpose()};
+        float innovationVariance {(jacobian * crossCovariance)(0, 0) + sd * sd};
+        Vector<STATE_SIZE> gain {crossCovariance * (1.0f / innovationVariance)};
+
+        state += gain * (entry.value - expected);
+        state(HEADING, 0) = std::remainder(state(HEADING, 0), TWO_PI);
+
+        // P - K (H P), kept symmetric against rounding
+        covariance -= gain * crossCovariance.transpose();
+        covariance = (covariance + covariance.transpose()) * 0.5f;
+    }
+
+} // namespace app
@@ -0,0 +1,554 @@
+/**
+ * @file pace_profile.cpp
+ * @brief Workouts compiled into distance -> target speed tables for the control loop
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "pace_profile.h"
+#include "comm/uart/latest_value.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+
+namespace {
+    using app::pace::Step;
+    using app::pace::Workout;
+
+    // Time step of the simulation that smooths the target, see compile()
+    constexpr float SIMULATION_DT {0.002f};
+
+    // Floor for the simulated speed, so a plan can't stall before its end
+    constexpr float MIN_SPEED_MPS {0.1f};
+
+    // How far a CMD_NAV speed is held, i.e. until the next command
+    constexpr float HOLD_DISTANCE_M {100000.0f};
+
+
+    /** @brief Reads one step of a workout, see pace_profile.h */
+    class Cursor {
+      public:
+        explicit Cursor(std::string_view text) noexcept : text_(text) {}
+
+        bool isDone() noexcept
+        {
+            skipSpaces();
+            return pos_ >= text_.size();
+        }
+
+        /** @brief Consumes token if it comes next, ignoring case */
+        bool accept(std::string_view token) noexcept
+        {
+            skipSpaces();
+            if (text_.size() - pos_ < token.size()) {
+                return false;
+            }
+            for (size_t i = 0; i < token.size(); i++) {
+                if (std::tolower(static_cast<unsigned char>(text_[pos_ + i])) != token[i]) {
+                    return false;
+                }
+            }
+            pos_ += token.size();
+            return true;
+        }
+
+        std::optional<float> number() noexcept
+        {
+            skipSpaces();
+            float value {};
+            auto [end, error] = std::from_chars(text_.data() + pos_, text_.data() + text_.size(),
+                                                value, std::chars_format::fixed);
+            if (error != std::errc {} || value < 0.0f) {
+                return std::nullopt;
+            }
+            pos_ = static_cast<size_t>(end - text_.data());
+            return value;
+        }
+
+        /** @brief Letters up to the next non-letter, lower case only is accepted */
+        std::string_view word() noexcept
+        {
+            skipSpaces();
+            size_t start {pos_};
+            while (pos_ < text_.size() && std::isalpha(static_cast<unsigned char>(text_[pos_]))) {
+                pos_++;
+            }
+            return text_.substr(start, pos_ - start);
+        }
+
+      private:
+        std::string_view text_;
+        size_t pos_ {0};
+
+        void skipSpaces() noexcept
+        {
+            while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+                pos_++;
+            }
+        }
+    };
+
+
+    /** @brief What follows an @ */
+    struct Target {
+        enum class eKind : uint8_t { SPEED, TOTAL_TIME } kind {eKind::SPEED};
+        float value {0.0f}; // m/s or seconds
+    };
+
+
+    // 72s, 1:12, 1:02:00, 5min, 5:00/km, 3.2m/s, 12km/h
+    std::optional<Target> parseTarget(Cursor &cursor)
+    {
+        auto value = cursor.number();
+        if (!value) {
+            return std::nullopt;
+        }
+
+        bool isClock {false};
+        while (cursor.accept(":")) {
+            auto part = cursor.number();
+            if (!part || *part >= 60.0f) {
+                return std::nullopt;
+            }
+            *value  = *value * 60.0f + *part;
+            isClock = true;
+        }
+
+        std::string_view unit {cursor.word()};
+        if (unit == "min") {
+            *value *= 60.0f;
+        } else if (unit == "s" || unit == "sec") {
+            // Already seconds
+        } else if (!isClock) {
+            // A speed, the unit is split at the /
+            if (!cursor.accept("/")) {
+                return std::nullopt;
+            }
+            std::string_view per {cursor.word()};
+            if (unit == "m" && per == "s") {
+                return Target {Target::eKind::SPEED, *value};
+            }
+            if (unit == "km" && per == "h") {
+                return Target {Target::eKind::SPEED, *value / 3.6f};
+            }
+            return std::nullopt;
+        } else if (!unit.empty()) {
+            return std::nullopt;
+        }
+
+        if (!(*value > 0.0f)) {
+            return std::nullopt;
+        }
+
+        // A time per km is a pace, otherwise it's the time for the whole step
+        if (cursor.accept("/")) {
+            if (cursor.word() != "km") {
+                return std::nullopt;
+            }
+            return Target {Target::eKind::SPEED, 1000.0f / *value};
+        }
+        return Target {Target::eKind::TOTAL_TIME, *value};
+    }
+
+
+    struct ParsedStep {
+        Step step {};
+        size_t count {1};
+        bool isRecovery {false};
+    };
+
+
+    std::optional<ParsedStep> parseStep(std::string_view text, std::string *error)
+    {
+        auto fail = [error](const char *message) -> std::optional<ParsedStep> {
+            if (error) {
+                *error = message;
+            }
+            return std::nullopt;
+        };
+
+        Cursor cursor {text};
+        ParsedStep parsed {};
+
+        auto amount = cursor.number();
+        if (cursor.accept("x")) {
+            if (!amount || *amount < 1.0f || *amount != std::floor(*amount)) {
+                return fail("repeat count must be a whole number");
+            }
+            parsed.count = static_cast<size_t>(*amount);
+            amount       = cursor.number();
+        }
+        if (!amount || !(*amount > 0.0f)) {
+            return fail("expected a distance or duration");
+        }
+
+        // Distance, or duration converted once the speed is known
+        float distanceM {0.0f};
+        float durationS {0.0f};
+        std::string_view unit {cursor.word()};
+        if (unit == "m") {
+            distanceM = *amount;
+        } else if (unit == "km") {
+            distanceM = *amount * 1000.0f;
+        } else if (unit == "s" || unit == "sec") {
+            durationS = *amount;
+        } else if (unit == "min") {
+            durationS = *amount * 60.0f;
+        } else {
+            return fail("unit must be m, km, s or min");
+        }
+
+        std::optional<Target> start {};
+        std::optional<Target> end {};
+        if (cursor.accept("@")) {
+            start = parseTarget(cursor);
+            end   = start;
+            if (start && cursor.accept("->")) {
+                end = parseTarget(cursor);
+            }
+            if (!start || !end) {
+                return fail("target must be a time, a pace per km or a speed");
+            }
+        }
+
+        bool isJog {cursor.accept("jog")};
+        parsed.isRecovery = cursor.accept("recovery");
+        if (!cursor.isDone()) {
+            return fail("unexpected text after the step");
+        }
+
+        if (!start) {
+            if (!isJog) {
+                return fail("step needs an @ target, or jog");
+            }
+            start = end = Target {Target::eKind::SPEED, app::pace::JOG_SPEED_MPS};
+        }
+
+        auto toSpeed = [distanceM](const Target &target) {
+            return target.kind == Target::eKind::SPEED ? target.value : distanceM / target.value;
+        };
+        if ((start->kind == Target::eKind::TOTAL_TIME || end->kind == Target::eKind::TOTAL_TIME)
+            && distanceM == 0.0f) {
+            return fail("a timed step needs a pace or speed, not a total time");
+        }
+
+        parsed.step.startMps  = toSpeed(*start);
+        parsed.step.endMps    = toSpeed(*end);
+        float averageMps {(parsed.step.startMps + parsed.step.endMps) / 2.0f};
+        parsed.step.distanceM = distanceM > 0.0f ? distanceM : averageMps * durationS;
+        return parsed;
+    }
+
+
+    // Distance over which the target eases from one speed to another within the limits
+    float transitionDistance(float from, float to)
+    {
+        const app::pace::Limits &limits {app::pace::PACE_LIMITS};
+        float change {std::fabs(to - from)};
+        float duration {change >= limits.maxAccel * limits.maxAccel / limits.maxJerk
+                            ? change / limits.maxAccel + limits.maxAccel / limits.maxJerk
+                            : 2.0f * std::sqrt(change / limits.maxJerk)};
+        return (from + to) / 2.0f * duration;
+    }
+
+
+    // Handed from writers to the control thread
+    uart::LatestValue<app::pace::PaceTable> plans_;
+    std::mutex writerMtx_;
+    app::pace::PaceTable scratch_; // Writers compile here, under writerMtx_
+
+    // Control thread's state
+    uint64_t seenGeneration_ {0};
+    float origin_ {0.0f};       // Odometer reading where the plan started
+    float lastOdometer_ {0.0f};
+    float lastTarget_ {0.0f};
+    float carry_ {0.0f}; // Target change while a plan compiled, eased out after the swap
+
+    // Where a new plan starts from
+    std::atomic<float> currentTarget_ {0.0f};
+
+
+    void publish(const Workout *workout)
+    {
+        std::lock_guard<std::mutex> lock(writerMtx_);
+        if (workout) {
+            app::pace::compile(*workout, currentTarget_.load(std::memory_order_relaxed), scratch_);
+        } else {
+            scratch_ = app::pace::PaceTable {};
+            currentTarget_.store(0.0f, std::memory_order_relaxed);
+        }
+        plans_.write(scratch_);
+    }
+
+} // namespace
+
+
+namespace app::pace {
+    float Workout::getDistance() const noexcept
+    {
+        float distance {0.0f};
+        for (size_t i = 0; i < count; i++) {
+            distance += steps[i].distanceM;
+        }
+        return distance;
+    }
+
+
+    std::optional<Workout> parse(std::string_view text, std::string *error)
+    {
+        Workout workout {};
+        std::optional<ParsedStep> repeated {}; // Held back in case a recovery follows
+
+        auto add = [&workout](const Step &step) {
+            if (workout.count == MAX_STEPS) {
+                return false;
+            }
+            workout.steps[workout.count++] = step;
+            return true;
+        };
+        auto flush = [&](const Step *recovery) {
+            for (size_t i = 0; i < repeated->count; i++) {
+                bool isLast {i + 1 == repeated->count};
+                if (!add(repeated->step) || (recovery && !isLast && !add(*recovery))) {
+                    return false;
+                }
+            }
+            repeated.reset();
+            return true;
+        };
+
+        while (!text.empty()) {
+            size_t end {text.find_first_of(",;\n")};
+            std::string_view part {text.substr(0, end)};
+            text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+            if (Cursor {part}.isDone()) {
+                continue; // Empty, e.g. a blank line
+            }
+
+            auto parsed = parseStep(part, error);
+            if (!parsed) {
+                return std::nullopt;
+            }
+
+            bool isAdded {true};
+            if (parsed->isRecovery && repeated) {
+                isAdded = flush(&parsed->step);
+            } else {
+                isAdded = (!repeated || flush(nullptr))
+                       && (parsed->count > 1 || add(parsed->step));
+                if (parsed->count > 1) {
+                    repeated = parsed;
+                }
+            }
+            if (!isAdded) {
+                if (error) {
+                    *error = "too many steps";
+                }
+                return std::nullopt;
+            }
+        }
+
+        if (repeated && !flush(nullptr)) {
+            if (error) {
+                *error = "too many steps";
+            }
+            return std::nullopt;
+        }
+        if (workout.count == 0) {
+            if (error) {
+                *error = "no steps";
+            }
+            return std::nullopt;
+        }
+        return workout;
+    }
+
+
+    bool compile(const Workout &workout, float startMps, PaceTable &table)
+    {
+        float length {workout.getDistance()};
+        table = PaceTable {};
+        if (workout.count == 0 || !(length > 0.0f)) {
+            return false;
+        }
+
+        // Each step's target takes over half a transition before the step starts, so
+        // the speed change is centred on the boundary
+        std::array<float, MAX_STEPS> stepStarts {};
+        std::array<float, MAX_STEPS> takeOvers {};
+        for (size_t i = 1; i < workout.count; i++) {
+            stepStarts[i] = stepStarts[i - 1] + workout.steps[i - 1].distanceM;
+            float half {transitionDistance(workout.steps[i - 1].endMps, workout.steps[i].startMps)
+                        / 2.0f};
+            takeOvers[i] = std::max(stepStarts[i] - half, takeOvers[i - 1]);
+        }
+
+        size_t step {0};
+        auto targetAt = [&](float distance) {
+            while (step + 1 < workout.count && distance >= takeOvers[step + 1]) {
+                step++;
+            }
+            const Step &current {workout.steps[step]};
+            float fraction {std::clamp((distance - stepStarts[step]) / current.distanceM, 0.0f,
+                                       1.0f)};
+            return current.startMps + fraction * (current.endMps - current.startMps);
+        };
+
+        table.spacing_ = std::max(PaceTable::MIN_SPACING_M,
+                                  length / static_cast<float>(PaceTable::CAPACITY - 1));
+        table.inverseSpacing_ = 1.0f / table.spacing_;
+        table.count_  = std::min(static_cast<size_t>(length * table.inverseSpacing_) + 1,
+                                 PaceTable::CAPACITY);
+        table.length_ = length;
+
+        // Chase the target with limited acceleration and jerk, sampling the speed each
+        // time the simulated runner passes a table entry
+        const Limits &limits {PACE_LIMITS};
+        float speed {startMps > 0.0f ? startMps : workout.steps[0].startMps};
+        float accel {0.0f};
+        double distance {0.0};
+        table.speeds_[0] = speed;
+
+        for (size_t next = 1; next < table.count_;) {
+            float error {targetAt(static_cast<float>(distance)) - speed};
+            float easing {accel * std::fabs(accel) / (2.0f * limits.maxJerk)};
+            float jerkStep {limits.maxJerk * SIMULATION_DT};
+
+            if (std::fabs(error) < jerkStep * SIMULATION_DT && std::fabs(accel) <= jerkStep) {
+                accel = 0.0f; // Arrived, without chattering around it
+                speed += error;
+
+                // Steady until the next step takes over, no need to simulate it
+                const Step &current {workout.steps[step]};
+                if (current.startMps == current.endMps) {
+                    float until {step + 1 < workout.count ? takeOvers[step + 1] : length};
+                    for (; next < table.count_
+                           && static_cast<float>(next) * table.spacing_ <= until;
+                         next++) {
+                        table.speeds_[next] = speed;
+                    }
+                    distance = std::max(distance, static_cast<double>(until));
+                    continue;
+                }
+            } else if (error > easing) {
+                accel = std::min(accel + jerkStep, limits.maxAccel);
+            } else {
+                accel = std::max(accel - jerkStep, -limits.maxAccel);
+            }
+
+            float lastSpeed {speed};
+            speed = std::max(speed + accel * SIMULATION_DT, MIN_SPEED_MPS);
+            double lastDistance {distance};
+            distance += speed * SIMULATION_DT;
+
+            for (; next < table.count_ && static_cast<double>(next) * table.spacing_ <= distance;
+                 next++) {
+                auto fraction {static_cast<float>(
+                    (static_cast<double>(next) * table.spacing_ - lastDistance)
+                    / (distance - lastDistance))};
+                table.speeds_[next] = lastSpeed + fraction * (speed - lastSpeed);
+            }
+        }
+
+        return true;
+    }
+
+
+    bool load(std::string_view workout, std::string *error)
+    {
+        auto parsed = parse(workout, error);
+        if (!parsed) {
+            return false;
+        }
+        publish(&*parsed);
+        return true;
+    }
+
+
+    bool loadFile(const std::string &path, std::string *error)
+    {
+        std::ifstream file {path};
+        if (!file) {
+            if (error) {
+                *error = "can't open " + path;
+            }
+            return false;
+        }
+
+        std::string text;
+        std::string line;
+        while (std::getline(file, line)) {
+            text += line.substr(0, line.find('#'));
+            text += '\n';
+        }
+        return load(text, error);
+    }
+
+
+    void apply(const uart::payload::CmdNav &nav)
+    {
+        using uart::payload::eNavAction;
+
+        switch (nav.action) {
+        case eNavAction::START:
+            if (nav.target_speed_mmps > 0) {
+                Workout hold {};
+                float speed {static_cast<float>(nav.target_speed_mmps) / 1000.0f};
+                hold.steps[0] = {HOLD_DISTANCE_M, speed, speed};
+                hold.count    = 1;
+                publish(&hold);
+            }
+            break;
+        case eNavAction::STOP:
+        case eNavAction::E_STOP:
+            clear();
+            break;
+        case eNavAction::NONE:
+            break;
+        }
+    }
+
+
+    void clear()
+    {
+        publish(nullptr);
+    }
+
+
+    std::optional<float> getTarget(float odometerM)
+    {
+        const auto &plan = plans_.read();
+        if (plan.generation != seenGeneration_) {
+            seenGeneration_ = plan.generation;
+            origin_         = odometerM;
+            carry_ = lastTarget_ > 0.0f ? lastTarget_ - plan.value.speedAt(0.0f) : 0.0f;
+        }
+        if (plan.value.isEmpty()) {
+            lastTarget_ = 0.0f;
+            return std::nullopt;
+        }
+
+        float target {plan.value.speedAt(odometerM - origin_)};
+        if (target == 0.0f) {
+            carry_ = 0.0f; // Finished
+        } else if (carry_ != 0.0f) {
+            // At most maxAccel, over the time the distance since the last tick took
+            float speed {std::max(target + carry_, MIN_SPEED_MPS)};
+            float ease {PACE_LIMITS.maxAccel * std::max(odometerM - lastOdometer_, 0.0f) / speed};
+            carry_ = carry_ > 0.0f ? std::max(carry_ - ease, 0.0f) : std::min(carry_ + ease, 0.0f);
+            target += carry_;
+        }
+        lastOdometer_ = odometerM;
+        lastTarget_   = target;
+
+        currentTarget_.store(target, std::memory_order_relaxed);
+        return target;
+    }
+
+} // namespace app::pace
@@ -0,0 +1,113 @@
+/**
+ * @file split_tracker.cpp
+ * @brief Distance, lap and split times, finish prediction and pace correction
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "split_tracker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace app {
+    float SplitTracker::update(double timeS, float speedMps, float targetMps) noexcept
+    {
+        if (!isStarted_) {
+            isStarted_     = true;
+            startS_        = timeS;
+            lastTimeS_     = timeS;
+            lastSpeed_     = speedMps;
+            lastTarget_    = targetMps;
+            smoothedSpeed_ = speedMps;
+            lap_           = {config_.lapM, timeS, 0.0};
+            split_         = {config_.splitM, timeS, 0.0};
+            return correction_;
+        }
+
+        double dt {timeS - lastTimeS_};
+        if (!(dt > 0.0)) {
+            return correction_; // Same or older sample
+        }
+
+        double fromM {distanceM_};
+        double fromS {lastTimeS_};
+        double fromPlannedS {plannedS_};
+
+        double stepM {(lastSpeed_ + speedMps) / 2.0 * dt};
+        distanceM_ += stepM;
+        if (lastTarget_ > 0.0f && targetMps > 0.0f) {
+            plannedS_ += stepM / ((lastTarget_ + targetMps) / 2.0);
+        } else {
+            pausedS_ += dt;
+        }
+        lastTimeS_  = timeS;
+        lastSpeed_  = speedMps;
+        lastTarget_ = targetMps;
+
+        float alpha {static_cast<float>(dt / (config_.speedTimeConstantS + dt))};
+        smoothedSpeed_ += alpha * (speedMps - smoothedSpeed_);
+
+        crossBoundaries(lap_, config_.lapM, laps_, fromM, fromS, fromPlannedS);
+        crossBoundaries(split_, config_.splitM, splits_, fromM, fromS, fromPlannedS);
+
+        correction_ = 0.0f;
+        if (targetMps > 0.0f) {
+            correction_ = targetMps * targetMps * getTimeErrorS() / config_.recoveryM;
+            correction_ = std::clamp(correction_, std::max(-config_.maxCorrectionMps, -targetMps),
+                                     config_.maxCorrectionMps);
+        }
+        return correction_;
+    }
+
+
+    void SplitTracker::reset() noexcept
+    {
+        *this = SplitTracker {config_};
+    }
+
+
+    float SplitTracker::getTimeErrorS() const noexcept
+    {
+        return static_cast<float>(getElapsedS() - pausedS_ - plannedS_);
+    }
+
+
+    double SplitTracker::getPredictedFinishS() const noexcept
+    {
+        double finishM {config_.raceM > 0.0f ? config_.raceM : lap_.nextM};
+        double remainingM {std::max(finishM - distanceM_, 0.0)};
+        if (remainingM == 0.0) {
+            return getElapsedS();
+        }
+        if (!(smoothedSpeed_ > 0.0f)) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return getElapsedS() + remainingM / smoothedSpeed_;
+    }
+
+
+    void SplitTracker::crossBoundaries(Boundary &boundary, float lengthM,
+                                       History<Split, HISTORY> &history, double fromM,
+                                       double fromS, double fromPlannedS) noexcept
+    {
+        // More than one only if a single update covers a whole split
+        while (distanceM_ >= boundary.nextM) {
+            double fraction {(boundary.nextM - fromM) / (distanceM_ - fromM)};
+            double crossS {fromS + fraction * (lastTimeS_ - fromS)};
+            double crossPlannedS {fromPlannedS + fraction * (plannedS_ - fromPlannedS)};
+
+            Split split {};
+            split.number    = static_cast<uint32_t>(history.getTotal() + 1);
+            split.endS      = crossS;
+            split.durationS = static_cast<float>(crossS - boundary.lastS);
+            split.plannedS  = static_cast<float>(crossPlannedS - boundary.lastPlannedS);
+            history.push(split);
+
+            boundary.nextM        += lengthM;
+            boundary.lastS        = crossS;
+            boundary.lastPlannedS = crossPlannedS;
+        }
+    }
+
+} // namespace app
@@ -1,62 +1,111 @@
 #include "state_machine.h"
+#include "velocity_pid.h"
+#include "pace_profile.h"
+#include "split_tracker.h"
 #include "hal/motors.h"
 #include "hal/encoders.h"
+#include <atomic>
 
 namespace app {
     // Constants
     constexpr float MOTOR_STOP_DUTY = 0.0f;
-    constexpr float FIXED_SPEED_DUTY = 0.25f; // Fixed duty for milestone 1
     
     // Current operating mode of the robot
-    static Mode current_mode = Mode::IDLE;
+    // Atomic, as commands change it from other threads than the control loop's
+    static std::atomic<Mode> current_mode = Mode::IDLE;
 
     // Target speed in meters per second
-    static float target_speed_mps = 0.0f;
+    static std::atomic<float> target_speed_mps = 0.0f;
+
+    // Holds target_speed_mps in RUN mode
+    static VelocityPid speed_pid;
+
+    // Distance travelled, to look up the pace profile's target. Double, so each tick's
+    // few mm aren't rounded off once it's a few km.
+    static double distance_m = 0.0;
+
+    // Time since start, accumulated from tick()'s dt, to time laps and splits
+    static double clock_s = 0.0;
+
+    // Laps and splits of the current run, with a correction for the time lost or gained
+    static SplitTracker split_tracker;
+    static Mode last_mode = Mode::IDLE;
+
+    // Enter mode unless in E_STOP, which only reset() leaves
+    // Compare-and-swap, so a concurrent emergency_stop() is never overwritten
+    static void enter_unless_stopped(Mode mode) {
+        Mode current = current_mode.load();
+        while (current != Mode::E_STOP && !current_mode.compare_exchange_weak(current, mode)) {
+        }
+    }
 
     void set_target_speed(float mps) {
         target_speed_mps = mps;
-        if (current_mode != Mode::E_STOP) {
-            if (mps != 0.0f) {
-                current_mode = Mode::RUN;
-            } else {
-                current_mode = Mode::IDLE;
-            }
-        }
+        enter_unless_stopped(mps != 0.0f ? Mode::RUN : Mode::IDLE);
+    }
+
+    void run_pace_profile() {
+        enter_unless_stopped(Mode::RUN);
     }
 
     void tick(float dt) {
         // Update encoders simulation (only in mock implementation)
         hal::encoders::update_simulation(dt);
+        distance_m += hal::encoders::get_speed() * dt;
+        clock_s += dt;
+
+        // Every stop ends the run
+        Mode mode = current_mode.load();
+        if (mode == Mode::RUN && last_mode != Mode::RUN) {
+            split_tracker.reset();
+        }
+        last_mode = mode;
         
-        switch (current_mode) {
+        switch (mode) {
             case Mode::IDLE:
+                speed_pid.reset();
                 hal::motors::set_duty(MOTOR_STOP_DUTY, MOTOR_STOP_DUTY);
                 break;
 
-            case Mode::RUN:
-                // Using fixed speed for milestone 1
-                // Will implement variable speed based on target_speed_mps in future milestones
-                hal::motors::set_duty(FIXED_SPEED_DUTY, FIXED_SPEED_DUTY);
+            case Mode::RUN: {
+                // A pace profile, when loaded, overrides target_speed_mps
+                float target = pace::getTarget(static_cast<float>(distance_m))
+                                   .value_or(target_speed_mps);
+                float speed = hal::encoders::get_speed();
+                target += split_tracker.update(clock_s, speed, target);
+                float duty = speed_pid.update(target, speed, dt);
+
+                // Stopped while this cycle ran, the stop wins
+                if (current_mode.load() != Mode::RUN) {
+                    duty = MOTOR_STOP_DUTY;
+                }
+                hal::motors::set_duty(duty, duty);
                 break;
+            }
 
             case Mode::E_STOP:
+                speed_pid.reset();
                 hal::motors::set_duty(MOTOR_STOP_DUTY, MOTOR_STOP_DUTY);
                 break;
         }
     }
 
     void emergency_stop() {
+        // Only tick() drives the motors, so this is safe from any thread
         current_mode = Mode::E_STOP;
-        hal::motors::set_duty(MOTOR_STOP_DUTY, MOTOR_STOP_DUTY);
     }
     
     Mode mode() {
         return current_mode;
     }
 
+    const SplitTracker& splits() {
+        return split_tracker;
+    }
+
     void reset() {
-        if (current_mode == Mode::E_STOP) {
-            current_mode = Mode::IDLE;
+        Mode expected = Mode::E_STOP;
+        if (current_mode.compare_exchange_strong(expected, Mode::IDLE)) {
             target_speed_mps = 0.0f;
         }
     }
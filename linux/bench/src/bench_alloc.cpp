@@ -0,0 +1,101 @@
+/**
+ * @file bench_alloc.cpp
+ * @brief Counts heap allocations on the uart send and receive hot paths
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Loops packets through send::enqueue() -> send::flush() -> pty -> recv::onReadable()
+ * -> recv::dequeue() on one thread, with global operator new instrumented. Exits with
+ * status 1 if anything allocates once the modules are initialized.
+ *
+ * Usage: bench_alloc [packets]
+ */
+
+#include "emulator/pty.h"
+
+#include "comm/uart/baud.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
+#include "comm/uart/send.h"
+
+#include "hal/SerialUART.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> allocCount_ {0};
+    std::atomic_bool isCounting_ {false};
+
+} // namespace
+
+
+void *operator new(size_t size)
+{
+    if (isCounting_.load(std::memory_order_relaxed)) {
+        allocCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+
+int main(int argc, char *argv[])
+{
+    size_t count {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000};
+
+    emulator::PtyPair pty;
+    auto uartPtr = std::make_shared<SerialUART>(pty.getSlavePath(), 115200, 1);
+    uartPtr->openPort();
+    uartPtr->setNonBlocking(true);
+
+    uart::send::init(uartPtr);
+    uart::recv::init(uartPtr);
+    uart::reliable::init();
+    uart::baud::init(uartPtr);
+    uart::send::setLinkRate(0); // The pty drains as fast as it is read
+
+    uint8_t payload[64] {};
+    uint8_t wire[1024];
+    size_t received {0};
+
+    isCounting_ = true;
+    for (size_t i = 0; i < count; i++) {
+        payload[0] = static_cast<uint8_t>(i);
+        uart::send::enqueue(uart::DataPacket(uart::ePacketID::TELEMETRY, payload));
+        uart::send::flush();
+
+        // Loop the frame back as if the STM32 had sent it
+        ssize_t len = read(pty.getMasterFd(), wire, sizeof(wire));
+        if (len > 0 && write(pty.getMasterFd(), wire, static_cast<size_t>(len)) != len) {
+            break;
+        }
+
+        uart::recv::onReadable();
+        while (auto packet = uart::recv::dequeue()) {
+            received++;
+        }
+    }
+    isCounting_ = false;
+
+    uint64_t allocs {allocCount_.load()};
+    std::printf("%zu packets sent, %zu received, %llu heap allocations\n", count, received,
+                static_cast<unsigned long long>(allocs));
+
+    uart::baud::deinit();
+    uart::reliable::deinit();
+    uart::recv::deinit();
+    uart::send::deinit();
+    return (allocs == 0 && received > 0) ? 0 : 1;
+}
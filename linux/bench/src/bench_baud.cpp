@@ -0,0 +1,229 @@
+/**
+ * @file bench_baud.cpp
+ * @brief Baud negotiation and fallback against an emulated STM32 on a pty
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A thread on the pty master plays the STM32 with baud::Responder and ErrorMonitor,
+ * echoing LINK_TEST and sending TELEMETRY every 10 ms. A pty has no real baud rate, so
+ * the wire is emulated: while the two ends disagree on the rate every byte arrives
+ * garbled, and above the wire's limit a share of the bytes do.
+ *
+ *  1. Limit 921600: negotiation must fail at 2M and settle on 921600.
+ *  2. Limit drops to 460800: both ends must fall back to 115200 on their own.
+ *  3. Renegotiating must settle on 460800.
+ *
+ * Exits non-zero if any step doesn't end at the expected rate.
+ */
+
+#include "emulator/pty.h"
+
+#include "comm/uart/baud.h"
+#include "comm/uart/baud_negotiation.h"
+#include "comm/uart/framer.h"
+#include "comm/uart/reactor.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
+#include "comm/uart/send.h"
+#include "hal/SerialUART.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double ERROR_RATE_ABOVE_LIMIT {0.1}; // Share of bytes garbled past the limit
+    constexpr auto TELEMETRY_PERIOD = std::chrono::milliseconds(10);
+    constexpr auto FALLBACK_TIMEOUT = std::chrono::seconds(5);
+
+    std::shared_ptr<SerialUART> uartPtr_ {nullptr};
+
+    std::atomic_bool isPeerRunning_ {false};
+    std::atomic<uint32_t> wireLimit_ {921600}; // Fastest rate the emulated wire carries
+    std::atomic<uint32_t> peerRate_ {uart::baud::BASE_BAUDRATE};
+
+    std::minstd_rand rng_ {42};
+
+
+    // Bytes as the other end would see them at the current rates
+    void garble(uint8_t *data, size_t len)
+    {
+        uint32_t rate {peerRate_};
+        bool isMismatched {rate != uartPtr_->getBaudrate()};
+        std::bernoulli_distribution isGarbled {isMismatched ? 1.0
+                                               : rate > wireLimit_ ? ERROR_RATE_ABOVE_LIMIT
+                                                                   : 0.0};
+        for (size_t i = 0; i < len; i++) {
+            if (isGarbled(rng_)) {
+                data[i] ^= static_cast<uint8_t>(1 + rng_() % 255);
+            }
+        }
+    }
+
+
+    bool peerWrite(int masterFd, const uart::DataPacket &packet)
+    {
+        uint8_t wire[uart::config::READ_BUF_SIZE];
+        size_t size {packet.serialize(wire, sizeof(wire))};
+        garble(wire, size);
+        return write(masterFd, wire, size) == static_cast<ssize_t>(size);
+    }
+
+
+    uint32_t nowMs()
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         Clock::now().time_since_epoch())
+                                         .count());
+    }
+
+
+    void setPeerRate(uint32_t rate, uart::Framer &framer, uart::baud::ErrorMonitor &monitor)
+    {
+        if (rate != peerRate_) {
+            peerRate_ = rate;
+            framer.reset();
+        }
+        monitor.reset(nowMs());
+    }
+
+
+    void peerLoop(int masterFd)
+    {
+        uart::Framer framer;
+        uart::baud::Responder responder {2000000};
+        uart::baud::ErrorMonitor monitor;
+        monitor.reset(nowMs());
+
+        auto nextTelemetry = Clock::now();
+        uint8_t chunk[64];
+
+        while (isPeerRunning_) {
+            ssize_t len = read(masterFd, chunk, sizeof(chunk));
+            if (len > 0) {
+                garble(chunk, static_cast<size_t>(len));
+            }
+
+            uint64_t discardedBefore {framer.getDiscardedBytes()};
+            uint32_t goodBytes {0};
+            framer.push(chunk, static_cast<size_t>(std::max<ssize_t>(len, 0)));
+
+            while (auto view = framer.next()) {
+                goodBytes += static_cast<uint32_t>(view->totalSize());
+                auto data = view->getData();
+
+                if (view->getID() == uart::ePacketID::LINK_TEST) {
+                    peerWrite(masterFd, view->toPacket());
+                    continue;
+                }
+
+                uart::payload::ConfigBaud request {};
+                uart::payload::ConfigBaud reply {};
+                if (view->getID() == uart::ePacketID::CONFIG_BAUD
+                    && uart::schema::decode(data.data(), data.size(), request)
+                    && responder.onRequest(request, nowMs(), reply)) {
+                    // Reply at the old rate, then switch
+                    peerWrite(masterFd, uart::makePacket<uart::ePacketID::CONFIG_BAUD>(reply));
+                    setPeerRate(responder.getRate(), framer, monitor);
+                }
+            }
+
+            auto badBytes {static_cast<uint32_t>(framer.getDiscardedBytes() - discardedBefore)};
+            bool isTripped {monitor.update(goodBytes, badBytes, nowMs())};
+            if (responder.poll(nowMs())) {
+                setPeerRate(responder.getRate(), framer, monitor);
+            } else if (isTripped && !responder.isTrial()
+                       && responder.getRate() != uart::baud::BASE_BAUDRATE) {
+                responder.fallback();
+                setPeerRate(responder.getRate(), framer, monitor);
+            }
+
+            if (Clock::now() >= nextTelemetry) {
+                peerWrite(masterFd, uart::makePacket<uart::ePacketID::TELEMETRY>({}));
+                nextTelemetry += TELEMETRY_PERIOD;
+            }
+
+            if (len <= 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+
+
+    bool negotiate(uint32_t expected)
+    {
+        auto start = Clock::now();
+        uint32_t rate {uart::baud::negotiate()};
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        bool isPassed {rate == expected && peerRate_ == expected};
+        std::printf("negotiate, wire limit %7u: %7u baud (peer %7u) in %.2f s  %s\n",
+                    static_cast<uint32_t>(wireLimit_), rate, static_cast<uint32_t>(peerRate_),
+                    elapsed, isPassed ? "ok" : "FAIL");
+        return isPassed;
+    }
+
+
+    bool fallback(uint32_t wireLimit)
+    {
+        wireLimit_ = wireLimit;
+
+        auto start = Clock::now();
+        while ((uart::baud::getRate() != uart::baud::BASE_BAUDRATE
+                || peerRate_ != uart::baud::BASE_BAUDRATE)
+               && Clock::now() - start < FALLBACK_TIMEOUT) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        bool isPassed {uart::baud::getRate() == uart::baud::BASE_BAUDRATE
+                       && peerRate_ == uart::baud::BASE_BAUDRATE};
+        std::printf("fallback,  wire limit %7u: %7u baud (peer %7u) in %.2f s  %s\n",
+                    wireLimit, uart::baud::getRate(), static_cast<uint32_t>(peerRate_),
+                    elapsed, isPassed ? "ok" : "FAIL");
+        return isPassed;
+    }
+
+} // namespace
+
+
+int main()
+{
+    emulator::PtyPair pty;
+    pty.setNonBlocking();
+    uartPtr_ = std::make_shared<SerialUART>(pty.getSlavePath(), uart::config::BAUDRATE, 1);
+    uartPtr_->openPort();
+    uart::send::init(uartPtr_);
+    uart::recv::init(uartPtr_);
+    uart::reliable::init();
+    uart::baud::init(uartPtr_);
+    uart::reactor::init(uartPtr_);
+
+    isPeerRunning_ = true;
+    std::thread peer(peerLoop, pty.getMasterFd());
+    uart::reactor::start();
+
+    bool isPassed {negotiate(921600)};
+    isPassed = fallback(460800) && isPassed;
+    isPassed = negotiate(460800) && isPassed;
+    std::printf("fallbacks: %llu, discarded bytes: %llu\n",
+                static_cast<unsigned long long>(uart::baud::getFallbackCount()),
+                static_cast<unsigned long long>(uart::recv::getDiscardedBytes()));
+
+    uart::reactor::stop();
+    isPeerRunning_ = false;
+    peer.join();
+
+    uart::reactor::deinit();
+    uart::baud::deinit();
+    uart::reliable::deinit();
+    uart::recv::deinit();
+    uart::send::deinit();
+    uartPtr_.reset();
+    return isPassed ? 0 : 1;
+}
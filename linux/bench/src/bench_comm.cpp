@@ -0,0 +1,192 @@
+/**
+ * @file bench_comm.cpp
+ * @brief End-to-end throughput and latency of uart::manager against an emulated STM32
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Runs the whole comm stack, started through uart::manager on an emulator::Stm32's pty,
+ * through a set of link conditions. The app side polls recv::dequeue() every 50 us and
+ * sends a reliable CMD_NAV at 50 Hz, which the emulator acknowledges.
+ *
+ * Latency is from the emulator generating a frame (the STM32 queueing it) to the
+ * frame coming out of recv::dequeue(), so it includes the time on the emulated wire.
+ * Frames are matched by their bytes, in order; stream frames that never come out are
+ * counted as lost.
+ *
+ * Usage: bench_comm [seconds per run]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/manager.h"
+#include "comm/uart/payloads.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    using emulator::Clock;
+    using uart::manager::eIoMode;
+
+    constexpr auto POLL_PERIOD    = std::chrono::microseconds(50);
+    constexpr auto COMMAND_PERIOD = std::chrono::milliseconds(20);
+
+    struct Scenario {
+        const char *name;
+        eIoMode mode;
+        emulator::Config config;
+    };
+
+    struct Generated {
+        uint8_t bytes[64];
+        size_t size;
+        Clock::time_point time;
+    };
+
+    // Stream frames the emulator generated and the app hasn't dequeued yet
+    std::mutex mtx_;
+    std::deque<Generated> generated_;
+
+
+    void onGenerate(const uart::DataPacket &packet, Clock::time_point time)
+    {
+        auto id = packet.getID();
+        if (id != uart::ePacketID::TELEMETRY && id != uart::ePacketID::BATTERY
+            && id != uart::ePacketID::STATUS_STM32) {
+            return; // Replies to the Radxa never reach the recv queue
+        }
+
+        Generated entry {};
+        entry.size = packet.serialize(entry.bytes, sizeof(entry.bytes));
+        entry.time = time;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        generated_.push_back(entry);
+    }
+
+
+    double percentile(const std::vector<double> &sorted, double p)
+    {
+        if (sorted.empty()) {
+            return 0;
+        }
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    }
+
+
+    void run(Scenario scenario, std::chrono::duration<double> duration)
+    {
+        scenario.config.onGenerate = onGenerate;
+        generated_.clear();
+
+        // Open the port first, nothing is sent until both ends are up
+        emulator::Stm32 stm32 {scenario.config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start(scenario.mode);
+        auto crcBefore {uart::recv::getCrcErrors()};
+        stm32.start();
+
+        std::vector<double> latenciesUs;
+        size_t received {0};
+        size_t receivedBytes {0};
+        size_t lost {0};
+
+        auto start = Clock::now();
+        auto nextCommand = start;
+        while (Clock::now() - start < duration) {
+            while (auto packet = uart::recv::dequeue()) {
+                auto now = Clock::now();
+                uint8_t bytes[64];
+                size_t size {packet->serialize(bytes, sizeof(bytes))};
+                received++;
+                receivedBytes += size;
+
+                // Everything generated before this frame and not seen was lost
+                std::lock_guard<std::mutex> lock(mtx_);
+                while (!generated_.empty()
+                       && (generated_.front().size != size
+                           || memcmp(generated_.front().bytes, bytes, size) != 0)) {
+                    generated_.pop_front();
+                    lost++;
+                }
+                if (!generated_.empty()) {
+                    latenciesUs.push_back(
+                        std::chrono::duration<double, std::micro>(now - generated_.front().time)
+                            .count());
+                    generated_.pop_front();
+                }
+            }
+
+            if (Clock::now() >= nextCommand) {
+                uart::reliable::enqueue(uart::makePacket<uart::ePacketID::CMD_NAV>({}));
+                nextCommand += COMMAND_PERIOD;
+            }
+            std::this_thread::sleep_for(POLL_PERIOD);
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        auto acked {uart::reliable::getStats().acked};
+        auto crcErrors {uart::recv::getCrcErrors() - crcBefore};
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        std::sort(latenciesUs.begin(), latenciesUs.end());
+        std::printf("%-22s %8.0f %9.0f %6llu %6zu %6llu %8.0f %8.0f %8.0f %8.0f\n",
+                    scenario.name, static_cast<double>(received) / elapsed,
+                    static_cast<double>(receivedBytes) / elapsed,
+                    static_cast<unsigned long long>(crcErrors), lost,
+                    static_cast<unsigned long long>(acked), percentile(latenciesUs, 0.5),
+                    percentile(latenciesUs, 0.9), percentile(latenciesUs, 0.99),
+                    latenciesUs.empty() ? 0.0 : latenciesUs.back());
+    }
+
+
+    emulator::Config makeConfig(double telemetryHz, uint32_t linkRateBps)
+    {
+        emulator::Config config {};
+        config.telemetryHz = telemetryHz;
+        config.linkRateBps = linkRateBps;
+        return config;
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::duration<double> duration {argc > 1 ? std::atof(argv[1]) : 2.0};
+
+    std::vector<Scenario> scenarios {
+        {"clean 100 Hz", eIoMode::THREADED, makeConfig(100, 115200)},
+        {"clean 100 Hz reactor", eIoMode::REACTOR, makeConfig(100, 115200)},
+        {"400 Hz, over 115200", eIoMode::THREADED, makeConfig(400, 115200)},
+        {"2000 Hz, 921600", eIoMode::THREADED, makeConfig(2000, 921600)},
+        {"2000 Hz, 921600 react", eIoMode::REACTOR, makeConfig(2000, 921600)},
+        {"corrupt 1%", eIoMode::THREADED, makeConfig(100, 115200)},
+        {"jitter 0-2 ms", eIoMode::THREADED, makeConfig(100, 115200)},
+        {"burst loss 1% x5", eIoMode::THREADED, makeConfig(100, 115200)},
+    };
+    scenarios[5].config.corruptRate   = 0.01;
+    scenarios[6].config.maxJitter     = std::chrono::microseconds(2000);
+    scenarios[7].config.burstLossRate = 0.01;
+
+    std::printf("%.1f s per run, latency from emulator to recv::dequeue() in us\n\n",
+                duration.count());
+    std::printf("%-22s %8s %9s %6s %6s %6s %8s %8s %8s %8s\n", "scenario", "pkt/s", "B/s",
+                "crc", "lost", "acked", "p50", "p90", "p99", "max");
+
+    for (const auto &scenario : scenarios) {
+        run(scenario, duration);
+    }
+    return 0;
+}
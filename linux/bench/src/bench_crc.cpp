@@ -0,0 +1,255 @@
+/**
+ * @file bench_crc.cpp
+ * @brief Cost and strength of the frame checksums, CRC8 vs the STM32-compatible CRC32
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Three parts:
+ *
+ *  - speed: ns per checksum of the byte-at-a-time CRC8 table and each CRC32
+ *           implementation this CPU supports, from a short frame up to a 4 KB block.
+ *  - frame: ns to serialize a packet and parse it back, with each eChecksum.
+ *  - errors: share of corrupted frames whose checksum still matches, for single bit
+ *            flips, bursts and random bytes. Longest frame, corruption outside the
+ *            checksum itself.
+ *
+ * Usage: bench_crc [corrupted frames per kind]
+ */
+
+#include "comm/uart/crc.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/packet_view.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using uart::crc::eCrc32Impl;
+
+    // Header and the largest payload, everything a checksum covers
+    constexpr size_t MAX_COVERED {uart::PACKET_HEADER_SIZE + 255};
+
+    constexpr size_t BYTES_PER_RUN {16 << 20};
+    constexpr size_t SIZES[] {8, 32, 64, 128, MAX_COVERED, 4096};
+
+    volatile uint32_t sink_ {0}; // Keeps results from being optimized out
+
+
+    struct Candidate {
+        const char *name;
+        std::optional<eCrc32Impl> impl; // CRC8 if empty
+    };
+
+    constexpr Candidate CANDIDATES[] {
+        {"crc8", std::nullopt},
+        {"crc32 table", eCrc32Impl::TABLE},
+        {"crc32 pclmul", eCrc32Impl::PCLMUL},
+        {"crc32 armv8", eCrc32Impl::ARMV8},
+    };
+
+
+    uint32_t checksum(const Candidate &candidate, const uint8_t *data, size_t len)
+    {
+        if (!candidate.impl) {
+            return uart::crc::crc8(data, len);
+        }
+        return uart::crc::crc32(*candidate.impl, data, len);
+    }
+
+
+    double nsPerCall(const Candidate &candidate, const std::vector<uint8_t> &data, size_t len)
+    {
+        size_t calls {BYTES_PER_RUN / len};
+        uint32_t crc {0};
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            crc ^= checksum(candidate, data.data(), len);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        sink_ = crc;
+        return elapsed / static_cast<double>(calls);
+    }
+
+
+    double nsPerFrame(uart::eChecksum type, size_t payloadSize)
+    {
+        constexpr size_t FRAMES {200000};
+
+        std::vector<uint8_t> payload(payloadSize, 0xA5);
+        uart::DataPacket packet {uart::ePacketID::TELEMETRY, payload};
+        uint8_t wire[uart::MAX_RAW_FRAME_SIZE];
+        uint32_t valid {0};
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < FRAMES; i++) {
+            size_t size {packet.serialize(wire, sizeof(wire), uart::eWireFormat::SYNC_LENGTH,
+                                          type)};
+            auto view = uart::DataPacketView::parse({wire, size}, nullptr, type);
+            valid += view.has_value() ? 1 : 0;
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        sink_ = valid;
+        return elapsed / static_cast<double>(FRAMES);
+    }
+
+
+    enum class eCorruption : uint8_t {
+        BIT,      // One bit flipped
+        TWO_BITS, // Two bits anywhere
+        BURST_16, // Bits within a 16 bit span, first and last flipped
+        BURST_40, // Same over 40 bits, longer than a CRC32 is guaranteed to catch
+        BYTES_4,  // 4 bytes replaced with random values
+    };
+
+    constexpr struct {
+        eCorruption kind;
+        const char *name;
+    } CORRUPTIONS[] {
+        {eCorruption::BIT, "1 bit"},
+        {eCorruption::TWO_BITS, "2 bits"},
+        {eCorruption::BURST_16, "burst 16"},
+        {eCorruption::BURST_40, "burst 40"},
+        {eCorruption::BYTES_4, "4 bytes"},
+    };
+
+
+    void flip(std::vector<uint8_t> &frame, size_t bit)
+    {
+        frame[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+    }
+
+
+    void corrupt(std::vector<uint8_t> &frame, eCorruption kind, std::mt19937_64 &rng)
+    {
+        size_t bits {frame.size() * 8};
+
+        switch (kind) {
+        case eCorruption::BIT:
+            flip(frame, rng() % bits);
+            break;
+        case eCorruption::TWO_BITS: {
+            size_t first {rng() % bits};
+            size_t second {(first + 1 + rng() % (bits - 1)) % bits};
+            flip(frame, first);
+            flip(frame, second);
+            break;
+        }
+        case eCorruption::BURST_16:
+        case eCorruption::BURST_40: {
+            size_t span {kind == eCorruption::BURST_16 ? size_t {16} : size_t {40}};
+            size_t start {rng() % (bits - span + 1)};
+            flip(frame, start);
+            flip(frame, start + span - 1);
+            for (size_t bit = start + 1; bit < start + span - 1; bit++) {
+                if (rng() % 2) {
+                    flip(frame, bit);
+                }
+            }
+            break;
+        }
+        case eCorruption::BYTES_4: {
+            size_t start {rng() % (frame.size() - 3)};
+            for (size_t i = start; i < start + 4; i++) {
+                uint8_t value {};
+                do {
+                    value = static_cast<uint8_t>(rng());
+                } while (value == frame[i]);
+                frame[i] = value;
+            }
+            break;
+        }
+        }
+    }
+
+
+    // Corrupted frames whose checksum still matches
+    size_t countUndetected(const Candidate &candidate, eCorruption kind, size_t trials)
+    {
+        std::mt19937_64 rng {static_cast<uint64_t>(kind) + 1};
+        std::vector<uint8_t> frame(MAX_COVERED);
+        size_t undetected {0};
+
+        for (size_t i = 0; i < trials; i++) {
+            for (auto &byte : frame) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            uint32_t sent {checksum(candidate, frame.data(), frame.size())};
+
+            corrupt(frame, kind, rng);
+            if (checksum(candidate, frame.data(), frame.size()) == sent) {
+                undetected++;
+            }
+        }
+        return undetected;
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t trials {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000};
+
+    std::vector<Candidate> candidates;
+    for (const auto &candidate : CANDIDATES) {
+        if (!candidate.impl || uart::crc::isSupported(*candidate.impl)) {
+            candidates.push_back(candidate);
+        }
+    }
+
+    std::vector<uint8_t> data(4096);
+    std::mt19937 rng {3};
+    for (auto &byte : data) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    std::printf("speed, ns per checksum (crc32() picks %s)\n",
+                uart::crc::getCrc32Impl() == eCrc32Impl::PCLMUL  ? "pclmul"
+                : uart::crc::getCrc32Impl() == eCrc32Impl::ARMV8 ? "armv8"
+                                                                  : "table");
+    std::printf("%-13s", "bytes");
+    for (size_t size : SIZES) {
+        std::printf(" %8zu", size);
+    }
+    std::printf(" %9s\n", "MB/s");
+
+    for (const auto &candidate : candidates) {
+        std::printf("%-13s", candidate.name);
+        double ns {0};
+        for (size_t size : SIZES) {
+            ns = nsPerCall(candidate, data, size);
+            std::printf(" %8.1f", ns);
+        }
+        std::printf(" %9.0f\n", static_cast<double>(SIZES[std::size(SIZES) - 1]) / ns * 1e3);
+    }
+
+    std::printf("\nframe, ns to serialize and parse\n");
+    std::printf("%-13s %8s %8s\n", "payload", "32", "255");
+    for (auto type : {uart::eChecksum::CRC8, uart::eChecksum::CRC32}) {
+        std::printf("%-13s %8.1f %8.1f\n", type == uart::eChecksum::CRC8 ? "crc8" : "crc32",
+                    nsPerFrame(type, 32), nsPerFrame(type, 255));
+    }
+
+    std::printf("\nerrors, undetected of %zu corrupted %zu byte frames\n", trials, MAX_COVERED);
+    std::printf("%-13s %10s %10s %10s %10s\n", "corruption", "crc8", "crc8 %", "crc32",
+                "crc32 %");
+    Candidate crc8 {CANDIDATES[0]};
+    Candidate crc32 {"crc32", uart::crc::getCrc32Impl()};
+    for (const auto &corruption : CORRUPTIONS) {
+        size_t missed8 {countUndetected(crc8, corruption.kind, trials)};
+        size_t missed32 {countUndetected(crc32, corruption.kind, trials)};
+        std::printf("%-13s %10zu %9.4f%% %10zu %9.4f%%\n", corruption.name, missed8,
+                    100.0 * static_cast<double>(missed8) / static_cast<double>(trials), missed32,
+                    100.0 * static_cast<double>(missed32) / static_cast<double>(trials));
+    }
+
+    return 0;
+}
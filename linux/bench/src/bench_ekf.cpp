@@ -0,0 +1,224 @@
+/**
+ * @file bench_ekf.cpp
+ * @brief Cost of app::MotionEkf per update, and its accuracy on delayed, reordered data
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Timing: ns per scalar update and per TELEMETRY packet (4 updates) in order, and per
+ * packet that arrives late behind a full history, i.e. the worst case replay. Compared
+ * with a 1 kHz control cycle, i.e. one packet per millisecond.
+ *
+ * Accuracy: a robot laps an oval (straights, then half circles at 0.5 rad/s) while
+ * its speed varies. TELEMETRY is sampled at 100 Hz with noisy, quantized encoders and
+ * a biased accelerometer and gyro, and arrives 2-40 ms later, so often out of order.
+ * Compares the filter with the raw sensors: encoder speed, gyro z, and gyro z
+ * integrated into a heading.
+ *
+ * Usage: bench_ekf [packets]
+ */
+
+#include "motion_ekf.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using Ekf   = app::MotionEkf;
+
+    constexpr double DT {0.001};        // Truth simulation step
+    constexpr size_t SAMPLE_EVERY {10}; // Steps per TELEMETRY
+    constexpr double DURATION_S {300.0};
+    constexpr float ACCEL_BIAS {0.3f};  // m/s^2
+    constexpr float GYRO_BIAS {0.02f};  // rad/s
+    constexpr double PI {3.14159265358979};
+
+    volatile float sink_ {0}; // Keeps results from being optimized out
+
+
+    struct Truth {
+        float speed {0};
+        float heading {0};
+        float yawRate {0};
+    };
+
+
+    struct Packet {
+        uart::payload::Telemetry telemetry {};
+        double sampledS {0};
+        double arrivesS {0};
+        size_t step {0};
+    };
+
+
+    double nsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+
+    uart::payload::Telemetry makeTelemetry(const Truth &truth, float accel, std::mt19937 &rng)
+    {
+        std::normal_distribution<float> noise {0.0f, 1.0f};
+        const app::MotionEkfConfig &config {app::MOTION_EKF_CONFIG};
+        auto counts = [](float value) {
+            return static_cast<int16_t>(std::clamp(std::lround(value), -32768L, 32767L));
+        };
+
+        uart::payload::Telemetry telemetry {};
+        telemetry.speed_left_mmps  = counts((truth.speed + 0.02f * noise(rng)) * 1000.0f);
+        telemetry.speed_right_mmps = counts((truth.speed + 0.02f * noise(rng)) * 1000.0f);
+        telemetry.imu.accel_x
+            = counts((accel + ACCEL_BIAS + 0.1f * noise(rng)) / config.accelPerCount);
+        telemetry.imu.accel_y
+            = counts((truth.speed * truth.yawRate + 0.1f * noise(rng)) / config.accelPerCount);
+        telemetry.imu.gyro_z
+            = counts((truth.yawRate + GYRO_BIAS + 0.005f * noise(rng)) / config.gyroPerCount);
+        return telemetry;
+    }
+
+
+    float headingError(float estimate, float truth)
+    {
+        return static_cast<float>(std::remainder(estimate - truth, 2 * PI));
+    }
+
+
+    void runAccuracy()
+    {
+        std::mt19937 rng {42};
+        std::uniform_real_distribution<double> latency {0.002, 0.040};
+
+        std::vector<Truth> truths;
+        std::vector<Packet> packets;
+        Truth truth {};
+        auto steps {static_cast<size_t>(DURATION_S / DT)};
+        for (size_t step = 0; step < steps; step++) {
+            double t {static_cast<double>(step) * DT};
+
+            // Speed eases between 0.8 and 1.2 m/s every 10 s, from standstill
+            float targetSpeed {std::fmod(t, 20.0) < 10.0 ? 0.8f : 1.2f};
+            float accel {std::clamp((targetSpeed - truth.speed) * 2.0f, -0.5f, 0.5f)};
+
+            // 10 s straight, then a half circle
+            constexpr double STRAIGHT_S {10.0};
+            constexpr double BEND_S {PI / 0.5};
+            truth.yawRate = std::fmod(t, STRAIGHT_S + BEND_S) >= STRAIGHT_S ? 0.5f : 0.0f;
+
+            if (step % SAMPLE_EVERY == 0) {
+                packets.push_back({makeTelemetry(truth, accel, rng), t, t + latency(rng), step});
+            }
+            truths.push_back(truth);
+
+            truth.speed += accel * static_cast<float>(DT);
+            truth.heading = static_cast<float>(
+                std::remainder(truth.heading + truth.yawRate * DT, 2 * PI));
+        }
+
+        std::stable_sort(packets.begin(), packets.end(), [](const Packet &a, const Packet &b) {
+            return a.arrivesS < b.arrivesS;
+        });
+
+        Ekf ekf {};
+        const app::MotionEkfConfig &config {app::MOTION_EKF_CONFIG};
+        double rawSpeedSq {0}, ekfSpeedSq {0}, rawYawSq {0}, ekfYawSq {0};
+        double rawHeadingSq {0}, ekfHeadingSq {0};
+        size_t count {0};
+        float rawHeading {0};
+        double lastRawS {0};
+
+        for (const Packet &packet : packets) {
+            ekf.update(packet.telemetry, packet.sampledS);
+
+            // Raw gyro integrated as packets come, as naive code would
+            float gyro {packet.telemetry.imu.gyro_z * config.gyroPerCount};
+            if (packet.sampledS > lastRawS) {
+                rawHeading += gyro * static_cast<float>(packet.sampledS - lastRawS);
+                lastRawS = packet.sampledS;
+            }
+
+            // Compared where the filter is, i.e. at the newest measurement
+            const Truth &now {truths[static_cast<size_t>(std::lround(ekf.getTimeS() / DT))]};
+            const Truth &sampled {truths[packet.step]};
+            const Ekf::State &state {ekf.getState()};
+            float rawSpeed {(packet.telemetry.speed_left_mmps + packet.telemetry.speed_right_mmps)
+                            / 2000.0f};
+
+            rawSpeedSq += std::pow(rawSpeed - sampled.speed, 2);
+            ekfSpeedSq += std::pow(state(Ekf::SPEED, 0) - now.speed, 2);
+            rawYawSq += std::pow(gyro - sampled.yawRate, 2);
+            ekfYawSq += std::pow(state(Ekf::YAW_RATE, 0) - now.yawRate, 2);
+            rawHeadingSq += std::pow(headingError(rawHeading, truths[packet.step].heading), 2);
+            ekfHeadingSq += std::pow(headingError(state(Ekf::HEADING, 0), now.heading), 2);
+            count++;
+        }
+
+        const Ekf::State &state {ekf.getState()};
+        auto rms = [count](double sumSq) { return std::sqrt(sumSq / static_cast<double>(count)); };
+        std::printf("%-22s %10s %10s\n", "RMS error", "raw", "ekf");
+        std::printf("%-22s %10.4f %10.4f\n", "speed, m/s", rms(rawSpeedSq), rms(ekfSpeedSq));
+        std::printf("%-22s %10.4f %10.4f\n", "yaw rate, rad/s", rms(rawYawSq), rms(ekfYawSq));
+        std::printf("%-22s %10.4f %10.4f\n", "heading, rad", rms(rawHeadingSq), rms(ekfHeadingSq));
+        std::printf("%-22s %10.4f %10.4f\n", "heading at end, rad",
+                    std::fabs(headingError(rawHeading, truths.back().heading)),
+                    std::fabs(headingError(state(Ekf::HEADING, 0), truths.back().heading)));
+        std::printf("\nbiases: accel %.3f (true %.3f), gyro %.4f (true %.4f)\n",
+                    state(Ekf::ACCEL_BIAS, 0), ACCEL_BIAS, state(Ekf::GYRO_BIAS, 0), GYRO_BIAS);
+
+        Ekf::Stats stats {ekf.getStats()};
+        std::printf("%zu packets: %llu updates, %llu late, %llu replayed, %llu dropped\n",
+                    packets.size(), static_cast<unsigned long long>(stats.updates),
+                    static_cast<unsigned long long>(stats.late),
+                    static_cast<unsigned long long>(stats.replayed),
+                    static_cast<unsigned long long>(stats.dropped));
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t packets {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000};
+
+    std::mt19937 rng {1};
+    Truth truth {0.9f, 0.0f, 0.3f};
+    uart::payload::Telemetry telemetry {makeTelemetry(truth, 0.0f, rng)};
+
+    // In order, one packet per ms
+    Ekf ekf {};
+    auto start = Clock::now();
+    for (size_t i = 0; i < packets; i++) {
+        telemetry.speed_left_mmps = static_cast<int16_t>(900 + (i & 0xF));
+        ekf.update(telemetry, static_cast<double>(i) * 0.001);
+    }
+    double inOrderNs {nsSince(start) / static_cast<double>(packets)};
+    sink_ = ekf.getState()(Ekf::SPEED, 0);
+
+    // Each packet just after the oldest kept, so the whole history is replayed
+    size_t lateCount {packets / 50};
+    double lateNs {0};
+    for (size_t i = 0; i < lateCount; i++) {
+        double oldestS {ekf.getTimeS() - (Ekf::HISTORY - 5) * 0.00025};
+        start = Clock::now();
+        ekf.update(telemetry, oldestS);
+        lateNs += nsSince(start);
+        ekf.update(telemetry, ekf.getTimeS() + 0.001); // Keeps time moving
+    }
+    lateNs /= static_cast<double>(lateCount);
+    sink_ = ekf.getState()(Ekf::SPEED, 0);
+
+    std::printf("update(): %.0f ns per measurement, %.0f ns per TELEMETRY in order "
+                "(%.2f%% of 1 ms)\n",
+                inOrderNs / 4, inOrderNs, inOrderNs / 1e4);
+    std::printf("          %.0f ns per TELEMETRY arriving behind the whole history "
+                "(%.2f%% of 1 ms)\n\n",
+                lateNs, lateNs / 1e4);
+
+    runAccuracy();
+    return 0;
+}
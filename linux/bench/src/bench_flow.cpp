@@ -0,0 +1,230 @@
+/**
+ * @file bench_flow.cpp
+ * @brief Radxa -> STM32 overruns and throughput with and without credit flow control
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Runs uart::manager against an emulator::Stm32 with a small receive buffer and the app
+ * side sending CONFIG_PID_SPEED back to back, as fast as send's CONFIG lane takes them.
+ * With credit off the emulator never advertises, as firmware without flow control, and
+ * whatever lands while its buffer is full is lost. With credit on nothing should be,
+ * except in the burst sent before the first STATUS_STM32 arrives.
+ *
+ * Consumed counts every frame the emulated STM32 application took, including the comm
+ * stack's own time sync pings, and throughput is those in wire bytes.
+ *
+ * Last, an E_STOP is enqueued while CONFIG packets are held back for credit by an
+ * STM32 that barely consumes. Safety packets don't need credit, so it must still go
+ * out at once, and the send thread must sleep rather than spin while it stays blocked.
+ * Then, with pacing off so a batch can fill up, a burst of large safety packets goes
+ * past a blocked packet, which must still be sent once credit returns.
+ *
+ * Usage: bench_flow [seconds per run]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/config.h"
+#include "comm/uart/manager.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/send.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <thread>
+
+namespace {
+    using emulator::Clock;
+
+    constexpr uint16_t RX_BUFFER_BYTES {256};
+
+    struct Scenario {
+        const char *name;
+        uint32_t consumeBps; // Bits per second, 0 as fast as it lands
+        bool isCreditAdvertised;
+    };
+
+
+    void run(const Scenario &scenario, std::chrono::duration<double> duration)
+    {
+        emulator::Config config {};
+        config.rxBufferBytes      = RX_BUFFER_BYTES;
+        config.rxConsumeBps       = scenario.consumeBps;
+        config.isCreditAdvertised = scenario.isCreditAdvertised;
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        stm32.start();
+
+        uint64_t enqueued {0};
+        auto start = Clock::now();
+        while (Clock::now() - start < duration) {
+            while (uart::recv::dequeue().has_value()) {}
+
+            uart::payload::ConfigPid pid {1.0f, 0.1f, 0.01f, static_cast<float>(enqueued)};
+            if (uart::send::enqueue(uart::makePacket<uart::ePacketID::CONFIG_PID_SPEED>(pid))) {
+                enqueued++;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Lane full
+            }
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        auto stats = stm32.getStats();
+        auto flow  = uart::send::getFlowStats();
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        uint64_t delivered {stats.receivedFrames};
+        std::printf("%-26s %8llu %8llu %8llu %6.1f%% %9.0f %7llu %7llu\n", scenario.name,
+                    static_cast<unsigned long long>(enqueued),
+                    static_cast<unsigned long long>(delivered),
+                    static_cast<unsigned long long>(stats.overrunFrames),
+                    delivered + stats.overrunFrames > 0
+                        ? 100.0 * static_cast<double>(stats.overrunFrames)
+                              / static_cast<double>(delivered + stats.overrunFrames)
+                        : 0.0,
+                    static_cast<double>(stats.receivedBytes) / elapsed,
+                    static_cast<unsigned long long>(flow.stalls),
+                    static_cast<unsigned long long>(stats.creditUpdates));
+    }
+
+
+
+    void runEStop()
+    {
+        emulator::Config config {};
+        config.rxBufferBytes = RX_BUFFER_BYTES;
+        config.rxConsumeBps  = 100; // A few bytes a second, so credit runs out at once
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        stm32.start();
+
+        // Fill the CONFIG lane until one is held back for credit
+        auto start = Clock::now();
+        while (uart::send::getFlowStats().stalls == 0
+               && Clock::now() - start < std::chrono::seconds(2)) {
+            uart::payload::ConfigPid pid {1.0f, 0.1f, 0.01f, 0.0f};
+            uart::send::enqueue(uart::makePacket<uart::ePacketID::CONFIG_PID_SPEED>(pid));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        bool isBlocked {uart::send::getFlowStats().stalls > 0};
+
+        uart::payload::CmdNav stop {0, 0, uart::payload::eNavAction::E_STOP};
+        uart::send::enqueue(uart::makePacket<uart::ePacketID::CMD_NAV>(stop),
+                            uart::send::ePriority::SAFETY);
+        auto enqueued = Clock::now();
+        while (uart::send::getLaneStats(uart::send::ePriority::SAFETY).sent == 0
+               && Clock::now() - enqueued < std::chrono::milliseconds(500)) {
+            std::this_thread::yield();
+        }
+        auto sentAfter = Clock::now() - enqueued;
+        uint64_t sent {uart::send::getLaneStats(uart::send::ePriority::SAFETY).sent};
+
+        // CPU used by the process while send stays blocked, i.e. mostly idle threads
+        std::clock_t cpuStart {std::clock()};
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        double cpuShare {static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC / 0.5};
+
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        std::printf("\nE_STOP behind a credit-blocked CONFIG packet: %s, %s in %.2f ms, "
+                    "%.1f%% CPU while blocked\n",
+                    isBlocked ? "blocked" : "never blocked (not tested)",
+                    sent > 0 ? "sent" : "NOT SENT",
+                    std::chrono::duration<double, std::milli>(sentAfter).count(),
+                    100.0 * cpuShare);
+    }
+
+
+    void runSafetyBurst()
+    {
+        emulator::Config config {};
+        config.rxBufferBytes = RX_BUFFER_BYTES;
+        config.rxConsumeBps  = 20000;
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        stm32.start();
+        uart::send::setLinkRate(0);
+        uart::send::resetLaneStats();
+
+        // Fill a lane until one is held back for credit. STATUS, as time sync pings go
+        // out in CONFIG.
+        uint64_t enqueued {0};
+        auto start = Clock::now();
+        while (uart::send::getFlowStats().stalls == 0
+               && Clock::now() - start < std::chrono::seconds(2)) {
+            uart::payload::ConfigPid pid {1.0f, 0.1f, 0.01f, 0.0f};
+            if (uart::send::enqueue(uart::makePacket<uart::ePacketID::CONFIG_PID_SPEED>(pid),
+                                    uart::send::ePriority::STATUS)) {
+                enqueued++;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        bool isBlocked {uart::send::getFlowStats().stalls > 0};
+
+        // More than a batch holds
+        uint8_t data[200] {};
+        for (size_t i = 0; i < uart::config::MAX_TX_QUEUE_SIZE; i++) {
+            uart::send::enqueue(uart::DataPacket(uart::ePacketID::STATUS_RADXA, data),
+                                uart::send::ePriority::SAFETY);
+        }
+
+        // Every one of them goes out as the STM32 catches up
+        auto accounted = []() {
+            auto stats = uart::send::getLaneStats(uart::send::ePriority::STATUS);
+            return stats.sent + stats.droppedStale;
+        };
+        start = Clock::now();
+        while (accounted() < enqueued && Clock::now() - start < std::chrono::seconds(3)) {
+            while (uart::recv::dequeue().has_value()) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        uint64_t lost {enqueued - accounted()};
+
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        std::printf("Safety burst past it, unpaced: %s, %llu of %llu held back packets lost\n",
+                    isBlocked ? "blocked" : "never blocked (not tested)",
+                    static_cast<unsigned long long>(lost),
+                    static_cast<unsigned long long>(enqueued));
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::duration<double> duration {argc > 1 ? std::atof(argv[1]) : 3.0};
+
+    const Scenario scenarios[] {
+        {"no credit, slow consumer", 20000, false},
+        {"credit, slow consumer", 20000, true},
+        {"no credit, fast consumer", 0, false},
+        {"credit, fast consumer", 0, true},
+    };
+
+    std::printf("%.1f s per run, %u byte STM32 receive buffer, 115200 link\n\n",
+                duration.count(), RX_BUFFER_BYTES);
+    std::printf("%-26s %8s %8s %8s %7s %9s %7s %7s\n", "scenario", "sent", "consumed",
+                "overrun", "lost", "B/s", "stalls", "adverts");
+
+    for (const auto &scenario : scenarios) {
+        run(scenario, duration);
+    }
+    runEStop();
+    runSafetyBurst();
+    return 0;
+}
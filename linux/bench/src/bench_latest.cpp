@@ -0,0 +1,178 @@
+/**
+ * @file bench_latest.cpp
+ * @brief Cost of uart::LatestValue, and how stale a slow control loop's TELEMETRY is
+ *        with recv's FIFO versus a conflated channel
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * First times write() and read() of a DataPacket slot, alone and with the writer on
+ * another thread. Then runs uart::manager against an emulator::Stm32 streaming TELEMETRY
+ * at 1000 Hz, with a control loop that takes one sample every 5 ms: once dequeuing the
+ * oldest from the FIFO, once reading the newest with recv::readLatest(). Age is from the
+ * STM32 sampling it (through uart::timesync) to the loop getting it. Skipped is samples
+ * the loop never saw, evicted from the full FIFO or overwritten in the slot.
+ *
+ * Usage: bench_latest [seconds per run]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/latest_value.h"
+#include "comm/uart/manager.h"
+#include "comm/uart/payloads.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/timesync.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+    using emulator::Clock;
+
+    constexpr size_t OPERATIONS {10'000'000};
+    constexpr auto LOOP_PERIOD = std::chrono::milliseconds(5);
+
+    uart::LatestValue<std::optional<uart::DataPacket>> slot_ {};
+
+
+    double nsPer(Clock::time_point start, size_t operations)
+    {
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        return elapsed / static_cast<double>(operations);
+    }
+
+
+    void timeSlot()
+    {
+        const auto packet = uart::makePacket<uart::ePacketID::TELEMETRY>({});
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < OPERATIONS; i++) {
+            slot_.write(packet);
+        }
+        std::printf("write():                %6.1f ns\n", nsPer(start, OPERATIONS));
+
+        uint64_t generations {0};
+        start = Clock::now();
+        for (size_t i = 0; i < OPERATIONS; i++) {
+            generations += slot_.read().generation;
+        }
+        std::printf("read(), nothing new:    %6.1f ns\n", nsPer(start, OPERATIONS));
+
+        // Writer flat out on another thread, the reader never waits for it
+        std::atomic_bool isWriting {true};
+        std::thread writer([&isWriting, &packet]() {
+            while (isWriting.load(std::memory_order_relaxed)) {
+                slot_.write(packet);
+            }
+        });
+        uint64_t fresh {0};
+        start = Clock::now();
+        for (size_t i = 0; i < OPERATIONS; i++) {
+            fresh += slot_.hasNew() ? 1 : 0;
+            generations += slot_.read().generation;
+        }
+        std::printf("read(), writer running: %6.1f ns, %.0f%% new\n", nsPer(start, OPERATIONS),
+                    100.0 * static_cast<double>(fresh) / OPERATIONS);
+        isWriting = false;
+        writer.join();
+
+        if (generations == 0) {
+            std::printf("(never read a write)\n");
+        }
+    }
+
+
+    double percentile(const std::vector<double> &sorted, double p)
+    {
+        return sorted.empty() ? 0 : sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+    }
+
+
+    void runLoop(const char *name, bool isConflated, std::chrono::duration<double> duration)
+    {
+        emulator::Config config {};
+        config.telemetryHz = 1000;
+        config.linkRateBps = 921600;
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        uart::recv::setConflated(uart::ePacketID::TELEMETRY, isConflated);
+        stm32.start();
+
+        // Ages are only known once the clocks are synced
+        while (!uart::timesync::isSynced()) {
+            uart::recv::clearQueue();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        std::vector<double> agesMs;
+        uint64_t lastGeneration {0};
+        uint64_t skipped {0};
+        auto start = Clock::now();
+        auto next  = start;
+        while (Clock::now() - start < duration) {
+            std::optional<uart::DataPacket> telemetry;
+            if (isConflated) {
+                auto latest = uart::recv::readLatest(uart::ePacketID::TELEMETRY);
+                if (latest.generation != lastGeneration) {
+                    skipped += lastGeneration > 0 ? latest.generation - lastGeneration - 1 : 0;
+                    lastGeneration = latest.generation;
+                    telemetry      = latest.packet;
+                }
+            } else {
+                while (auto packet = uart::recv::dequeue()) {
+                    if (packet->getID() == uart::ePacketID::TELEMETRY) {
+                        telemetry = packet;
+                        break;
+                    }
+                }
+            }
+
+            if (telemetry.has_value()) {
+                if (auto sampled = uart::timesync::toHostTime(telemetry->getTimestamp())) {
+                    agesMs.push_back(
+                        std::chrono::duration<double, std::milli>(Clock::now() - *sampled).count());
+                }
+            }
+
+            next += LOOP_PERIOD; // The control loop's work
+            std::this_thread::sleep_until(next);
+        }
+
+        auto overflows {uart::recv::getOverflowCount()};
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        std::sort(agesMs.begin(), agesMs.end());
+        std::printf("%-10s %8zu %8.1f %8.1f %8.1f %9llu\n", name, agesMs.size(),
+                    percentile(agesMs, 0.5), percentile(agesMs, 0.99),
+                    agesMs.empty() ? 0.0 : agesMs.back(),
+                    static_cast<unsigned long long>(isConflated ? skipped : overflows));
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::duration<double> duration {argc > 1 ? std::atof(argv[1]) : 3.0};
+
+    timeSlot();
+
+    std::printf("\n%.1f s per run, TELEMETRY at 1000 Hz, one sample per 5 ms loop, ages in ms\n",
+                duration.count());
+    std::printf("%-10s %8s %8s %8s %8s %9s\n", "channel", "samples", "p50", "p99", "max",
+                "skipped");
+    runLoop("fifo", false, duration);
+    runLoop("latest", true, duration);
+    return 0;
+}
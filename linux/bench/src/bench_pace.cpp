@@ -0,0 +1,140 @@
+/**
+ * @file bench_pace.cpp
+ * @brief Cost of compiling workouts and of the per-tick target lookup, and plan swaps
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Compile: parse + compile() time for a few typical workouts, with the table size and
+ * the largest change of target between two entries.
+ *
+ * Lookup: ns per PaceTable::speedAt() and per app::pace::getTarget().
+ *
+ * Swaps: a 1 kHz simulated control thread calls getTarget() while another thread
+ * load()s a new plan every few ms. Reports the largest change of target between two
+ * ticks, which should stay within what a plan's own transitions do.
+ *
+ * Usage: bench_pace [lookups]
+ */
+
+#include "pace_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float DT {0.001f};
+
+    volatile float sink_ {0}; // Keeps results from being optimized out
+
+    constexpr const char *WORKOUTS[] {
+        "6x400m @ 72s, 60s jog recovery",
+        "2km @ 5:30/km, 3km @ 5:00/km -> 4:30/km, 1km jog",
+        "10min @ 10km/h, 5x1km @ 3:50/km, 400m jog recovery, 10min jog",
+        "21.1km @ 1:45:00",
+    };
+
+
+    double nsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+
+    // Largest change between neighbouring entries, m/s per m
+    float maxSlope(const app::pace::PaceTable &table)
+    {
+        float slope {0};
+        float last {table.speedAt(0)};
+        for (float d = table.getSpacing(); d < table.getLength(); d += table.getSpacing()) {
+            float speed {table.speedAt(d)};
+            slope = std::max(slope, std::fabs(speed - last) / table.getSpacing());
+            last  = speed;
+        }
+        return slope;
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t lookups {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000};
+
+    static app::pace::PaceTable table; // Too big for the stack
+    std::printf("%-62s %8s %8s %9s %10s\n", "workout", "parse us", "comp. ms", "length m",
+                "dv/dx max");
+    for (const char *text : WORKOUTS) {
+        std::string error;
+        auto start   = Clock::now();
+        auto workout = app::pace::parse(text, &error);
+        double parseNs {nsSince(start)};
+        if (!workout) {
+            std::printf("%s: %s\n", text, error.c_str());
+            return 1;
+        }
+
+        start = Clock::now();
+        app::pace::compile(*workout, 0, table);
+        double compileNs {nsSince(start)};
+        std::printf("%-62s %8.2f %8.2f %9.0f %10.4f\n", text, parseNs / 1e3, compileNs / 1e6,
+                    table.getLength(), maxSlope(table));
+    }
+
+    // Lookup, striding through the table so it isn't all in cache
+    float speed {0};
+    auto start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        speed += table.speedAt(static_cast<float>((i * 7919) % 21100));
+    }
+    std::printf("\nspeedAt(): %.1f ns per lookup\n", nsSince(start) / static_cast<double>(lookups));
+
+    app::pace::load(WORKOUTS[0]);
+    start = Clock::now();
+    for (size_t i = 0; i < lookups; i++) {
+        speed += app::pace::getTarget(static_cast<float>(i % 4000)).value_or(0);
+    }
+    std::printf("getTarget(): %.1f ns per tick\n", nsSince(start) / static_cast<double>(lookups));
+    sink_ = speed;
+
+    // Swaps under a running control thread
+    std::atomic_bool isRunning {true};
+    std::atomic<uint64_t> swaps {0};
+    std::thread writer([&] {
+        size_t i {0};
+        while (isRunning.load(std::memory_order_relaxed)) {
+            app::pace::load(WORKOUTS[i++ % std::size(WORKOUTS)]);
+            swaps.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        }
+    });
+
+    float odometer {0};
+    float last {app::pace::getTarget(odometer).value_or(0)};
+    float maxStep {0};
+    for (size_t tick = 0; tick < 5000; tick++) {
+        float target {app::pace::getTarget(odometer).value_or(0)};
+        maxStep = std::max(maxStep, std::fabs(target - last));
+        last    = target;
+        odometer += target * DT;
+        std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    }
+    isRunning = false;
+    writer.join();
+
+    // Jerk limits allow maxAccel * DT per tick
+    std::printf("\nswaps: %llu plans swapped in over %.0f m, largest target change per tick "
+                "%.5f m/s (limit %.5f)\n",
+                static_cast<unsigned long long>(swaps.load()), odometer, maxStep,
+                app::pace::PACE_LIMITS.maxAccel * DT);
+
+    app::pace::clear();
+    return 0;
+}
@@ -0,0 +1,227 @@
+/**
+ * @file bench_priority.cpp
+ * @brief Enqueue-to-wire latency per traffic class while bulk packets flood the link
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * The pty master is drained at 115200 baud to stand in for the UART, and every
+ * payload starts with the steady_clock time it was enqueued, so latency is measured
+ * at the far end rather than estimated by the sender. Runs the same traffic through:
+ *   - one FIFO (every packet in a single lane, unpaced), the old behaviour
+ *   - priority lanes without pacing, the kernel tty buffer still queues bulk data
+ *   - priority lanes paced at the link rate
+ *
+ * Usage: bench_priority [seconds per scenario]
+ */
+
+#include "emulator/pty.h"
+
+#include "comm/uart/framer.h"
+#include "comm/uart/send.h"
+#include "hal/SerialUART.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using uart::send::ePriority;
+
+    constexpr uint32_t LINK_RATE_BPS {115200};
+    constexpr auto BYTE_TIME = std::chrono::nanoseconds(1'000'000'000LL * 10 / LINK_RATE_BPS);
+
+    // Traffic mix
+    constexpr size_t BULK_BACKLOG {20}; // Bulk frames kept queued
+    constexpr size_t BULK_SIZE {255};
+    constexpr auto CONFIG_PERIOD = std::chrono::milliseconds(100);
+    constexpr auto MOTION_PERIOD = std::chrono::milliseconds(20);
+    constexpr auto SAFETY_PERIOD = std::chrono::milliseconds(250);
+
+    struct Scenario {
+        const char *name;
+        bool useLanes;
+        uint32_t linkRateBps; // Pacing, 0 = off
+    };
+
+    // Latencies in us per class, filled by the wire thread
+    std::vector<uint64_t> latencies_[uart::send::PRIORITY_COUNT];
+    std::atomic_bool isWireRunning_ {false};
+
+
+    ePriority classOf(uart::ePacketID id)
+    {
+        switch (id) {
+        case uart::ePacketID::CMD_NAV:
+            return ePriority::SAFETY;
+        case uart::ePacketID::CMD_MOTOR:
+            return ePriority::MOTION;
+        case uart::ePacketID::CONFIG_PID_SPEED:
+            return ePriority::CONFIG;
+        default:
+            return ePriority::STATUS;
+        }
+    }
+
+
+    uart::ePacketID idOf(ePriority priority)
+    {
+        switch (priority) {
+        case ePriority::SAFETY:
+            return uart::ePacketID::CMD_NAV;
+        case ePriority::MOTION:
+            return uart::ePacketID::CMD_MOTOR;
+        case ePriority::CONFIG:
+            return uart::ePacketID::CONFIG_PID_SPEED;
+        default:
+            return uart::ePacketID::STATUS_RADXA;
+        }
+    }
+
+
+    // Reads the pty no faster than the UART would shift the bytes out
+    void wireLoop(int masterFd)
+    {
+        uart::Framer framer;
+        uint8_t chunk[32];
+        auto wireFree = Clock::now();
+
+        while (isWireRunning_) {
+            ssize_t len = read(masterFd, chunk, sizeof(chunk));
+            if (len <= 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                wireFree = Clock::now();
+                continue;
+            }
+
+            // Keep the schedule when a sleep overshoots, so the average rate holds
+            wireFree += BYTE_TIME * len;
+            std::this_thread::sleep_until(wireFree);
+
+            framer.push(chunk, static_cast<size_t>(len));
+            while (auto view = framer.next()) {
+                int64_t enqueuedNs {};
+                std::memcpy(&enqueuedNs, view->getData().data(), sizeof(enqueuedNs));
+                int64_t nowNs {Clock::now().time_since_epoch().count()};
+                latencies_[static_cast<size_t>(classOf(view->getID()))].push_back(
+                    static_cast<uint64_t>((nowNs - enqueuedNs) / 1000));
+            }
+        }
+    }
+
+
+    void enqueue(ePriority priority, size_t size, bool useLanes)
+    {
+        uint8_t payload[BULK_SIZE] {};
+        int64_t nowNs {Clock::now().time_since_epoch().count()};
+        std::memcpy(payload, &nowNs, sizeof(nowNs));
+
+        uart::DataPacket packet(idOf(priority), std::span<const uint8_t>(payload, size));
+        uart::send::enqueue(std::move(packet), useLanes ? priority : ePriority::STATUS);
+    }
+
+
+    uint64_t percentile(std::vector<uint64_t> &values, double p)
+    {
+        if (values.empty()) {
+            return 0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index {static_cast<size_t>(p / 100.0 * static_cast<double>(values.size() - 1))};
+        return values[index];
+    }
+
+
+    void runScenario(const Scenario &scenario, int masterFd, std::chrono::seconds duration)
+    {
+        for (auto &values : latencies_) {
+            values.clear();
+        }
+        uart::send::setLinkRate(scenario.linkRateBps);
+        uart::send::resetLaneStats();
+
+        isWireRunning_ = true;
+        std::thread wire(wireLoop, masterFd);
+        uart::send::start();
+
+        auto start = Clock::now();
+        auto nextConfig = start;
+        auto nextMotion = start;
+        auto nextSafety = start + SAFETY_PERIOD / 3;
+
+        while (Clock::now() - start < duration) {
+            auto now = Clock::now();
+            if (now >= nextSafety) {
+                enqueue(ePriority::SAFETY, 8, scenario.useLanes);
+                nextSafety += SAFETY_PERIOD;
+            }
+            if (now >= nextMotion) {
+                enqueue(ePriority::MOTION, 12, scenario.useLanes);
+                nextMotion += MOTION_PERIOD;
+            }
+            if (now >= nextConfig) {
+                enqueue(ePriority::CONFIG, 24, scenario.useLanes);
+                nextConfig += CONFIG_PERIOD;
+            }
+            while (uart::send::getQueueSize() < BULK_BACKLOG) {
+                enqueue(ePriority::STATUS, BULK_SIZE, scenario.useLanes);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Drop the backlog, then let the wire drain what was already written
+        uart::send::clearQueue();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        uart::send::stop();
+        isWireRunning_ = false;
+        wire.join();
+
+        static constexpr const char *NAMES[] {"safety", "motion", "config", "status"};
+        std::printf("%s\n", scenario.name);
+        std::printf("  %-8s %8s %10s %10s %10s\n", "class", "count", "p50 us", "p99 us",
+                    "max us");
+        for (size_t i = 0; i < uart::send::PRIORITY_COUNT; i++) {
+            auto &values = latencies_[i];
+            std::printf("  %-8s %8zu %10llu %10llu %10llu\n", NAMES[i], values.size(),
+                        static_cast<unsigned long long>(percentile(values, 50)),
+                        static_cast<unsigned long long>(percentile(values, 99)),
+                        static_cast<unsigned long long>(percentile(values, 100)));
+        }
+
+        auto safety = uart::send::getLaneStats(ePriority::SAFETY);
+        std::printf("  sender estimate, safety lane: p99 <= %llu us, max %llu us\n\n",
+                    static_cast<unsigned long long>(safety.percentileUs(99)),
+                    static_cast<unsigned long long>(safety.latencyMaxUs));
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::seconds duration {argc > 1 ? std::strtol(argv[1], nullptr, 10) : 3};
+
+    emulator::PtyPair pty;
+    pty.setNonBlocking();
+    auto uartPtr = std::make_shared<SerialUART>(pty.getSlavePath(), LINK_RATE_BPS, 1);
+    uartPtr->openPort();
+    uart::send::init(uartPtr);
+
+    const Scenario scenarios[] {
+        {"single FIFO, unpaced", false, 0},
+        {"priority lanes, unpaced", true, 0},
+        {"priority lanes, paced at link rate", true, LINK_RATE_BPS},
+    };
+    for (const auto &scenario : scenarios) {
+        runScenario(scenario, pty.getMasterFd(), duration);
+    }
+
+    uart::send::deinit();
+    return 0;
+}
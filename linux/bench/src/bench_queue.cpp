@@ -0,0 +1,120 @@
+/**
+ * @file bench_queue.cpp
+ * @brief Compares uart::BoundedQueue against the previous mutex-guarded std::queue
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Usage: bench_queue [packets]
+ */
+
+#include "comm/uart/config.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/bounded_queue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief The queue recv/send used before BoundedQueue, unbounded and locked */
+    class MutexQueue {
+      public:
+        bool push(uart::DataPacket packet)
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            queue_.push(std::move(packet));
+            return true;
+        }
+
+        std::optional<uart::DataPacket> pop()
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (queue_.empty()) {
+                return std::nullopt;
+            }
+
+            uart::DataPacket packet = std::move(queue_.front());
+            queue_.pop();
+            return packet;
+        }
+
+      private:
+        std::queue<uart::DataPacket> queue_;
+        std::mutex mtx_;
+    };
+
+
+    template <typename Queue>
+    double runSingleThread(Queue &queue, const uart::DataPacket &packet, size_t count)
+    {
+        auto start = Clock::now();
+        for (size_t i = 0; i < count; i++) {
+            queue.push(packet);
+            auto out = queue.pop();
+            if (!out.has_value()) {
+                std::abort();
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed {Clock::now() - start};
+        return elapsed.count() / static_cast<double>(count);
+    }
+
+
+    template <typename Queue>
+    double runTwoThreads(Queue &queue, const uart::DataPacket &packet, size_t count)
+    {
+        auto start = Clock::now();
+
+        std::thread consumer([&queue, count]() {
+            size_t received {0};
+            while (received < count) {
+                if (queue.pop().has_value()) {
+                    received++;
+                } else {
+                    std::this_thread::yield(); // Matters on single-core boards
+                }
+            }
+        });
+
+        for (size_t i = 0; i < count; i++) {
+            while (!queue.push(packet)) {}
+        }
+        consumer.join();
+
+        std::chrono::duration<double, std::nano> elapsed {Clock::now() - start};
+        return elapsed.count() / static_cast<double>(count);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t count {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000};
+
+    const uint8_t payload[16] {};
+    const uart::DataPacket packet(uart::ePacketID::TELEMETRY, payload);
+
+    MutexQueue mutexQueue;
+    uart::BoundedQueue<uart::DataPacket, uart::config::MAX_RX_QUEUE_SIZE> boundedQueue {
+        uart::eOverflowPolicy::BLOCK};
+
+    std::printf("%zu packets, %zu slot ring\n\n", count, boundedQueue.capacity());
+    std::printf("%-24s %14s %14s\n", "", "mutex queue", "bounded queue");
+    std::printf("%-24s %11.1f ns %11.1f ns\n", "push+pop, 1 thread",
+                runSingleThread(mutexQueue, packet, count),
+                runSingleThread(boundedQueue, packet, count));
+    std::printf("%-24s %11.1f ns %11.1f ns\n", "per packet, 2 threads",
+                runTwoThreads(mutexQueue, packet, count),
+                runTwoThreads(boundedQueue, packet, count));
+    std::printf("\nbounded queue overflow events (producer waited): %llu\n",
+                static_cast<unsigned long long>(boundedQueue.getOverflowCount()));
+
+    return 0;
+}
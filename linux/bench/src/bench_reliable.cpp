@@ -0,0 +1,174 @@
+/**
+ * @file bench_reliable.cpp
+ * @brief Reliable channel throughput, stop-and-wait vs a pipelined window, under loss
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A thread on the pty master plays the STM32: it drains frames at 115200 baud, drops
+ * a share of them (and of its Acks) as if corrupted on the wire, and acknowledges the
+ * rest with arq::Receiver. The Radxa side runs in reactor mode, which stops without
+ * waiting for a byte to unblock recv.
+ *
+ * The mixed runs send every other packet as CMD_NAV, which goes out in the MOTION lane
+ * ahead of the CONFIG frames queued before it. Without loss they should need no
+ * retransmits.
+ *
+ * Usage: bench_reliable [packets per run]
+ */
+
+#include "emulator/pty.h"
+
+#include "comm/uart/arq.h"
+#include "comm/uart/baud.h"
+#include "comm/uart/framer.h"
+#include "comm/uart/reactor.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
+#include "comm/uart/send.h"
+#include "hal/SerialUART.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t LINK_RATE_BPS {115200};
+    constexpr auto BYTE_TIME = std::chrono::nanoseconds(1'000'000'000LL * 10 / LINK_RATE_BPS);
+    constexpr size_t PAYLOAD_SIZE {16}; // A CONFIG_PID_* payload
+
+    std::atomic_bool isPeerRunning_ {false};
+    std::atomic<uint64_t> delivered_ {0}; // Unique frames the peer accepted
+
+
+    void peerLoop(int masterFd, double lossRate)
+    {
+        uart::Framer framer;
+        uart::arq::Receiver receiver;
+        std::minstd_rand rng {42};
+        std::bernoulli_distribution isLost {lossRate};
+
+        uint8_t chunk[32];
+        auto wireFree = Clock::now();
+
+        while (isPeerRunning_) {
+            ssize_t len = read(masterFd, chunk, sizeof(chunk));
+            if (len <= 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                wireFree = Clock::now();
+                continue;
+            }
+
+            wireFree += BYTE_TIME * len;
+            std::this_thread::sleep_until(wireFree);
+
+            framer.push(chunk, static_cast<size_t>(len));
+            while (auto view = framer.next()) {
+                auto id {static_cast<uint8_t>(view->getID())};
+                if (!(id & uart::RELIABLE_FLAG) || isLost(rng)) {
+                    continue;
+                }
+
+                if (receiver.accept(view->getData()[0], (id & uart::RELIABLE_SYN_FLAG) != 0)) {
+                    delivered_++;
+                }
+                if (isLost(rng)) {
+                    continue;
+                }
+
+                uint8_t wire[64];
+                auto ack = uart::makePacket<uart::ePacketID::ACK_STM32>(receiver.getAck());
+                size_t size {ack.serialize(wire, sizeof(wire))};
+                if (write(masterFd, wire, size) != static_cast<ssize_t>(size)) {
+                    return;
+                }
+            }
+        }
+    }
+
+
+    void run(size_t window, double lossRate, size_t count, int masterFd, bool isMixed)
+    {
+        uart::reliable::init();
+        uart::reliable::setWindowSize(window);
+        delivered_ = 0;
+
+        isPeerRunning_ = true;
+        std::thread peer(peerLoop, masterFd, lossRate);
+        uart::reactor::start();
+
+        auto start = Clock::now();
+        uint8_t payload[PAYLOAD_SIZE] {};
+        for (size_t i = 0; i < count; i++) {
+            payload[0] = static_cast<uint8_t>(i);
+            uart::DataPacket packet(uart::ePacketID::CONFIG_PID_SPEED, payload);
+            if (isMixed && i % 2 == 1) {
+                packet = uart::makePacket<uart::ePacketID::CMD_NAV>(
+                    {static_cast<uint16_t>(i), 0, uart::payload::eNavAction::NONE});
+            }
+            while (!uart::reliable::enqueue(packet)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        // Wait for every packet to be acked or given up on
+        auto stats = uart::reliable::getStats();
+        while (stats.acked + stats.failed < count
+               && Clock::now() - start < std::chrono::seconds(60)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            stats = uart::reliable::getStats();
+        }
+        auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        uart::reactor::stop();
+        isPeerRunning_ = false;
+        peer.join();
+        uart::send::clearQueue();
+        uart::reliable::deinit();
+
+        std::printf("%6zu %6.0f%% %6s %10.0f %8zu %8llu %8llu %10.1f\n", window,
+                    lossRate * 100, isMixed ? "mixed" : "config",
+                    static_cast<double>(count) / elapsed, static_cast<size_t>(delivered_),
+                    static_cast<unsigned long long>(stats.retransmits),
+                    static_cast<unsigned long long>(stats.failed),
+                    static_cast<double>(stats.srtt.count()) / 1000.0);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t count {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500};
+
+    emulator::PtyPair pty;
+    pty.setNonBlocking();
+    auto uartPtr = std::make_shared<SerialUART>(pty.getSlavePath(), LINK_RATE_BPS, 1);
+    uartPtr->openPort();
+    uart::send::init(uartPtr);
+    uart::recv::init(uartPtr);
+    uart::baud::init(uartPtr);
+    uart::reactor::init(uartPtr);
+
+    std::printf("%zu packets of %zu bytes per run, %u baud\n\n", count, PAYLOAD_SIZE,
+                LINK_RATE_BPS);
+    std::printf("%6s %7s %6s %10s %8s %8s %8s %10s\n", "window", "loss", "lanes", "pkt/s",
+                "unique", "retx", "failed", "srtt ms");
+    for (double lossRate : {0.0, 0.05}) {
+        for (size_t window : {size_t {1}, uart::config::RELIABLE_WINDOW}) {
+            run(window, lossRate, count, pty.getMasterFd(), false);
+        }
+        run(uart::config::RELIABLE_WINDOW, lossRate, count, pty.getMasterFd(), true);
+    }
+
+    uart::reactor::deinit();
+    uart::baud::deinit();
+    uart::recv::deinit();
+    uart::send::deinit();
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file bench_shm.cpp
+ * @brief Fan-out of the shared-memory telemetry bus to 1-8 reader processes
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Publishes TELEMETRY-sized messages at a fixed rate into an shm::Publisher, with 0, 1,
+ * 2, 4 and 8 forked processes each reading every message through an shm::Reader. Prints
+ * what a publish() costs and each reader's share of messages and latency from publish()
+ * to read(), twice:
+ *
+ *  - Readers sleeping in wait(). publish() wakes them with a futex, which it pays for.
+ *  - Readers polling read() every 1 ms. publish() never sees them.
+ *
+ * Usage: bench_shm [messages per second] [seconds per run]
+ */
+
+#include "comm/shm/publisher.h"
+#include "comm/shm/reader.h"
+#include "comm/uart/payloads.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr const char *BUS_NAME {"/pacerbot_bench"};
+    constexpr uint32_t END_TIMESTAMP {0xFFFFFFFF}; // Last message of a run
+
+    struct ReaderResult {
+        uint64_t received;
+        uint64_t lost;
+        double p50Us;
+        double p99Us;
+        double maxUs;
+    };
+
+
+    uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch())
+                .count());
+    }
+
+
+    // Body of a reader process, reports through resultFd
+    void readUntilEnd(bool isPolling, int readyFd, int resultFd)
+    {
+        shm::Reader reader {BUS_NAME};
+        char ready {1};
+        write(readyFd, &ready, 1);
+
+        std::vector<double> latenciesUs;
+        latenciesUs.reserve(1 << 20);
+        shm::Message message {};
+        bool isDone {false};
+        auto start = Clock::now();
+        while (!isDone && Clock::now() - start < std::chrono::minutes(1)) {
+            if (isPolling) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } else if (!reader.wait(std::chrono::seconds(5))) {
+                break;
+            }
+
+            while (reader.read(message)) {
+                if (message.id == uart::ePacketID::DEBUG && message.timestamp == END_TIMESTAMP) {
+                    isDone = true;
+                    break;
+                }
+                latenciesUs.push_back(static_cast<double>(nowNs() - message.receivedNs) / 1000);
+            }
+        }
+
+        std::sort(latenciesUs.begin(), latenciesUs.end());
+        auto at = [&latenciesUs](double p) {
+            size_t last {latenciesUs.size() - 1};
+            return latenciesUs.empty() ? 0.0 : latenciesUs[static_cast<size_t>(p * last)];
+        };
+        ReaderResult result {latenciesUs.size(), reader.getLost(), at(0.5), at(0.99), at(1.0)};
+        write(resultFd, &result, sizeof(result));
+    }
+
+
+    void run(size_t readers, bool isPolling, double rate, std::chrono::duration<double> duration)
+    {
+        shm::Publisher publisher {BUS_NAME};
+
+        int ready[2];
+        int results[2];
+        if (pipe(ready) < 0 || pipe(results) < 0) {
+            std::perror("pipe");
+            std::exit(1);
+        }
+
+        std::vector<pid_t> children;
+        for (size_t i = 0; i < readers; i++) {
+            pid_t pid {fork()};
+            if (pid == 0) {
+                readUntilEnd(isPolling, ready[1], results[1]);
+                _exit(0);
+            }
+            children.push_back(pid);
+        }
+        for (size_t i = 0; i < readers; i++) {
+            char byte {};
+            read(ready[0], &byte, 1);
+        }
+
+        auto packet = uart::makePacket<uart::ePacketID::TELEMETRY>({});
+        auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1 / rate));
+        uint64_t count {static_cast<uint64_t>(rate * duration.count())};
+
+        Clock::duration publishing {};
+        auto next = Clock::now();
+        for (uint64_t i = 0; i < count; i++) {
+            std::this_thread::sleep_until(next);
+            next += period;
+
+            auto start = Clock::now();
+            publisher.publish(packet, start);
+            publishing += Clock::now() - start;
+        }
+
+        uart::DataPacket end {uart::ePacketID::DEBUG, {}};
+        end.setTimestamp(END_TIMESTAMP);
+        publisher.publish(end, Clock::now());
+
+        double publishNs {std::chrono::duration<double, std::nano>(publishing).count()
+                          / static_cast<double>(count)};
+        std::printf("%7zu %10.0f", readers, publishNs);
+
+        ReaderResult total {0, 0, 0, 0, 0};
+        for (size_t i = 0; i < readers; i++) {
+            ReaderResult result {};
+            read(results[0], &result, sizeof(result));
+            total.received += result.received;
+            total.lost += result.lost;
+            total.p50Us = std::max(total.p50Us, result.p50Us);
+            total.p99Us = std::max(total.p99Us, result.p99Us);
+            total.maxUs = std::max(total.maxUs, result.maxUs);
+        }
+        for (auto pid : children) {
+            waitpid(pid, nullptr, 0);
+        }
+
+        if (readers == 0) {
+            std::printf("\n");
+        } else {
+            std::printf(" %9.1f%% %8llu %9.1f %9.1f %9.1f\n",
+                        100.0 * static_cast<double>(total.received)
+                            / static_cast<double>(count * readers),
+                        static_cast<unsigned long long>(total.lost), total.p50Us, total.p99Us,
+                        total.maxUs);
+        }
+
+        close(ready[0]);
+        close(ready[1]);
+        close(results[0]);
+        close(results[1]);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    double rate {argc > 1 ? std::atof(argv[1]) : 10000};
+    std::chrono::duration<double> duration {argc > 2 ? std::atof(argv[2]) : 2.0};
+
+    std::printf("%.0f messages/s for %.1f s per run, %zu slots, latency in us (worst reader)\n\n",
+                rate, duration.count(), shm::SLOT_COUNT);
+    for (bool isPolling : {false, true}) {
+        std::printf("%s\n", isPolling ? "\nreaders poll every 1 ms" : "readers wait()");
+        std::printf("%7s %10s %10s %8s %9s %9s %9s\n", "readers", "publish ns", "received",
+                    "lost", "p50", "p99", "max");
+        for (size_t readers : {0, 1, 2, 4, 8}) {
+            run(readers, isPolling, rate, duration);
+        }
+    }
+    return 0;
+}
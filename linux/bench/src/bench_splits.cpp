@@ -0,0 +1,129 @@
+/**
+ * @file bench_splits.cpp
+ * @brief Cost of app::SplitTracker per tick, and how well its correction holds lap times
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Timing: ns per update() over many calls.
+ *
+ * Laps: app::VelocityPid drives a first-order DC motor model at 1 kHz for 6 laps,
+ * from standstill, with extra load on the bends (half of each lap). The mock
+ * drivetrain tops out at 1 m/s, so laps are scaled down to 40 m at 0.8 m/s (50 s
+ * each). Each lap's error against the plan is printed with the tracker's output
+ * ignored (PID only) and added to the target (PID + correction), with the finish
+ * time predicted halfway and the actual one.
+ *
+ * Usage: bench_splits [updates]
+ */
+
+#include "split_tracker.h"
+#include "velocity_pid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float DT {0.001f};
+    constexpr float TARGET_MPS {0.8f};
+    constexpr size_t LAPS {6};
+
+    constexpr app::SplitConfig CONFIG {[] {
+        app::SplitConfig config {};
+        config.lapM      = 40.0f;
+        config.splitM    = 20.0f;
+        config.raceM     = 40.0f * LAPS;
+        config.recoveryM = 10.0f;
+        return config;
+    }()};
+
+    volatile float sink_ {0}; // Keeps results from being optimized out
+
+
+    // Speed follows duty (m/s at full duty) with a lag, less friction and load
+    struct Motor {
+        float load {0.0f}; // Duty lost on the bends
+        float speed {0.0f};
+
+        void step(float duty, float dt)
+        {
+            constexpr float TAU_S {0.15f};
+            constexpr float FRICTION {0.02f};
+            float driven {std::max(duty - FRICTION - load, 0.0f)};
+            speed += (driven - speed) * dt / TAU_S;
+        }
+    };
+
+
+    void runLaps(bool isCorrected)
+    {
+        app::SplitTracker tracker {CONFIG};
+        app::VelocityPid pid {};
+        Motor motor {};
+        double timeS {0.0};
+        double predictedAtHalfS {0.0};
+
+        while (tracker.getLaps().getTotal() < LAPS) {
+            double lapPosition {std::fmod(tracker.getDistance(), CONFIG.lapM)};
+            motor.load = lapPosition >= CONFIG.lapM / 2 ? 0.08f : 0.0f;
+
+            float target {TARGET_MPS};
+            float correction {tracker.update(timeS, motor.speed, target)};
+            if (isCorrected) {
+                target += correction;
+            }
+            motor.step(pid.update(target, motor.speed, DT), DT);
+            timeS += DT;
+
+            if (predictedAtHalfS == 0.0 && tracker.getDistance() >= CONFIG.raceM / 2) {
+                predictedAtHalfS = tracker.getPredictedFinishS();
+            }
+        }
+
+        std::printf("%-16s", isCorrected ? "pid + correction" : "pid only");
+        float worst {0};
+        const auto &laps = tracker.getLaps();
+        for (size_t i = laps.getSize(); i > 0; i--) {
+            const app::Split &lap {laps.get(i - 1)};
+            std::printf(" %+7.3f", lap.getErrorS());
+            worst = std::max(worst, std::fabs(lap.getErrorS()));
+        }
+        std::printf(" %7.3f %8.2f %9.2f %8.2f\n", worst, tracker.getTimeErrorS(),
+                    predictedAtHalfS, laps.get(0).endS);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t updates {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000};
+
+    app::SplitTracker tracker {};
+    float correction {0};
+    auto start = Clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        float speed {(i & 0x3FF) < 0x200 ? 5.4f : 5.7f};
+        correction += tracker.update(static_cast<double>(i) * DT, speed, 5.55f);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    sink_ = correction;
+    std::printf("update(): %.1f ns per tick over %zu ticks, %llu laps\n\n",
+                elapsed / static_cast<double>(updates), updates,
+                static_cast<unsigned long long>(tracker.getLaps().getTotal()));
+
+    std::printf("lap error s, planned %.0f s per lap:\n%-16s", CONFIG.lapM / TARGET_MPS,
+                "controller");
+    for (size_t i = 1; i <= LAPS; i++) {
+        std::printf(" %6s%zu", "lap ", i);
+    }
+    std::printf(" %7s %8s %9s %8s\n", "worst", "total", "predicted", "finish");
+    runLaps(false);
+    runLaps(true);
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file bench_subscribe.cpp
+ * @brief How soon packets reach the app through recv::subscribe() versus dequeue() polling
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Runs uart::manager against an emulator::Stm32 streaming TELEMETRY at 1000 Hz and
+ * 921600 baud, once per way of receiving it, and prints uart::trace's RX_QUEUE (framed
+ * -> app has it) and RX_TOTAL (read with the first byte -> app has it) spans:
+ *
+ *  - dequeue() polled every 1 ms, as a loop with a sleep would.
+ *  - A handler on each executor. The MAILBOX one is drained by pollMailbox() waiting up
+ *    to 10 ms, as a control loop with nothing else to do would.
+ *
+ * Usage: bench_subscribe [seconds per run]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/manager.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <thread>
+
+namespace {
+    using emulator::Clock;
+    using uart::recv::eExecutor;
+
+    std::atomic<uint64_t> handled_ {0};
+
+
+    void printSpan(uart::trace::eSpan span)
+    {
+        auto snapshot = uart::trace::snapshot(span);
+        std::printf(" %8.1f %8.1f %8.1f %8.1f", static_cast<double>(snapshot.p50Ns) / 1000,
+                    static_cast<double>(snapshot.p90Ns) / 1000,
+                    static_cast<double>(snapshot.p99Ns) / 1000,
+                    static_cast<double>(snapshot.maxNs) / 1000);
+    }
+
+
+    // executor nullopt polls dequeue() instead
+    void run(const char *name, std::optional<eExecutor> executor,
+             std::chrono::duration<double> duration)
+    {
+        emulator::Config config {};
+        config.telemetryHz = 1000;
+        config.linkRateBps = 921600;
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+
+        handled_ = 0;
+        if (executor.has_value()) {
+            uart::recv::subscribe(
+                uart::ePacketID::TELEMETRY,
+                [](const uart::DataPacket &) { handled_.fetch_add(1, std::memory_order_relaxed); },
+                *executor);
+            uart::recv::setQueueEnabled(false);
+        }
+
+        stm32.start();
+        uart::trace::reset();
+
+        auto start = Clock::now();
+        while (Clock::now() - start < duration) {
+            if (executor == eExecutor::MAILBOX) {
+                uart::recv::pollMailbox(std::chrono::milliseconds(10));
+            } else if (executor.has_value()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            } else {
+                while (auto packet = uart::recv::dequeue()) {
+                    if (packet->getID() == uart::ePacketID::TELEMETRY) {
+                        handled_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        auto stats = uart::recv::getDispatchStats();
+        std::printf("%-18s %8llu %8llu", name, static_cast<unsigned long long>(handled_.load()),
+                    static_cast<unsigned long long>(stats.dropped));
+        printSpan(uart::trace::eSpan::RX_QUEUE);
+        printSpan(uart::trace::eSpan::RX_TOTAL);
+        std::printf("\n");
+
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::duration<double> duration {argc > 1 ? std::atof(argv[1]) : 3.0};
+
+    std::printf("%.1f s per run, TELEMETRY at 1000 Hz, 921600 baud, times in us\n\n",
+                duration.count());
+    std::printf("%-36s %-35s %s\n", "", " RX_QUEUE", " RX_TOTAL");
+    std::printf("%-18s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "delivery", "handled",
+                "dropped", "p50", "p90", "p99", "max", "p50", "p90", "p99", "max");
+
+    run("dequeue, 1 ms", std::nullopt, duration);
+    run("inline", eExecutor::INLINE, duration);
+    run("pool", eExecutor::POOL, duration);
+    run("mailbox", eExecutor::MAILBOX, duration);
+    return 0;
+}
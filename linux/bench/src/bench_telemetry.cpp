@@ -0,0 +1,271 @@
+/**
+ * @file bench_telemetry.cpp
+ * @brief Telemetry samples per second over the UART, TELEMETRY vs TELEMETRY_COMPACT
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Replays the recorded run in scripts/simulation_output.txt as 100 Hz telemetry. The
+ * trace holds duty and speed; the IMU and ultrasonic readings it doesn't record are
+ * modeled from the speed, with sensor noise, so the deltas look like a real MPU-6050's.
+ *
+ * Every sample is sent once as its own TELEMETRY frame, then batched into
+ * TELEMETRY_COMPACT frames of increasing size. For each, the bench reports wire bytes per
+ * sample and the sample rate that fits in the link at 115200 and 921600 baud (10 bits
+ * per byte), how fast the host decodes, and how many samples a 2% frame loss costs.
+ *
+ * Exits non-zero if a decoded sample differs from the one encoded.
+ *
+ * Usage: bench_telemetry [trace file] (default: scripts/simulation_output.txt, run from
+ *        linux/)
+ */
+
+#include "comm/uart/cobs.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/telemetry_codec.h"
+#include "comm/uart/telemetry_decoder.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using uart::compact::Sample;
+
+    constexpr uint32_t PERIOD_MS {10};
+    constexpr size_t TRACE_REPEATS {50};
+    constexpr size_t LOSS_EVERY {50}; // Every 50th frame is dropped in the loss pass
+
+    struct TraceRow {
+        double duty {0};
+        double speedMps {0};
+    };
+
+
+    std::vector<TraceRow> loadTrace(const char *path)
+    {
+        std::vector<TraceRow> rows;
+        std::ifstream file {path};
+        std::string line;
+
+        while (std::getline(file, line)) {
+            int index {};
+            int mode {};
+            TraceRow row {};
+            if (std::sscanf(line.c_str(), "i=%d mode=%d duty=%lf speed=%lf", &index, &mode,
+                            &row.duty, &row.speedMps)
+                == 4) {
+                rows.push_back(row);
+            }
+        }
+        return rows;
+    }
+
+
+    int16_t noisy(std::minstd_rand &rng, double value, double sigma)
+    {
+        std::normal_distribution<double> noise {0, sigma};
+        return static_cast<int16_t>(std::lround(value + noise(rng)));
+    }
+
+
+    // Telemetry as the STM32 would report it while driving the recorded run
+    std::vector<Sample> makeSamples(const std::vector<TraceRow> &trace)
+    {
+        constexpr double ACCEL_LSB_PER_MPS2 {16384 / 9.81};
+        constexpr double WALL_MM {3000};
+
+        std::minstd_rand rng {5};
+        std::vector<Sample> samples;
+        samples.reserve(trace.size() * TRACE_REPEATS);
+
+        double distanceMm {0};
+        double prevSpeed {0};
+        uint32_t timestamp {12345};
+
+        for (size_t repeat = 0; repeat < TRACE_REPEATS; repeat++) {
+            for (const auto &row : trace) {
+                double accel {(row.speedMps - prevSpeed) / (PERIOD_MS / 1000.0)};
+                prevSpeed = row.speedMps;
+                distanceMm += row.speedMps * PERIOD_MS;
+                if (distanceMm > WALL_MM - 200) {
+                    distanceMm = 0; // Turned around
+                }
+
+                Sample sample {};
+                sample.timestamp_ms               = timestamp;
+                sample.telemetry.imu.accel_x      = noisy(rng, accel * ACCEL_LSB_PER_MPS2, 8);
+                sample.telemetry.imu.accel_y      = noisy(rng, 0, 8);
+                sample.telemetry.imu.accel_z      = noisy(rng, 16384, 8);
+                sample.telemetry.imu.gyro_x       = noisy(rng, 0, 3);
+                sample.telemetry.imu.gyro_y       = noisy(rng, 0, 3);
+                sample.telemetry.imu.gyro_z       = noisy(rng, 0, 3);
+                sample.telemetry.speed_left_mmps  = noisy(rng, row.speedMps * 1000, 2);
+                sample.telemetry.speed_right_mmps = noisy(rng, row.speedMps * 1000, 2);
+                sample.telemetry.ultrasonic_mm    = static_cast<uint16_t>(
+                    noisy(rng, WALL_MM - distanceMm, 1.5));
+                sample.telemetry.pid_speed_out    = static_cast<int16_t>(
+                    std::lround(row.duty * 1000));
+                sample.telemetry.pid_lane_out     = noisy(rng, 0, 4);
+                samples.push_back(sample);
+
+                // Timer jitter now and then
+                timestamp += PERIOD_MS + (rng() % 20 == 0 ? 1 : 0);
+            }
+        }
+        return samples;
+    }
+
+
+    size_t wireSize(uart::ePacketID id, const uint8_t *data, size_t len)
+    {
+        uint8_t wire[uart::cobs::MAX_FRAME_SIZE];
+        return uart::DataPacket(id, std::span<const uint8_t>(data, len))
+            .serialize(wire, sizeof(wire));
+    }
+
+
+    bool isSame(const Sample &a, const Sample &b)
+    {
+        uint8_t left[uart::schema::wireSize<uart::payload::Telemetry>()];
+        uint8_t right[sizeof(left)];
+        uart::schema::encode(a.telemetry, left, sizeof(left));
+        uart::schema::encode(b.telemetry, right, sizeof(right));
+        return a.timestamp_ms == b.timestamp_ms && memcmp(left, right, sizeof(left)) == 0;
+    }
+
+
+    void printRow(const char *name, size_t wireBytes, size_t samples, double decodeRate,
+                  size_t lost)
+    {
+        double bytesPerSample {static_cast<double>(wireBytes) / static_cast<double>(samples)};
+        std::printf("%-18s %8.2f %10.0f %10.0f ", name, bytesPerSample,
+                    115200 / 10.0 / bytesPerSample, 921600 / 10.0 / bytesPerSample);
+        if (decodeRate > 0) {
+            std::printf("%10.2f ", decodeRate / 1e6);
+        } else {
+            std::printf("%10s ", "-");
+        }
+        std::printf("%9.2f%%\n", 100.0 * static_cast<double>(lost) / static_cast<double>(samples));
+    }
+
+
+    // Frames of up to batch samples, as the STM32 would send them
+    std::vector<std::vector<uint8_t>> encode(const std::vector<Sample> &samples, size_t batch)
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        uart::compact::Encoder encoder;
+
+        for (const auto &sample : samples) {
+            if (encoder.getSampleCount() == batch || !encoder.add(sample)) {
+                frames.emplace_back(encoder.data(), encoder.data() + encoder.size());
+                encoder.finish();
+                encoder.add(sample);
+            }
+        }
+        if (!encoder.isEmpty()) {
+            frames.emplace_back(encoder.data(), encoder.data() + encoder.size());
+        }
+        return frames;
+    }
+
+
+    // Decodes every frame but those skipped, returning the samples recovered
+    std::vector<Sample> decode(const std::vector<std::vector<uint8_t>> &frames,
+                               size_t skipEvery, double *elapsed = nullptr)
+    {
+        std::vector<Sample> out(frames.size() * uart::TelemetryDecoder::MAX_SAMPLES);
+        uart::TelemetryDecoder decoder;
+        auto start = Clock::now();
+        size_t count {0};
+
+        for (size_t i = 0; i < frames.size(); i++) {
+            if (skipEvery != 0 && i % skipEvery == skipEvery - 1) {
+                continue;
+            }
+            count += decoder.decode(frames[i], std::span<Sample>(out).subspan(count));
+        }
+
+        if (elapsed != nullptr) {
+            *elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+        out.resize(count);
+        return out;
+    }
+
+
+    bool runCompact(const std::vector<Sample> &samples, size_t batch)
+    {
+        auto frames = encode(samples, batch);
+
+        size_t wireBytes {0};
+        for (const auto &frame : frames) {
+            wireBytes += wireSize(uart::ePacketID::TELEMETRY_COMPACT, frame.data(), frame.size());
+        }
+
+        double elapsed {};
+        auto decoded = decode(frames, 0, &elapsed);
+
+        bool isExact {decoded.size() == samples.size()};
+        for (size_t i = 0; isExact && i < samples.size(); i++) {
+            isExact = isSame(samples[i], decoded[i]);
+        }
+
+        // Every recovered sample must still be exact
+        auto lossy = decode(frames, LOSS_EVERY);
+        size_t next {0};
+        for (const auto &sample : lossy) {
+            while (next < samples.size() && samples[next].timestamp_ms != sample.timestamp_ms) {
+                next++;
+            }
+            isExact = isExact && next < samples.size() && isSame(samples[next], sample);
+        }
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "compact x%zu", batch);
+        printRow(name, wireBytes, samples.size(),
+                 static_cast<double>(decoded.size()) / elapsed, samples.size() - lossy.size());
+        return isExact;
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    const char *path {argc > 1 ? argv[1] : "scripts/simulation_output.txt"};
+    auto trace = loadTrace(path);
+    if (trace.empty()) {
+        std::fprintf(stderr, "No samples in %s\n", path);
+        return 1;
+    }
+
+    auto samples = makeSamples(trace);
+    std::printf("%zu trace rows x %zu = %zu samples, 1 in %zu frames lost in the loss pass\n\n",
+                trace.size(), TRACE_REPEATS, samples.size(), LOSS_EVERY);
+    std::printf("%-18s %8s %10s %10s %10s %10s\n", "encoding", "B/sample", "@115200",
+                "@921600", "Mdec/s", "lost");
+
+    // One frame per sample, each standing alone
+    size_t wireBytes {0};
+    for (const auto &sample : samples) {
+        uint8_t payload[uart::schema::wireSize<uart::payload::Telemetry>()];
+        uart::schema::encode(sample.telemetry, payload, sizeof(payload));
+        wireBytes += wireSize(uart::ePacketID::TELEMETRY, payload, sizeof(payload));
+    }
+    printRow("TELEMETRY", wireBytes, samples.size(), 0,
+             (samples.size() + LOSS_EVERY - 1) / LOSS_EVERY);
+
+    bool isPassed {true};
+    for (size_t batch : {1, 4, 8, 16, 64}) {
+        isPassed = runCompact(samples, batch) && isPassed;
+    }
+
+    std::printf("\nround trip %s\n", isPassed ? "ok" : "FAIL");
+    return isPassed ? 0 : 1;
+}
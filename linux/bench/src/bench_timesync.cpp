@@ -0,0 +1,171 @@
+/**
+ * @file bench_timesync.cpp
+ * @brief How closely uart::timesync tracks an emulated STM32 clock that drifts and wraps
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Runs uart::manager against an emulator::Stm32 whose clock runs 80 ppm fast and whose
+ * HAL tick wraps 5 s in, once on a clean link and once with 0-2 ms of jitter per frame.
+ * Every second it prints the estimated drift and two errors:
+ *
+ *  - clock: toHostTime() of the emulator's exact clock now, minus now. This is the
+ *    sync error itself.
+ *  - stamp: toHostTime() of each packet timestamp the emulator generates, minus when
+ *    it was generated. Adds the +-0.5 ms of whole-millisecond timestamps.
+ *
+ * Then against an emulator that echoes pings unchanged, as firmware without time sync
+ * does, which must never count as synced.
+ *
+ * Usage: bench_timesync [seconds per run]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/manager.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/timesync.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    using emulator::Clock;
+
+    constexpr double DRIFT_PPM {80};
+    constexpr uint64_t WRAP_AFTER_MS {5000};
+
+    // Errors of packet timestamps converted on the emulator's thread, in us
+    std::mutex mtx_;
+    std::vector<double> stampErrorsUs_;
+
+
+    void onGenerate(const uart::DataPacket &packet, Clock::time_point time)
+    {
+        auto host = uart::timesync::toHostTime(packet.getTimestamp());
+        if (!host.has_value()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        stampErrorsUs_.push_back(std::chrono::duration<double, std::micro>(*host - time).count());
+    }
+
+
+    double microseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+
+    void run(const char *name, std::chrono::microseconds maxJitter, int seconds)
+    {
+        emulator::Config config {};
+        config.clockStartUs  = ((uint64_t {1} << 32) - WRAP_AFTER_MS) * 1000;
+        config.clockDriftPpm = DRIFT_PPM;
+        config.maxJitter     = maxJitter;
+        config.onGenerate    = onGenerate;
+        stampErrorsUs_.clear();
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        stm32.start();
+
+        std::printf("\n%s, STM32 clock %+.0f ppm\n", name, DRIFT_PPM);
+        std::printf("%4s %6s %9s %9s %9s %9s %9s %9s\n", "t(s)", "pongs", "drift", "clock",
+                    "stamp p50", "p99", "max", "min rtt");
+
+        auto start = Clock::now();
+        for (int second = 1; second <= seconds; second++) {
+            auto next = start + std::chrono::seconds(second);
+            while (Clock::now() < next) {
+                while (uart::recv::dequeue().has_value()) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            auto now = Clock::now();
+            uint64_t us {stm32.getClockUs(now)};
+            auto host = uart::timesync::toHostTime(
+                uart::timesync::McuTime {static_cast<uint32_t>(us / 1000),
+                                         static_cast<uint16_t>(us % 1000)});
+            auto status = uart::timesync::getStatus();
+
+            std::vector<double> errors;
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                errors.swap(stampErrorsUs_);
+            }
+            for (auto &error : errors) {
+                error = std::fabs(error);
+            }
+            std::sort(errors.begin(), errors.end());
+            auto at = [&errors](double p) {
+                return errors.empty() ? 0.0 : errors[static_cast<size_t>(p * (errors.size() - 1))];
+            };
+
+            std::printf("%4d %6llu %+9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n", second,
+                        static_cast<unsigned long long>(status.pongsReceived), status.driftPpm,
+                        host.has_value() ? microseconds(*host - now) : NAN, at(0.5), at(0.99),
+                        at(1.0), microseconds(status.minRtt));
+        }
+
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+    }
+
+
+    void runUnstamped(int seconds)
+    {
+        emulator::Config config {};
+        config.isTimesyncSupported = false;
+        config.onGenerate          = onGenerate;
+        stampErrorsUs_.clear();
+
+        emulator::Stm32 stm32 {config};
+        uart::manager::init(stm32.getDevicePath());
+        uart::manager::start();
+        stm32.start();
+
+        auto end = Clock::now() + std::chrono::seconds(seconds);
+        bool wasSynced {false};
+        while (Clock::now() < end) {
+            while (uart::recv::dequeue().has_value()) {}
+            wasSynced |= uart::timesync::isSynced();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto status = uart::timesync::getStatus();
+        size_t converted {0};
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            converted = stampErrorsUs_.size();
+        }
+
+        uart::manager::stop();
+        uart::manager::deinit();
+        stm32.stop();
+
+        std::printf("\nunstamped echoes, %d s: %llu pongs, %zu used, %s, %zu stamps converted\n",
+                    seconds, static_cast<unsigned long long>(status.pongsReceived),
+                    status.pongsUsed, wasSynced ? "SYNCED (wrong)" : "never synced", converted);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    int seconds {argc > 1 ? std::atoi(argv[1]) : 12};
+
+    std::printf("drift in ppm, errors and round trips in us\n");
+    run("clean, 115200", std::chrono::microseconds(0), seconds);
+    run("jitter 0-2 ms, 115200", std::chrono::microseconds(2000), seconds);
+    runUnstamped(std::min(seconds, 3));
+    return 0;
+}
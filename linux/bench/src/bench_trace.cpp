@@ -0,0 +1,117 @@
+/**
+ * @file bench_trace.cpp
+ * @brief Cost of uart::trace, and where the time goes between the wire and dequeue()
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * First times Histogram::record() and the clock read each traced stage needs, alone and
+ * with every core recording into the same histogram. Then runs uart::manager against
+ * an emulator::Stm32 at 2000 Hz and 921600 baud, with the app sending a CMD_NAV every
+ * 5 ms, and prints uart::trace::dump(). Send SIGUSR1 while it runs for a live dump.
+ *
+ * Usage: bench_trace [seconds]
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/manager.h"
+#include "comm/uart/payloads.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/send.h"
+#include "comm/uart/trace.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+    using Clock = uart::trace::Clock;
+
+    constexpr size_t RECORDS {10'000'000};
+
+
+    double nsPerRecord(size_t threads)
+    {
+        uart::trace::Histogram histogram;
+        std::vector<std::thread> workers;
+
+        auto start = Clock::now();
+        for (size_t t = 0; t < threads; t++) {
+            workers.emplace_back([&histogram, t]() {
+                for (size_t i = 0; i < RECORDS; i++) {
+                    histogram.record(static_cast<uint64_t>((i * 2654435761u + t) % 5'000'000));
+                }
+            });
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        return elapsed / static_cast<double>(RECORDS);
+    }
+
+
+    double nsPerClockRead()
+    {
+        Clock::time_point last {};
+        auto start = Clock::now();
+        for (size_t i = 0; i < RECORDS; i++) {
+            last = Clock::now();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(last - start).count();
+        return elapsed / static_cast<double>(RECORDS);
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    std::chrono::duration<double> duration {argc > 1 ? std::atof(argv[1]) : 3.0};
+    size_t cores {std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+
+    std::printf("record():         %6.1f ns\n", nsPerRecord(1));
+    std::printf("record(), %zu thr: %6.1f ns per record per thread\n", cores,
+                nsPerRecord(cores));
+    std::printf("clock read:       %6.1f ns, 3 per received and 1 per sent packet\n\n",
+                nsPerClockRead());
+
+    emulator::Config config {};
+    config.telemetryHz = 2000;
+    config.linkRateBps = 921600;
+    emulator::Stm32 stm32 {config};
+
+    uart::trace::dumpOnSignal(SIGUSR1);
+    uart::manager::init(stm32.getDevicePath());
+    uart::manager::start();
+    uart::trace::reset();
+    stm32.start();
+
+    size_t received {0};
+    auto start = Clock::now();
+    auto nextCommand = start;
+    while (Clock::now() - start < duration) {
+        while (uart::recv::dequeue().has_value()) {
+            received++;
+        }
+        if (Clock::now() >= nextCommand) {
+            uart::send::enqueue(uart::makePacket<uart::ePacketID::CMD_NAV>({}));
+            nextCommand += std::chrono::milliseconds(5);
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    uart::manager::stop();
+    uart::manager::deinit();
+    stm32.stop();
+
+    std::printf("%zu packets received, app polls every 50 us\n\n", received);
+    std::fflush(stdout);
+    uart::trace::dump(STDOUT_FILENO);
+    return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file bench_velocity_pid.cpp
+ * @brief Cost of app::VelocityPid per tick, and how well it holds pace on a motor model
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Timing: ns per update() over many calls with changing inputs.
+ *
+ * Tracking: a first-order DC motor (time constant, friction, speed proportional to
+ * battery voltage) is driven at 1 kHz towards a target. A slope adds load halfway
+ * through. Feed-forward alone, i.e. a duty calibrated at nominal battery, is
+ * compared with the full controller:
+ *
+ *  - settle: time to get and stay within 2% of the target
+ *  - over:   overshoot above the target, % of target
+ *  - error:  mean |target - speed| over the last second, % of target
+ *
+ * Usage: bench_velocity_pid [updates]
+ */
+
+#include "velocity_pid.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    constexpr float DT {0.001f};
+    constexpr float DURATION_S {8.0f};
+    constexpr float SLOPE_AT_S {4.0f};
+
+    volatile float sink_ {0}; // Keeps results from being optimized out
+
+
+    // Speed follows battery * duty (m/s at full duty) with a lag, less friction and slope
+    struct Motor {
+        float battery {1.0f}; // Relative to nominal
+        float load {0.0f};    // Duty lost to the slope
+        float speed {0.0f};
+
+        void step(float duty, float dt)
+        {
+            constexpr float TAU_S {0.15f};
+            constexpr float FRICTION {0.02f};
+            float driven {std::max(duty - FRICTION - load, 0.0f) * battery};
+            speed += (driven - speed) * dt / TAU_S;
+        }
+    };
+
+
+    struct Tracking {
+        float settleS {NAN};
+        float overshoot {0};
+        float error {0};
+    };
+
+
+    Tracking track(const app::VelocityPidConfig &config, float target, float battery)
+    {
+        app::VelocityPid pid {config};
+        Motor motor {battery};
+        Tracking result {};
+        float errorTotal {0};
+        size_t errorCount {0};
+        float lastOutside {0};
+
+        auto steps {static_cast<size_t>(DURATION_S / DT)};
+        for (size_t i = 0; i < steps; i++) {
+            float t {static_cast<float>(i) * DT};
+            motor.load = t >= SLOPE_AT_S ? 0.05f : 0.0f;
+            motor.step(pid.update(target, motor.speed, DT), DT);
+
+            float error {std::fabs(target - motor.speed) / target};
+            if (t < SLOPE_AT_S) {
+                result.overshoot = std::max(result.overshoot, motor.speed / target - 1);
+                if (error > 0.02f) {
+                    lastOutside = t;
+                }
+            }
+            if (t >= DURATION_S - 1) {
+                errorTotal += error;
+                errorCount++;
+            }
+        }
+
+        result.settleS = lastOutside < SLOPE_AT_S - DT ? lastOutside + DT : NAN;
+        result.error   = errorTotal / static_cast<float>(errorCount);
+        return result;
+    }
+
+
+    constexpr app::VelocityPidConfig FEED_FORWARD_ONLY {[] {
+        app::VelocityPidConfig config {app::VELOCITY_PID_CONFIG};
+        for (auto &band : config.bands) {
+            band.gains = {};
+        }
+        return config;
+    }()};
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    size_t updates {argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000};
+
+    app::VelocityPid pid {};
+    float speed {0};
+    auto start = Clock::now();
+    for (size_t i = 0; i < updates; i++) {
+        float target {(i & 0x3FF) < 0x200 ? 0.4f : 0.8f};
+        speed += (pid.update(target, speed, DT) - speed) * 0.01f;
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    sink_ = speed;
+    std::printf("update(): %.1f ns per tick over %zu ticks\n\n",
+                elapsed / static_cast<double>(updates), updates);
+
+    std::printf("%-13s %7s %7s %9s %8s %8s\n", "controller", "target", "battery", "settle s",
+                "over %", "error %");
+    for (float target : {0.3f, 0.6f}) {
+        for (float battery : {0.8f, 1.0f, 1.1f}) {
+            for (bool isPid : {false, true}) {
+                Tracking result {
+                    track(isPid ? app::VELOCITY_PID_CONFIG : FEED_FORWARD_ONLY, target, battery)};
+                std::printf("%-13s %7.2f %7.2f %9.3f %8.2f %8.2f\n",
+                            isPid ? "pid" : "feed-forward", target, battery, result.settleS,
+                            100 * result.overshoot, 100 * result.error);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file bus.h
+ * @brief Layout of the shared-memory telemetry bus, shared by Publisher and Reader
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * One process (pacerBot) owns the UART and publishes the packets it receives into a
+ * POSIX shared-memory object, any number of others (logger, BLE bridge, UI) read them.
+ *
+ * The object is a Header followed by a ring of SLOT_COUNT Slots. Message n goes in
+ * slot n % SLOT_COUNT, guarded by a per-slot sequence number (a seqlock): 2n + 1 while
+ * it's being written, 2n + 2 once it's complete. A reader copies the message out and
+ * checks the sequence number didn't move, so readers never write to the ring and the
+ * publisher never waits for them. A reader that falls a whole ring behind finds newer
+ * sequence numbers than it expects, skips ahead and counts what it lost.
+ */
+
+#ifndef COMM_SHM_BUS_H_
+#define COMM_SHM_BUS_H_
+
+#include "comm/uart/config.h"
+#include "comm/uart/protocol.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace shm {
+    // Name passed to shm_open(), the object appears as /dev/shm/pacerbot_bus
+    constexpr const char *DEFAULT_NAME {"/pacerbot_bus"};
+
+    constexpr uint32_t MAGIC {0x50425553}; // "PBUS"
+    constexpr uint32_t VERSION {1};
+
+    // About 300 KB, a second of TELEMETRY at 1000 Hz
+    constexpr size_t SLOT_COUNT {1024};
+
+
+    /** @brief A packet as the publisher received it */
+    struct Message {
+        uint64_t receivedNs {};     // steady_clock (CLOCK_MONOTONIC) when it was read
+        uint32_t timestamp {};      // STM32 packet timestamp, see uart::timesync
+        uart::ePacketID id {};
+        uint8_t length {};          // Bytes used in data
+        std::array<uint8_t, uart::DATA_MAX_SIZE - 1> data; // Payload, decode with uart::schema
+
+        std::span<const uint8_t> getData() const noexcept { return {data.data(), length}; }
+    };
+
+
+    struct Slot {
+        std::atomic<uint64_t> seq; // 2n + 1 while message n is written, 2n + 2 after
+        Message message;
+    };
+
+
+    struct Header {
+        uint32_t magic;   // MAGIC once the publisher has set the bus up
+        uint32_t version; // VERSION
+        uint64_t slotCount;
+
+        // Written by the publisher
+        alignas(uart::config::CACHE_LINE_SIZE) std::atomic<uint64_t> head; // Messages so far
+        std::atomic<uint32_t> futexWord; // Low 32 bits of head, for readers to sleep on
+
+        // Written by readers, on its own cache line so they don't slow the publisher
+        alignas(uart::config::CACHE_LINE_SIZE) std::atomic<uint32_t> waiters;
+    };
+
+
+    // Shared between processes, so every atomic must be lock-free
+    static_assert(std::atomic<uint64_t>::is_always_lock_free);
+    static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+    constexpr size_t SLOTS_OFFSET {(sizeof(Header) + alignof(Slot) - 1) / alignof(Slot)
+                                   * alignof(Slot)};
+
+    constexpr size_t mappingSize(size_t slotCount) noexcept
+    {
+        return SLOTS_OFFSET + slotCount * sizeof(Slot);
+    }
+
+} // namespace shm
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * @file publisher.h
+ * @brief Writer end of the shared-memory telemetry bus
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_SHM_PUBLISHER_H_
+#define COMM_SHM_PUBLISHER_H_
+
+#include "comm/shm/bus.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/recv.h"
+
+#include <chrono>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace shm {
+    /**
+     * @class Publisher
+     * @brief Creates the bus and writes messages into it, see bus.h.
+     *
+     * Only one Publisher per name, and only one thread may publish(). A bus left over
+     * from an earlier run is replaced; readers still attached to it stop getting data
+     * and should reattach. The bus is removed when the Publisher is destroyed.
+     */
+    class Publisher {
+      public:
+        /** @throws std::system_error if the shared memory can't be set up. */
+        explicit Publisher(const std::string &name = DEFAULT_NAME, size_t slotCount = SLOT_COUNT);
+        ~Publisher();
+
+        Publisher(const Publisher &)            = delete;
+        Publisher &operator=(const Publisher &) = delete;
+
+        /** @brief Never blocks, wakes readers waiting in Reader::wait() */
+        void publish(const uart::DataPacket &packet,
+                     std::chrono::steady_clock::time_point received);
+
+        uint64_t getPublished() const noexcept { return next_; }
+
+      private:
+        std::string name_;
+        size_t slotCount_;
+        void *mapping_ {nullptr};
+        Header *header_ {nullptr};
+        Slot *slots_ {nullptr};
+        uint64_t next_ {0}; // Number of the next message
+    };
+
+
+    /**
+     * @brief Publishes every packet of ids that uart::recv receives, from now on.
+     *
+     * Subscribes INLINE handlers, so the I/O thread is the publisher's only writer and
+     * readers see packets within microseconds of them being read.
+     * @return The subscriptions, to recv::unsubscribe() before the Publisher goes away.
+     */
+    std::vector<uart::recv::SubscriptionId>
+    publishFromRecv(Publisher &publisher, std::initializer_list<uart::ePacketID> ids);
+
+} // namespace shm
+
+#endif
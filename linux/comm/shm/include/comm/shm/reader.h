@@ -0,0 +1,69 @@
+/**
+ * @file reader.h
+ * @brief Reader end of the shared-memory telemetry bus, for processes other than pacerBot
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_SHM_READER_H_
+#define COMM_SHM_READER_H_
+
+#include "comm/shm/bus.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace shm {
+    /**
+     * @class Reader
+     * @brief Attaches to a bus and reads every message published after it attached.
+     *
+     * Any number of Readers, in any number of processes, may read one bus. Each keeps its
+     * own position, and only touches the bus's shared counters while sleeping in wait().
+     * One Reader is for one thread.
+     *
+     * Example:
+     *   shm::Reader reader;
+     *   shm::Message message;
+     *   while (reader.wait(std::chrono::milliseconds(100))) {
+     *       while (reader.read(message)) { ... }
+     *   }
+     */
+    class Reader {
+      public:
+        /** @throws std::system_error if there's no bus by that name, or it isn't one. */
+        explicit Reader(const std::string &name = DEFAULT_NAME);
+        ~Reader();
+
+        Reader(const Reader &)            = delete;
+        Reader &operator=(const Reader &) = delete;
+
+        /**
+         * @brief Copies the next message into message.
+         * @return false if there's none yet.
+         */
+        bool read(Message &message);
+
+        /**
+         * @brief Sleeps until there's a message to read, or timeout.
+         * @return true if there is one.
+         */
+        bool wait(std::chrono::microseconds timeout);
+
+        // Messages overwritten before this reader got to them
+        uint64_t getLost() const noexcept { return lost_; }
+
+      private:
+        size_t mappingSize_ {0};
+        void *mapping_ {nullptr};
+        Header *header_ {nullptr};
+        const Slot *slots_ {nullptr};
+        uint64_t slotCount_ {0};
+        uint64_t next_ {0}; // Number of the next message to read
+        uint64_t lost_ {0};
+    };
+
+} // namespace shm
+
+#endif
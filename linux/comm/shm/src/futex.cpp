@@ -0,0 +1,33 @@
+/**
+ * @file futex.cpp
+ * @brief Sleeping on a word of the bus, across processes
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "futex.h"
+
+#include <climits>
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace shm::futex {
+    void wait(std::atomic<uint32_t> &word, uint32_t expected, std::chrono::nanoseconds timeout)
+    {
+        auto ns = timeout.count();
+        timespec relative {static_cast<time_t>(ns / 1'000'000'000), ns % 1'000'000'000};
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT, expected, &relative,
+                nullptr, 0);
+    }
+
+
+    void wakeAll(std::atomic<uint32_t> &word)
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT_MAX, nullptr,
+                nullptr, 0);
+    }
+
+} // namespace shm::futex
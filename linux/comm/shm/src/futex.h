@@ -0,0 +1,25 @@
+/**
+ * @file futex.h
+ * @brief Sleeping on a word of the bus, across processes
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_SHM_FUTEX_H_
+#define COMM_SHM_FUTEX_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace shm::futex {
+    // Sleeps while word holds expected, up to timeout. Not FUTEX_PRIVATE, the word is
+    // in shared memory.
+    void wait(std::atomic<uint32_t> &word, uint32_t expected, std::chrono::nanoseconds timeout);
+
+    // Wakes everything sleeping on word
+    void wakeAll(std::atomic<uint32_t> &word);
+
+} // namespace shm::futex
+
+#endif
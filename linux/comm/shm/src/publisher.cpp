@@ -0,0 +1,111 @@
+/**
+ * @file publisher.cpp
+ * @brief Writer end of the shared-memory telemetry bus
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/shm/publisher.h"
+
+#include "futex.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace shm {
+    Publisher::Publisher(const std::string &name, size_t slotCount)
+        : name_(name), slotCount_(slotCount)
+    {
+        // Replace any bus left over from an earlier run rather than reuse its contents
+        shm_unlink(name_.c_str());
+        int fd {shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660)};
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name_);
+        }
+
+        size_t size {mappingSize(slotCount_)};
+        if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+            int error {errno};
+            close(fd);
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + name_);
+        }
+
+        mapping_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error {errno};
+        close(fd); // The mapping keeps the object open
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            shm_unlink(name_.c_str());
+            throw std::system_error(error, std::generic_category(), "mmap " + name_);
+        }
+
+        // ftruncate() zeroed it, every slot starts at sequence 0 (never written)
+        header_ = new (mapping_) Header {};
+        slots_  = reinterpret_cast<Slot *>(static_cast<uint8_t *>(mapping_) + SLOTS_OFFSET);
+        header_->version   = VERSION;
+        header_->slotCount = slotCount_;
+
+        // Readers check the magic last, once everything else is in place
+        std::atomic_ref<uint32_t>(header_->magic).store(MAGIC, std::memory_order_release);
+    }
+
+
+    Publisher::~Publisher()
+    {
+        munmap(mapping_, mappingSize(slotCount_));
+        shm_unlink(name_.c_str());
+    }
+
+
+    void Publisher::publish(const uart::DataPacket &packet,
+                            std::chrono::steady_clock::time_point received)
+    {
+        Slot &slot {slots_[next_ % slotCount_]};
+        auto data = packet.getData();
+
+        slot.seq.store(2 * next_ + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.message.receivedNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(received.time_since_epoch())
+                .count());
+        slot.message.timestamp = packet.getTimestamp();
+        slot.message.id        = packet.getID();
+        slot.message.length    = static_cast<uint8_t>(data.size());
+        std::copy(data.begin(), data.end(), slot.message.data.begin());
+
+        slot.seq.store(2 * next_ + 2, std::memory_order_release);
+        next_++;
+        header_->head.store(next_, std::memory_order_release);
+
+        // A reader about to sleep bumps waiters first, then checks futexWord
+        header_->futexWord.store(static_cast<uint32_t>(next_), std::memory_order_seq_cst);
+        if (header_->waiters.load(std::memory_order_seq_cst) > 0) {
+            futex::wakeAll(header_->futexWord);
+        }
+    }
+
+
+    std::vector<uart::recv::SubscriptionId>
+    publishFromRecv(Publisher &publisher, std::initializer_list<uart::ePacketID> ids)
+    {
+        std::vector<uart::recv::SubscriptionId> subscriptions;
+        for (auto id : ids) {
+            subscriptions.push_back(uart::recv::subscribe(
+                id,
+                [&publisher](const uart::DataPacket &packet) {
+                    publisher.publish(packet, std::chrono::steady_clock::now());
+                },
+                uart::recv::eExecutor::INLINE));
+        }
+        return subscriptions;
+    }
+
+} // namespace shm
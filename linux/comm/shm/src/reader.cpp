@@ -0,0 +1,117 @@
+/**
+ * @file reader.cpp
+ * @brief Reader end of the shared-memory telemetry bus
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/shm/reader.h"
+
+#include "futex.h"
+
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace shm {
+    Reader::Reader(const std::string &name)
+    {
+        // Read-write only for Header::waiters, readers never write to the ring
+        int fd {shm_open(name.c_str(), O_RDWR, 0)};
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+        }
+
+        struct stat info {};
+        if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < mappingSize(0)) {
+            close(fd);
+            throw std::system_error(EINVAL, std::generic_category(), name + " is not a bus");
+        }
+        mappingSize_ = static_cast<size_t>(info.st_size);
+
+        mapping_ = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        int error {errno};
+        close(fd);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::system_error(error, std::generic_category(), "mmap " + name);
+        }
+
+        header_ = static_cast<Header *>(mapping_);
+        slots_  = reinterpret_cast<const Slot *>(static_cast<uint8_t *>(mapping_) + SLOTS_OFFSET);
+        if (std::atomic_ref<uint32_t>(header_->magic).load(std::memory_order_acquire) != MAGIC
+            || header_->version != VERSION
+            || mappingSize(header_->slotCount) > mappingSize_) {
+            munmap(mapping_, mappingSize_);
+            throw std::system_error(EINVAL, std::generic_category(), name + " is not a bus");
+        }
+        slotCount_ = header_->slotCount;
+
+        // Only what's published from now on
+        next_ = header_->head.load(std::memory_order_acquire);
+    }
+
+
+    Reader::~Reader() { munmap(mapping_, mappingSize_); }
+
+
+    bool Reader::read(Message &message)
+    {
+        while (true) {
+            const Slot &slot {slots_[next_ % slotCount_]};
+            uint64_t expected {2 * next_ + 2};
+
+            uint64_t before {slot.seq.load(std::memory_order_acquire)};
+            if (before < expected) {
+                return false; // Not written yet, or still being written
+            }
+
+            if (before == expected) {
+                message = slot.message;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == expected) {
+                    next_++;
+                    return true;
+                }
+            }
+
+            // Lapped, the publisher overwrote it. Skip to the oldest message still there,
+            // leaving a slot's margin for the one being written now.
+            uint64_t head {header_->head.load(std::memory_order_acquire)};
+            uint64_t oldest {head > slotCount_ ? head - slotCount_ + 1 : 0};
+            if (oldest > next_) {
+                lost_ += oldest - next_;
+                next_ = oldest;
+            } else {
+                lost_++;
+                next_++;
+            }
+        }
+    }
+
+
+    bool Reader::wait(std::chrono::microseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (header_->head.load(std::memory_order_acquire) <= next_) {
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= std::chrono::steady_clock::duration::zero()) {
+                return false;
+            }
+
+            // Pairs with publish(): either it sees waiters, or this sees the new word
+            header_->waiters.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t word {static_cast<uint32_t>(next_)};
+            if (header_->futexWord.load(std::memory_order_seq_cst) == word) {
+                futex::wait(header_->futexWord, word, left);
+            }
+            header_->waiters.fetch_sub(1, std::memory_order_seq_cst);
+        }
+        return true;
+    }
+
+} // namespace shm
@@ -0,0 +1,103 @@
+/**
+ * @file arq.h
+ * @brief Sequence numbers and the receiving window of the reliable channel
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A reliable frame has RELIABLE_FLAG set in its ID byte and an 8-bit sequence number
+ * as the first payload byte. The receiver answers with an Ack (ACK_RADXA or ACK_STM32)
+ * holding the next sequence number it expects plus a bitmap of the frames it already
+ * has beyond that, so the sender only repeats the frames that were actually lost.
+ *
+ * The sender sets RELIABLE_SYN_FLAG until its first Ack arrives. The first SYN frame
+ * after a non-SYN one restarts the receiving window, so either end may reboot without
+ * the other mistaking the new frames for duplicates.
+ */
+
+#ifndef COMM_UART_ARQ_H_
+#define COMM_UART_ARQ_H_
+
+#include "comm/uart/payloads.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::arq {
+    // Frames the Ack bitmap covers past next_seq, and so the largest usable window
+    constexpr size_t SACK_BITS {32};
+
+    /** @brief true if sequence number a comes before b, modulo 256 (RFC 1982) */
+    constexpr bool seqBefore(uint8_t a, uint8_t b) noexcept
+    {
+        return static_cast<int8_t>(static_cast<uint8_t>(a - b)) < 0;
+    }
+
+
+    /**
+     * @class Receiver
+     * @brief Tracks which sequence numbers arrived, to drop duplicates and build Acks.
+     *
+     * Frames are delivered as they arrive rather than reordered. A UART doesn't reorder,
+     * so a gap only means a frame was lost and its retransmission is still useful alone.
+     */
+    class Receiver {
+      public:
+        /**
+         * @brief Records a received sequence number.
+         * @param isSyn RELIABLE_SYN_FLAG was set on the frame.
+         * @return true the first time seq is seen, false for a duplicate.
+         */
+        bool accept(uint8_t seq, bool isSyn) noexcept
+        {
+            auto offset {static_cast<uint8_t>(seq - nextSeq_)};
+            bool isInWindow {offset <= SACK_BITS || seqBefore(seq, nextSeq_)};
+
+            // Peer restarted, or this is the first frame since we did
+            if (!isSynced_ || (isSyn && (!isInSyn_ || !isInWindow))) {
+                nextSeq_  = seq;
+                sackMask_ = 0;
+                offset    = 0;
+                isSynced_ = true;
+            }
+            isInSyn_ = isSyn;
+
+            if (seqBefore(seq, nextSeq_)) {
+                return false; // Already acked
+            }
+
+            if (offset == 0) {
+                // Slide past seq and everything after it that already arrived
+                bool isNextReceived {true};
+                while (isNextReceived) {
+                    nextSeq_++;
+                    isNextReceived = (sackMask_ & 1) != 0;
+                    sackMask_ >>= 1;
+                }
+                return true;
+            }
+
+            if (offset > SACK_BITS) {
+                return false; // Beyond any window the sender can have open
+            }
+
+            uint32_t bit {uint32_t {1} << (offset - 1)};
+            if (sackMask_ & bit) {
+                return false;
+            }
+            sackMask_ |= bit;
+            return true;
+        }
+
+        /** @brief Ack describing everything received so far */
+        payload::Ack getAck() const noexcept { return payload::Ack {nextSeq_, sackMask_}; }
+
+      private:
+        uint8_t nextSeq_ {0};
+        uint32_t sackMask_ {0};
+        bool isSynced_ {false};
+        bool isInSyn_ {false}; // Last frame had the SYN flag
+    };
+
+} // namespace uart::arq
+
+#endif
@@ -0,0 +1,59 @@
+/**
+ * @file baud.h
+ * @brief Raises the UART baud rate at runtime and falls back when the link degrades
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_BAUD_H_
+#define COMM_UART_BAUD_H_
+
+#include "comm/uart/config.h"
+#include "comm/uart/packet_view.h"
+#include "hal/SerialUART.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+/**
+ * @namespace uart::baud
+ * @brief Radxa side of the handshake in baud_negotiation.h.
+ *
+ * The link starts at config::BAUDRATE. Once send and recv (or the reactor) are
+ * running, negotiate() moves both ends to the fastest rate that passes an echo test.
+ * From then on every read is checked by an ErrorMonitor, and both ends drop back to
+ * config::BAUDRATE on their own if the error rate climbs or the link goes quiet.
+ */
+namespace uart::baud {
+    void init(std::shared_ptr<SerialUART> uartPtr);
+    void deinit();
+
+    /**
+     * @brief Tries each rate in turn until one passes, blocking for up to a second per
+     *        rate. Stops at the first rate that isn't faster than the current one.
+     * @param candidates Rates in bits per second, fastest first.
+     * @return The rate in use afterwards.
+     */
+    uint32_t negotiate(std::span<const uint32_t> candidates = config::BAUD_CANDIDATES);
+
+    // Called by recv for CONFIG_BAUD and LINK_TEST
+    void onFrame(const DataPacketView &view);
+
+    // Called by recv after every read, including ones that timed out empty.
+    // goodBytes passed the CRC, badBytes were discarded by the framer.
+    void onRxStats(size_t goodBytes, size_t badBytes);
+
+    // Sends keepalives and notices a silent link. Returns when it next needs to run.
+    // Called by recv after every read, or by uart::reactor in reactor mode.
+    std::chrono::steady_clock::time_point poll();
+
+    uint32_t getRate();
+
+    // Times the ErrorMonitor dropped the link back to config::BAUDRATE
+    uint64_t getFallbackCount();
+
+} // namespace uart::baud
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file baud_negotiation.h
+ * @brief Baud rate handshake and link error monitor shared by the Radxa and the STM32
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Both ends boot at BASE_BAUDRATE. The Radxa then raises the rate one candidate at a
+ * time, fastest first:
+ *
+ *  1. Radxa sends CONFIG_BAUD {rate, PROPOSE} at the current rate.
+ *  2. STM32 answers {rate, ACCEPT} at the current rate, then switches and starts a
+ *     TRIAL_TIMEOUT_MS timer. It answers REJECT for a rate it can't do.
+ *  3. Radxa switches, waits SETTLE_MS and sends LINK_TEST_COUNT LINK_TEST frames. The
+ *     STM32 echoes each one back. Every echo must pass the CRC and match the pattern.
+ *  4. Radxa sends {rate, COMMIT}, the STM32 stops its timer and echoes the COMMIT.
+ *
+ * If anything goes wrong after the switch, neither end hears the other: the STM32
+ * reverts when its timer runs out and the Radxa reverts after waiting the same time.
+ *
+ * Above BASE_BAUDRATE both ends keep an ErrorMonitor on what they receive, and drop
+ * back to BASE_BAUDRATE when too many bytes are rejected or the link goes silent. The
+ * other end then only sees garbage or silence, trips its own monitor, and follows.
+ * TELEMETRY keeps the Radxa's monitor fed, and the Radxa sends a LINK_TEST every
+ * KEEPALIVE_MS to keep the STM32's fed.
+ */
+
+#ifndef COMM_UART_BAUD_NEGOTIATION_H_
+#define COMM_UART_BAUD_NEGOTIATION_H_
+
+#include "comm/uart/payloads.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::baud {
+    constexpr uint32_t BASE_BAUDRATE {115200};
+
+    constexpr uint32_t TRIAL_TIMEOUT_MS {500}; // STM32 reverts if no COMMIT by then
+    constexpr uint32_t SETTLE_MS {20};         // Lets both ends finish switching
+    constexpr size_t LINK_TEST_COUNT {8};      // Echoes needed to pass, at most 32
+
+    // Fall back when more than ERROR_PERCENT of a window of received bytes were
+    // discarded, or nothing valid arrived for LINK_SILENCE_MS
+    constexpr uint32_t ERROR_WINDOW_BYTES {2048};
+    constexpr uint32_t ERROR_PERCENT {5};
+    constexpr uint32_t LINK_SILENCE_MS {1500};
+    constexpr uint32_t KEEPALIVE_MS {250};
+
+    // Sequence number of keepalives, never part of a test
+    constexpr uint16_t KEEPALIVE_SEQ {0xFFFF};
+
+
+    /**
+     * @brief LINK_TEST payload for a sequence number.
+     *
+     * Mixes the sync bytes, long runs of 0 and 1 bits and alternating bits, which are
+     * the patterns a marginal rate gets wrong first.
+     */
+    constexpr payload::LinkTest makeLinkTest(uint16_t seq) noexcept
+    {
+        constexpr uint8_t STRESS[] {SYNC_RECV, SYNC_SEND, 0x00, 0xFF, 0x55, 0xAA, 0x0F, 0xF0};
+
+        payload::LinkTest test {};
+        test.seq = seq;
+        for (size_t i = 0; i < test.pattern.size(); i++) {
+            test.pattern[i] = static_cast<uint8_t>(STRESS[i % sizeof(STRESS)] ^ (seq + i / 8));
+        }
+        return test;
+    }
+
+
+    /**
+     * @class Responder
+     * @brief STM32 side of the handshake.
+     *
+     * The caller sends the reply at the current rate, waits for it to leave the UART,
+     * and then applies getRate(). Partly received frames should be dropped whenever
+     * the rate changes, a garbled length byte could hold up the next real frame.
+     */
+    class Responder {
+      public:
+        /** @param maxRate Fastest rate this UART can run, faster proposals are rejected */
+        explicit constexpr Responder(uint32_t maxRate) noexcept : maxRate_(maxRate) {}
+
+        /**
+         * @brief Handles a CONFIG_BAUD from the Radxa.
+         * @param reply Set to the answer when returning true.
+         * @return true if reply should be sent.
+         */
+        bool onRequest(const payload::ConfigBaud &request, uint32_t nowMs,
+                       payload::ConfigBaud &reply) noexcept
+        {
+            reply = request;
+
+            switch (request.action) {
+            case payload::eBaudAction::PROPOSE:
+                if (request.baudrate > maxRate_ || request.baudrate == 0) {
+                    reply.action = payload::eBaudAction::REJECT;
+                    return true;
+                }
+                if (!isTrial_) {
+                    previousRate_ = rate_;
+                }
+                rate_         = request.baudrate;
+                isTrial_      = true;
+                trialStartMs_ = nowMs;
+                reply.action  = payload::eBaudAction::ACCEPT;
+                return true;
+
+            case payload::eBaudAction::COMMIT:
+                // Also repeats the answer when the Radxa missed the first one
+                if (request.baudrate != rate_) {
+                    reply.action = payload::eBaudAction::REJECT;
+                    return true;
+                }
+                isTrial_ = false;
+                return true;
+
+            default:
+                return false;
+            }
+        }
+
+        /** @brief Ends a trial that timed out. Returns true if the rate changed. */
+        bool poll(uint32_t nowMs) noexcept
+        {
+            if (!isTrial_ || nowMs - trialStartMs_ < TRIAL_TIMEOUT_MS) {
+                return false;
+            }
+            isTrial_ = false;
+            rate_    = previousRate_;
+            return true;
+        }
+
+        /** @brief Called when the ErrorMonitor trips */
+        void fallback() noexcept
+        {
+            isTrial_ = false;
+            rate_    = BASE_BAUDRATE;
+        }
+
+        uint32_t getRate() const noexcept { return rate_; }
+
+        /** @brief Waiting for COMMIT, the ErrorMonitor should be ignored until then */
+        bool isTrial() const noexcept { return isTrial_; }
+
+      private:
+        uint32_t maxRate_;
+        uint32_t rate_ {BASE_BAUDRATE};
+        uint32_t previousRate_ {BASE_BAUDRATE};
+        uint32_t trialStartMs_ {0};
+        bool isTrial_ {false};
+    };
+
+
+    /**
+     * @class ErrorMonitor
+     * @brief Decides when a rate above BASE_BAUDRATE has stopped working.
+     */
+    class ErrorMonitor {
+      public:
+        /**
+         * @brief Records received bytes, call after every read, even an empty one.
+         * @param goodBytes Bytes of frames that passed the CRC.
+         * @param badBytes Bytes the framer discarded.
+         * @return true if the link should fall back to BASE_BAUDRATE.
+         */
+        bool update(uint32_t goodBytes, uint32_t badBytes, uint32_t nowMs) noexcept
+        {
+            if (goodBytes > 0) {
+                lastGoodMs_ = nowMs;
+            }
+
+            good_ += goodBytes;
+            bad_ += badBytes;
+            if (good_ + bad_ >= ERROR_WINDOW_BYTES) {
+                bool isTooMany {uint64_t {bad_} * 100 > uint64_t {good_ + bad_} * ERROR_PERCENT};
+                good_ = 0;
+                bad_  = 0;
+                if (isTooMany) {
+                    return true;
+                }
+            }
+
+            return nowMs - lastGoodMs_ > LINK_SILENCE_MS;
+        }
+
+        /** @brief Starts over, e.g. after changing rate */
+        void reset(uint32_t nowMs) noexcept
+        {
+            good_       = 0;
+            bad_        = 0;
+            lastGoodMs_ = nowMs;
+        }
+
+      private:
+        uint32_t good_ {0};
+        uint32_t bad_ {0};
+        uint32_t lastGoodMs_ {0};
+    };
+
+} // namespace uart::baud
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file bounded_queue.h
+ * @brief Fixed-capacity lock-free queue for passing packets between threads
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * @link
+ * https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ */
+
+#ifndef COMM_UART_BOUNDED_QUEUE_H_
+#define COMM_UART_BOUNDED_QUEUE_H_
+
+#include "comm/uart/config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace uart {
+    /** @brief What push() does when the queue is full */
+    enum class eOverflowPolicy : uint8_t {
+        DROP_OLDEST, // Evict the oldest item to make room, push always succeeds
+        DROP_NEWEST, // Reject the new item, push returns false
+        BLOCK,       // Wait for the consumer, up to config::QUEUE_BLOCK_TIMEOUT_MS
+    };
+
+
+    /**
+     * @class BoundedQueue
+     * @brief Bounded lock-free ring buffer, normally one producer and one consumer.
+     *
+     * Each slot carries a sequence number (Vyukov's bounded queue) so that push() and
+     * pop() never take a lock. Both ends claim slots with a CAS, so several threads may
+     * push (e.g. an E-stop from any thread), the producer can evict the oldest item
+     * under DROP_OLDEST, and another thread can call clear() while the consumer runs.
+     * With a single producer and consumer the CAS never retries.
+     *
+     * The producer and consumer indices sit on separate cache lines to avoid false
+     * sharing between the two threads.
+     */
+    template <typename T, size_t Capacity>
+    class BoundedQueue {
+        static_assert(Capacity > 0, "Capacity must be non-zero");
+
+      public:
+        explicit BoundedQueue(eOverflowPolicy policy = eOverflowPolicy::DROP_NEWEST)
+            : policy_(policy)
+        {
+            for (size_t i = 0; i < Capacity; i++) {
+                slots_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~BoundedQueue() { clear(); }
+
+        BoundedQueue(const BoundedQueue &)            = delete;
+        BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+        /**
+         * @brief Adds an item, applying the overflow policy if the queue is full.
+         * @return false if the item was dropped.
+         */
+        bool push(T item)
+        {
+            if (tryPush(item)) {
+                return true;
+            }
+
+            overflows_.fetch_add(1, std::memory_order_relaxed);
+
+            switch (policy_.load(std::memory_order_relaxed)) {
+            case eOverflowPolicy::DROP_OLDEST:
+                // The consumer may be mid-pop on the oldest slot, so retry until free
+                while (!tryPush(item)) {
+                    if (!tryPop().has_value()) {
+                        std::this_thread::yield();
+                    }
+                }
+                return true;
+
+            case eOverflowPolicy::BLOCK: {
+                const auto deadline = std::chrono::steady_clock::now()
+                                    + std::chrono::milliseconds(config::QUEUE_BLOCK_TIMEOUT_MS);
+                while (std::chrono::steady_clock::now() < deadline) {
+                    std::this_thread::yield();
+                    if (tryPush(item)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            case eOverflowPolicy::DROP_NEWEST:
+            default:
+                return false;
+            }
+        }
+
+        /** @brief Removes the oldest item, or std::nullopt if empty. */
+        std::optional<T> pop() { return tryPop(); }
+
+        /** @brief Drops every queued item. */
+        void clear()
+        {
+            while (tryPop().has_value()) {}
+        }
+
+        /** @brief Approximate number of queued items. */
+        size_t size() const noexcept
+        {
+            size_t head {dequeuePos_.load(std::memory_order_acquire)};
+            size_t tail {enqueuePos_.load(std::memory_order_acquire)};
+            return (tail > head) ? (tail - head) : 0;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+        static constexpr size_t capacity() noexcept { return Capacity; }
+
+        void setPolicy(eOverflowPolicy policy) noexcept
+        {
+            policy_.store(policy, std::memory_order_relaxed);
+        }
+        eOverflowPolicy getPolicy() const noexcept
+        {
+            return policy_.load(std::memory_order_relaxed);
+        }
+
+        /** @brief Number of pushes that found the queue full, whatever the policy. */
+        uint64_t getOverflowCount() const noexcept
+        {
+            return overflows_.load(std::memory_order_relaxed);
+        }
+
+      private:
+        struct Slot {
+            std::atomic<size_t> seq;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T *ptr() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+        };
+
+        // Producer side
+        alignas(config::CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos_ {0};
+
+        // Consumer side
+        alignas(config::CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos_ {0};
+
+        // Rarely written
+        alignas(config::CACHE_LINE_SIZE) std::atomic<uint64_t> overflows_ {0};
+        std::atomic<eOverflowPolicy> policy_;
+
+        alignas(config::CACHE_LINE_SIZE) Slot slots_[Capacity];
+
+        // Only moves from item when it succeeds
+        bool tryPush(T &item)
+        {
+            size_t pos {enqueuePos_.load(std::memory_order_relaxed)};
+            Slot *slot {nullptr};
+
+            while (true) {
+                slot = &slots_[pos % Capacity];
+                size_t seq {slot->seq.load(std::memory_order_acquire)};
+                auto diff {static_cast<std::ptrdiff_t>(seq - pos)};
+
+                if (diff == 0) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                                          std::memory_order_acq_rel)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false; // Full, or the consumer hasn't released the slot yet
+                } else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (slot->storage) T(std::move(item));
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> tryPop()
+        {
+            size_t pos {dequeuePos_.load(std::memory_order_relaxed)};
+            Slot *slot {nullptr};
+
+            while (true) {
+                slot = &slots_[pos % Capacity];
+                size_t seq {slot->seq.load(std::memory_order_acquire)};
+                auto diff {static_cast<std::ptrdiff_t>(seq - (pos + 1))};
+
+                if (diff == 0) {
+                    if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                                          std::memory_order_acq_rel)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return std::nullopt; // Empty
+                } else {
+                    pos = dequeuePos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            std::optional<T> item {std::move(*slot->ptr())};
+            slot->ptr()->~T();
+            slot->seq.store(pos + Capacity, std::memory_order_release);
+            return item;
+        }
+    };
+
+} // namespace uart
+
+#endif
@@ -0,0 +1,47 @@
+/**
+ * @file byte_order.h
+ * @brief Little-endian field access for packet buffers
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Multi-byte packet fields are little-endian on the wire. These helpers work byte by
+ * byte so they are safe on unaligned buffers and on either host byte order.
+ */
+
+#ifndef COMM_UART_BYTE_ORDER_H_
+#define COMM_UART_BYTE_ORDER_H_
+
+#include <cstdint>
+
+namespace uart::byte_order {
+    constexpr uint16_t loadLe16(const uint8_t *src) noexcept
+    {
+        return static_cast<uint16_t>(src[0] | (src[1] << 8));
+    }
+
+
+    constexpr uint32_t loadLe32(const uint8_t *src) noexcept
+    {
+        return static_cast<uint32_t>(src[0]) | (static_cast<uint32_t>(src[1]) << 8)
+             | (static_cast<uint32_t>(src[2]) << 16) | (static_cast<uint32_t>(src[3]) << 24);
+    }
+
+
+    constexpr void storeLe16(uint8_t *dst, uint16_t value) noexcept
+    {
+        dst[0] = static_cast<uint8_t>(value);
+        dst[1] = static_cast<uint8_t>(value >> 8);
+    }
+
+
+    constexpr void storeLe32(uint8_t *dst, uint32_t value) noexcept
+    {
+        dst[0] = static_cast<uint8_t>(value);
+        dst[1] = static_cast<uint8_t>(value >> 8);
+        dst[2] = static_cast<uint8_t>(value >> 16);
+        dst[3] = static_cast<uint8_t>(value >> 24);
+    }
+
+} // namespace uart::byte_order
+
+#endif
@@ -0,0 +1,310 @@
+/**
+ * @file clock_sync.h
+ * @brief Ping/pong exchange and estimator that map STM32 time onto Radxa time
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Packet timestamps are HAL ticks on the STM32, milliseconds since its boot, and
+ * steady_clock on the Radxa. To compare them, the Radxa sends LINK_TEST pings with a
+ * sequence number from SYNC_SEQ_FIRST up, holding the time it sent them (t1). Instead
+ * of echoing such a ping unchanged, the STM32 stamps its own time when it received it
+ * (t2) and when it sends the pong (t3), and marks the pong as stamped. The Radxa notes
+ * when the pong arrived (t4). Firmware without time sync echoes pings unchanged, as it
+ * does baud tests, and those unmarked pongs are dropped.
+ *
+ * STM32 times are the HAL tick plus the microseconds into that tick, read from SysTick,
+ * so they share the epoch of packet timestamps. Ticks wrap after about 49.7 days and
+ * are unwrapped against the last one seen.
+ *
+ * The STM32 only needs isSyncSeq() and stampPong().
+ */
+
+#ifndef COMM_UART_CLOCK_SYNC_H_
+#define COMM_UART_CLOCK_SYNC_H_
+
+#include "comm/uart/baud_negotiation.h"
+#include "comm/uart/byte_order.h"
+#include "comm/uart/payloads.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::timesync {
+    // LINK_TEST sequence numbers from here up, except baud::KEEPALIVE_SEQ, are pings.
+    // Baud echo tests stay below 0x8008.
+    constexpr uint16_t SYNC_SEQ_FIRST {0xC000};
+
+    constexpr bool isSyncSeq(uint16_t seq) noexcept
+    {
+        return seq >= SYNC_SEQ_FIRST && seq != baud::KEEPALIVE_SEQ;
+    }
+
+
+    /** @brief A point in STM32 time */
+    struct McuTime {
+        uint32_t ms {};    // HAL tick, as in packet timestamps
+        uint16_t subUs {}; // Microseconds since the tick, 0-999
+    };
+
+
+    /** @brief One ping and its pong, in the order the stamps were taken */
+    struct Exchange {
+        uint64_t hostSentNs {}; // t1, steady_clock on the Radxa
+        McuTime received {};    // t2
+        McuTime sent {};        // t3
+        bool isStamped {};      // By stampPong(), rather than echoed unchanged
+    };
+
+
+    // Where the stamps sit in LinkTest::pattern, the rest is zero
+    constexpr size_t HOST_SENT_OFFSET {0};
+    constexpr size_t RECEIVED_OFFSET {8};
+    constexpr size_t SENT_OFFSET {14};
+    constexpr size_t STAMPED_OFFSET {20};
+
+    // Left by stampPong(), zero in a ping
+    constexpr uint32_t STAMPED_MARK {0x53594E43}; // "SYNC"
+
+
+    /** @brief Ping number n, sent at hostSentNs */
+    constexpr payload::LinkTest makePing(uint16_t n, uint64_t hostSentNs) noexcept
+    {
+        payload::LinkTest ping {};
+        ping.seq = static_cast<uint16_t>(SYNC_SEQ_FIRST
+                                         + n % (baud::KEEPALIVE_SEQ - SYNC_SEQ_FIRST));
+
+        uint8_t *dst {ping.pattern.data() + HOST_SENT_OFFSET};
+        byte_order::storeLe32(dst, static_cast<uint32_t>(hostSentNs));
+        byte_order::storeLe32(dst + 4, static_cast<uint32_t>(hostSentNs >> 32));
+        return ping;
+    }
+
+
+    /**
+     * @brief STM32: turns a ping into its pong, keeping the Radxa's stamp.
+     * @param received When the ping's last byte arrived.
+     * @param sent Just before the pong goes out, as late as possible.
+     */
+    constexpr void stampPong(payload::LinkTest &ping, McuTime received, McuTime sent) noexcept
+    {
+        byte_order::storeLe32(ping.pattern.data() + RECEIVED_OFFSET, received.ms);
+        byte_order::storeLe16(ping.pattern.data() + RECEIVED_OFFSET + 4, received.subUs);
+        byte_order::storeLe32(ping.pattern.data() + SENT_OFFSET, sent.ms);
+        byte_order::storeLe16(ping.pattern.data() + SENT_OFFSET + 4, sent.subUs);
+        byte_order::storeLe32(ping.pattern.data() + STAMPED_OFFSET, STAMPED_MARK);
+    }
+
+
+    constexpr Exchange readPong(const payload::LinkTest &pong) noexcept
+    {
+        const uint8_t *src {pong.pattern.data()};
+
+        Exchange exchange {};
+        exchange.hostSentNs = byte_order::loadLe32(src + HOST_SENT_OFFSET)
+                            | uint64_t {byte_order::loadLe32(src + HOST_SENT_OFFSET + 4)} << 32;
+        exchange.received   = {byte_order::loadLe32(src + RECEIVED_OFFSET),
+                               byte_order::loadLe16(src + RECEIVED_OFFSET + 4)};
+        exchange.sent       = {byte_order::loadLe32(src + SENT_OFFSET),
+                               byte_order::loadLe16(src + SENT_OFFSET + 4)};
+        exchange.isStamped  = byte_order::loadLe32(src + STAMPED_OFFSET) == STAMPED_MARK;
+        return exchange;
+    }
+
+
+    /**
+     * @brief Extends a 32-bit counter that wraps, picking the value closest to near.
+     *
+     * Right for any value within 2^31 counts of near, about 24.8 days for HAL ticks.
+     * May go below 0 when the counter had wrapped before near was taken.
+     */
+    constexpr int64_t unwrap(uint32_t value, int64_t near) noexcept
+    {
+        return near + static_cast<int32_t>(value - static_cast<uint32_t>(near));
+    }
+
+
+    /**
+     * @class Estimator
+     * @brief Offset and drift of the STM32 clock, from the last WINDOW exchanges.
+     *
+     * Each exchange pairs the middle of the STM32's turnaround with the middle of the
+     * round trip. Frames queued behind others make one leg slower than the other, so
+     * only exchanges within RTT_SLACK_NS of the fastest round trip in the window are
+     * used, or the MIN_USED fastest when too few are. A least-squares line through
+     * those gives host time from STM32 time, with its slope (the drift) held at nominal
+     * until they span MIN_SPAN_US.
+     *
+     * An exchange far off the line with a fast round trip means the STM32 rebooted
+     * or its clock stepped, and starts the estimate over.
+     */
+    class Estimator {
+      public:
+        static constexpr size_t WINDOW {32};
+        static constexpr int64_t RTT_SLACK_NS {200'000};
+        static constexpr size_t MIN_USED {WINDOW / 8};
+        static constexpr int64_t MIN_SPAN_US {2'000'000};
+        static constexpr double STEP_NS {5'000'000};
+
+        /**
+         * @brief Adds an exchange.
+         * @param hostReceivedNs t4, when the pong's last byte was read.
+         * @return false if its stamps can't be right and it was dropped.
+         */
+        bool add(const Exchange &exchange, uint64_t hostReceivedNs) noexcept
+        {
+            Point point {};
+            if (!toPoint(exchange, hostReceivedNs, point)) {
+                return false;
+            }
+
+            // Nearly as fast as the best, and still nowhere near the line
+            if (usedCount_ > 0 && point.rttNs <= minRttNs_ + RTT_SLACK_NS
+                && std::fabs(point.hostNs - toHostNs(point.mcuUs)) > STEP_NS) {
+                reset();
+                toPoint(exchange, hostReceivedNs, point);
+            }
+
+            lastMs_        = extendMs(exchange.sent.ms);
+            points_[next_] = point;
+            next_          = (next_ + 1) % WINDOW;
+            count_         = count_ < WINDOW ? count_ + 1 : WINDOW;
+            fit();
+            return true;
+        }
+
+        void reset() noexcept
+        {
+            count_     = 0;
+            next_      = 0;
+            usedCount_ = 0;
+            lastMs_    = 0;
+        }
+
+        bool isSynced() const noexcept { return usedCount_ > 0; }
+
+        /** @brief Unwraps a HAL tick into milliseconds against the latest pong */
+        int64_t extendMs(uint32_t ms) const noexcept
+        {
+            return count_ > 0 ? unwrap(ms, lastMs_) : int64_t {ms};
+        }
+
+        /** @brief Unwrapped STM32 time in microseconds, as toHostNs() takes it */
+        int64_t toUs(McuTime time) const noexcept { return extendMs(time.ms) * 1000 + time.subUs; }
+
+        /** @brief STM32 time from toUs() to steady_clock nanoseconds */
+        double toHostNs(double mcuUs) const noexcept
+        {
+            return refHostNs_ + nsPerUs_ * (mcuUs - refMcuUs_);
+        }
+
+        double toMcuUs(double hostNs) const noexcept
+        {
+            return refMcuUs_ + (hostNs - refHostNs_) / nsPerUs_;
+        }
+
+        /** @brief STM32 clock rate error in parts per million, positive if it runs fast */
+        double getDriftPpm() const noexcept { return (1000.0 / nsPerUs_ - 1) * 1e6; }
+
+        /** @brief RMS distance of the used exchanges from the line */
+        double getResidualNs() const noexcept { return residualNs_; }
+
+        int64_t getMinRttNs() const noexcept { return minRttNs_; }
+        size_t getCount() const noexcept { return count_; }         // Exchanges in the window
+        size_t getUsedCount() const noexcept { return usedCount_; } // Of those, on the line
+
+      private:
+        struct Point {
+            double mcuUs {};  // Middle of the STM32's turnaround
+            double hostNs {}; // Middle of the round trip
+            int64_t rttNs {}; // Round trip less the turnaround
+        };
+
+        bool toPoint(const Exchange &exchange, uint64_t hostReceivedNs, Point &point) const noexcept
+        {
+            int64_t received {toUs(exchange.received)};
+            int64_t sent {toUs(exchange.sent)};
+            auto roundTripNs {static_cast<int64_t>(hostReceivedNs - exchange.hostSentNs)};
+
+            point.mcuUs  = static_cast<double>(received + sent) / 2;
+            point.hostNs = static_cast<double>(exchange.hostSentNs / 2 + hostReceivedNs / 2);
+            point.rttNs  = roundTripNs - (sent - received) * 1000;
+            return exchange.isStamped && roundTripNs >= 0 && sent >= received
+                && point.rttNs >= 0;
+        }
+
+        void fit() noexcept
+        {
+            int64_t rtts[WINDOW] {};
+            for (size_t i = 0; i < count_; i++) {
+                rtts[i] = points_[i].rttNs;
+            }
+            size_t fastest {(count_ < MIN_USED ? count_ : MIN_USED) - 1};
+            std::nth_element(rtts, rtts + fastest, rtts + count_);
+            minRttNs_ = *std::min_element(rtts, rtts + fastest + 1);
+            maxRttNs_ = std::max(minRttNs_ + RTT_SLACK_NS, rtts[fastest]);
+
+            // Centered on the used points, so the sums keep their precision
+            double sumMcu {0};
+            double sumHost {0};
+            double minMcu {0};
+            double maxMcu {0};
+            size_t used {0};
+            for (size_t i = 0; i < count_; i++) {
+                if (points_[i].rttNs <= maxRttNs_) {
+                    double offset {points_[i].mcuUs - points_[0].mcuUs};
+                    minMcu = used == 0 || offset < minMcu ? offset : minMcu;
+                    maxMcu = used == 0 || offset > maxMcu ? offset : maxMcu;
+                    sumMcu += offset;
+                    sumHost += points_[i].hostNs - points_[0].hostNs;
+                    used++;
+                }
+            }
+            double meanMcu {sumMcu / static_cast<double>(used)};
+            double meanHost {sumHost / static_cast<double>(used)};
+
+            double sxx {0};
+            double sxy {0};
+            for (size_t i = 0; i < count_; i++) {
+                if (points_[i].rttNs <= maxRttNs_) {
+                    double dx {points_[i].mcuUs - points_[0].mcuUs - meanMcu};
+                    double dy {points_[i].hostNs - points_[0].hostNs - meanHost};
+                    sxx += dx * dx;
+                    sxy += dx * dy;
+                }
+            }
+
+            nsPerUs_   = maxMcu - minMcu >= MIN_SPAN_US ? sxy / sxx : 1000.0;
+            refMcuUs_  = points_[0].mcuUs + meanMcu;
+            refHostNs_ = points_[0].hostNs + meanHost;
+            usedCount_ = used;
+
+            double sumSquares {0};
+            for (size_t i = 0; i < count_; i++) {
+                if (points_[i].rttNs <= maxRttNs_) {
+                    double error {points_[i].hostNs - toHostNs(points_[i].mcuUs)};
+                    sumSquares += error * error;
+                }
+            }
+            residualNs_ = std::sqrt(sumSquares / static_cast<double>(used));
+        }
+
+        Point points_[WINDOW] {};
+        size_t count_ {0};
+        size_t next_ {0};
+        int64_t lastMs_ {0};
+
+        // The fitted line, host ns = refHostNs_ + nsPerUs_ * (mcu us - refMcuUs_)
+        double refMcuUs_ {0};
+        double refHostNs_ {0};
+        double nsPerUs_ {1000.0};
+        double residualNs_ {0};
+        int64_t minRttNs_ {0};
+        int64_t maxRttNs_ {0}; // Slowest round trip in use
+        size_t usedCount_ {0};
+    };
+
+} // namespace uart::timesync
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file cobs.h
+ * @brief Consistent Overhead Byte Stuffing for eWireFormat::COBS
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * COBS rewrites a frame so it contains no 0x00 byte, at a cost of one byte per 254, and
+ * the frame is then ended with a 0x00. Unlike a sync byte, the delimiter can't appear
+ * inside a frame, so after line noise the receiver is back in step at the very next
+ * delimiter: at most the frame the noise hit is lost.
+ */
+
+#ifndef COMM_UART_COBS_H_
+#define COMM_UART_COBS_H_
+
+#include "comm/uart/protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::cobs {
+    constexpr uint8_t DELIMITER {0x00};
+
+    /** @brief Encoded size of len bytes, without the delimiter */
+    constexpr size_t maxEncodedSize(size_t len) noexcept { return len + len / 254 + 1; }
+
+    // Longest frame on the wire, delimiter included
+    constexpr size_t MAX_FRAME_SIZE {maxEncodedSize(MAX_RAW_FRAME_SIZE) + 1};
+
+
+    /**
+     * @brief Encodes src, without appending the delimiter.
+     * @return Bytes written to dst, or 0 if dstSize is too small.
+     */
+    inline size_t encode(const uint8_t *src, size_t len, uint8_t *dst, size_t dstSize) noexcept
+    {
+        if (dstSize < maxEncodedSize(len)) {
+            return 0;
+        }
+
+        // Each block starts with a code byte: the distance to the next zero, or 0xFF
+        // for 254 bytes without one
+        size_t codeIndex {0};
+        size_t out {1};
+        uint8_t code {1};
+
+        for (size_t i = 0; i < len; i++) {
+            if (src[i] != 0) {
+                dst[out++] = src[i];
+                code++;
+            }
+
+            if (src[i] == 0 || code == 0xFF) {
+                dst[codeIndex] = code;
+                codeIndex      = out++;
+                code           = 1;
+            }
+        }
+
+        dst[codeIndex] = code;
+        return out;
+    }
+
+
+    /**
+     * @brief Decodes one frame, given without its delimiter.
+     * @return Bytes written to dst, or 0 if the frame is malformed or doesn't fit.
+     */
+    inline size_t decode(const uint8_t *src, size_t len, uint8_t *dst, size_t dstSize) noexcept
+    {
+        size_t out {0};
+        size_t i {0};
+
+        while (i < len) {
+            uint8_t code {src[i++]};
+            if (code == 0 || i + code - 1 > len || out + code - 1 > dstSize) {
+                return 0; // Delimiter inside the frame, or a block runs past the end
+            }
+
+            for (uint8_t k = 1; k < code; k++) {
+                if (src[i] == 0) {
+                    return 0;
+                }
+                dst[out++] = src[i++];
+            }
+
+            // A short block stands for a zero, except at the very end
+            if (code != 0xFF && i < len) {
+                if (out == dstSize) {
+                    return 0;
+                }
+                dst[out++] = 0;
+            }
+        }
+
+        return out;
+    }
+
+} // namespace uart::cobs
+
+#endif
@@ -8,24 +8,87 @@
 #ifndef COMM_UART_CONFIG_H_
 #define COMM_UART_CONFIG_H_
 
+#include "comm/uart/protocol.h"
+
+#include <array>
 #include <cstdint>
 #include <string>
-#include <termios.h>
 
 namespace uart::config {
     // Serial port settings
     const std::string UART_DEVICE {"/dev/ttyS2"};
-    constexpr int BAUDRATE {B115200};
+    constexpr uint32_t BAUDRATE {115200}; // Both ends start here, see uart::baud
     constexpr int TIMEOUT_SEC {1};
 
+    // RTS/CTS on the port. The STM32's USART1 must be set up with it too, credit-based
+    // flow control (uart::flow) works without.
+    constexpr bool HW_FLOW_CONTROL {false};
+
+    // Framing used by manager::init(), must match the firmware
+    constexpr eWireFormat WIRE_FORMAT {eWireFormat::SYNC_LENGTH};
+
+    // Frame checksum used by manager::init(), must match the firmware. CRC32 catches
+    // far more corruption at high baud rates and the STM32's CRC unit computes it.
+    constexpr eChecksum CHECKSUM {eChecksum::CRC8};
+
+    // Rates baud::negotiate() tries after startup, fastest first
+    constexpr std::array<uint32_t, 3> BAUD_CANDIDATES {2000000, 921600, 460800};
+
 	// Queue sizes
     constexpr size_t MAX_TX_QUEUE_SIZE {100};
     constexpr size_t MAX_RX_QUEUE_SIZE {100};
 
+    // Packets waiting for recv::subscribe() handlers, and the threads running POOL ones
+    constexpr size_t RX_POOL_QUEUE_SIZE {100};
+    constexpr size_t RX_MAILBOX_SIZE {100};
+    constexpr size_t RX_POOL_THREADS {2};
+
+    // Longest a producer waits on a full queue with eOverflowPolicy::BLOCK
+    constexpr int QUEUE_BLOCK_TIMEOUT_MS {50};
+
+    // Padding to keep data written by different threads on separate cache lines
+    constexpr size_t CACHE_LINE_SIZE {64};
+
     // Max packet size is 7 (header) + 255 (max data) + 1 (crc8)
 	// TODO: Figure out if you need null-terminated byte
     constexpr size_t READ_BUF_SIZE {264};
 
+    // Send thread serializes pending packets into one buffer per write
+    constexpr size_t TX_BATCH_BUF_SIZE {4 * READ_BUF_SIZE};
+
+    // Send pacing: bytes allowed ahead of the wire (kernel + UART FIFO) at the link
+    // rate. Bounds how long a safety packet waits behind bulk traffic to about one
+    // frame, instead of everything sitting in the kernel's tty buffer.
+    constexpr uint32_t TX_LINK_RATE_BPS {115200};
+    constexpr uint32_t TX_BITS_PER_BYTE {10}; // 8N1: start + 8 data + stop
+    constexpr size_t TX_MAX_INFLIGHT_BYTES {READ_BUF_SIZE};
+
+    // Flow control: the STM32's credit is resynced once nothing was written for this
+    // long before an advert arrived, see flow::Window
+    constexpr int FLOW_IDLE_MS {200};
+
+    // Reactor mode: reads per readiness event before yielding to other events
+    constexpr int MAX_READS_PER_EVENT {8};
+
+    // Reliable channel (uart::reliable). The window must fit the Ack bitmap (32).
+    constexpr size_t RELIABLE_WINDOW {16};    // Frames in flight before waiting for an Ack
+    constexpr int RELIABLE_RTO_INIT_MS {200}; // Retransmit timeout before the first RTT sample
+    constexpr int RELIABLE_RTO_MIN_MS {20};
+    constexpr int RELIABLE_RTO_MAX_MS {2000};
+    constexpr int RELIABLE_MAX_TRANSMISSIONS {8}; // Then the frame is given up on
+
+    // Receive framer ring buffer, must be a power of 2 and hold at least 2 packets
+    constexpr size_t FRAMER_BUF_SIZE {1024};
+
+    // Baud negotiation (uart::baud)
+    constexpr int BAUD_REPLY_TIMEOUT_MS {200}; // Per CONFIG_BAUD request
+    constexpr int BAUD_REQUEST_ATTEMPTS {3};
+
+    // Clock sync (uart::timesync). Pings go out quickly until the estimator's window
+    // is full, then slowly enough to cost about 1% of the link at BAUDRATE.
+    constexpr int TIMESYNC_FAST_PERIOD_MS {50};
+    constexpr int TIMESYNC_PERIOD_MS {500};
+
 } // namespace uart::config
 
 #endif
\ No newline at end of file
@@ -0,0 +1,60 @@
+/**
+ * @file crc.h
+ * @brief Checksums used by the UART packet protocol
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_CRC_H_
+#define COMM_UART_CRC_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::crc {
+    /**
+     * @brief CRC8 OpenSAFETY (poly 0x2F, init 0x00), table driven.
+     * @param data Bytes to checksum.
+     * @param len Number of bytes.
+     * @param crc Running value, pass the previous result to continue a checksum.
+     */
+    uint8_t crc8(const uint8_t *data, size_t len, uint8_t crc = 0x00) noexcept;
+
+
+    // Reset value of the STM32's CRC unit
+    constexpr uint32_t CRC32_INIT {0xFFFFFFFF};
+
+    /** @brief Ways crc32() can be computed, all giving the same result */
+    enum class eCrc32Impl : uint8_t {
+        TABLE,  // Slicing-by-8, 8 KB of tables, any CPU
+        PCLMUL, // x86 carry-less multiply, 16 bytes per fold
+        ARMV8,  // ARMv8 CRC32 instructions, e.g. the Radxa's Cortex-A55
+    };
+
+
+    /**
+     * @brief CRC-32 as the STM32F4's CRC unit computes it, fastest way this CPU allows.
+     *
+     * Poly 0x04C11DB7, no reflection and no final XOR. The unit only takes 32-bit words,
+     * which the Cortex-M4 loads little-endian and feeds in MSB first, so data is read
+     * as little-endian words and a partial last word is padded with zeros.
+     * @param data Bytes to checksum, any alignment.
+     * @param len Number of bytes.
+     * @param crc Running value, pass the previous result to continue a checksum. Only
+     *            valid if the previous len was a multiple of 4.
+     */
+    uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = CRC32_INIT) noexcept;
+
+    /** @brief Same, with the given implementation. It must be isSupported(). */
+    uint32_t crc32(eCrc32Impl impl, const uint8_t *data, size_t len,
+                   uint32_t crc = CRC32_INIT) noexcept;
+
+    /** @brief Whether this CPU can run impl, checked at runtime */
+    bool isSupported(eCrc32Impl impl) noexcept;
+
+    /** @brief The implementation crc32() picked at startup */
+    eCrc32Impl getCrc32Impl() noexcept;
+
+} // namespace uart::crc
+
+#endif
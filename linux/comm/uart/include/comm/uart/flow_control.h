@@ -0,0 +1,142 @@
+/**
+ * @file flow_control.h
+ * @brief Credit-based flow control of the Radxa -> STM32 direction
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * The STM32 has no hardware flow control, so bytes arriving while its receive buffer
+ * is full are lost. Instead it advertises room in every STATUS_STM32:
+ *
+ *  - rx_bytes: bytes it has taken off the wire since boot, wrapping at 2^32.
+ *  - rx_free: bytes free in its receive buffer at that point.
+ *
+ * The Radxa may then have sent at most rx_bytes + rx_free bytes in total, so it never
+ * writes more than the buffer can hold, however long the STM32 takes to read it.
+ * Counts are cumulative, a lost STATUS_STM32 only delays credit until the next one.
+ *
+ * Firmware without flow control leaves both at 0, which no real buffer can advertise,
+ * and the Radxa sends without limit.
+ *
+ * Besides its regular STATUS_STM32, the STM32 sends one whenever it has freed a
+ * 1/UPDATE_DIVISOR of its buffer since the last, so a busy Radxa isn't left waiting.
+ */
+
+#ifndef COMM_UART_FLOW_CONTROL_H_
+#define COMM_UART_FLOW_CONTROL_H_
+
+#include "comm/uart/payloads.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart::flow {
+    constexpr uint32_t UPDATE_DIVISOR {2};
+
+    // More bytes than this in flight can't be right, one end restarted
+    constexpr uint32_t MAX_IN_FLIGHT {0x10000};
+
+
+    /**
+     * @class Advertiser
+     * @brief STM32 side, counts what enters and leaves the receive buffer.
+     */
+    class Advertiser {
+      public:
+        /** @param capacity Size of the receive buffer in bytes */
+        explicit constexpr Advertiser(uint16_t capacity) noexcept : capacity_(capacity) {}
+
+        /** @brief Bytes stored in the buffer, e.g. from the DMA position. Not overruns. */
+        void onReceived(uint32_t bytes) noexcept { received_ += bytes; }
+
+        /** @brief Bytes the application took out of the buffer */
+        void onConsumed(uint32_t bytes) noexcept { consumed_ += bytes; }
+
+        uint16_t getFree() const noexcept
+        {
+            return static_cast<uint16_t>(capacity_ - (received_ - consumed_));
+        }
+
+        /** @brief true when a STATUS_STM32 should go out now, without waiting its turn */
+        bool shouldAdvertise() const noexcept
+        {
+            return consumed_ - advertisedConsumed_ >= capacity_ / UPDATE_DIVISOR;
+        }
+
+        /** @brief Fills in the credit of a STATUS_STM32 about to be sent */
+        void fill(payload::StatusStm32 &status) noexcept
+        {
+            status.rx_bytes     = received_;
+            status.rx_free      = getFree();
+            advertisedConsumed_ = consumed_;
+        }
+
+      private:
+        uint16_t capacity_;
+        uint32_t received_ {0};
+        uint32_t consumed_ {0};
+        uint32_t advertisedConsumed_ {0};
+    };
+
+
+    /**
+     * @class Window
+     * @brief Radxa side, how many more bytes the STM32 can take.
+     *
+     * Unlimited until the first advert, and while adverts are 0/0, so firmware that
+     * doesn't advertise still works.
+     *
+     * If the STM32 counts bytes the Radxa never meant to send, e.g. noise while switching
+     * baud rate, or a byte sent is never counted, the count is resynced to the STM32's
+     * when an advert shows too much or too little in flight, or when nothing can still
+     * be in flight.
+     */
+    class Window {
+      public:
+        /**
+         * @param isIdle Nothing was sent for long enough that the advert covers all of it.
+         */
+        void onAdvert(uint32_t rxBytes, uint16_t rxFree, bool isIdle) noexcept
+        {
+            if (rxBytes == 0 && rxFree == 0) {
+                isKnown_ = false;
+                return; // Not advertised
+            }
+
+            uint32_t inFlight {sent_ - rxBytes};
+            if (inFlight > MAX_IN_FLIGHT || isIdle) {
+                sent_ = rxBytes;
+            }
+            limit_   = rxBytes + rxFree;
+            isKnown_ = true;
+        }
+
+        void onSent(size_t bytes) noexcept { sent_ += static_cast<uint32_t>(bytes); }
+
+        /** @brief Bytes that may be sent now, SIZE_MAX before the first advert */
+        size_t getAvailable() const noexcept
+        {
+            if (!isKnown_) {
+                return SIZE_MAX;
+            }
+            auto available {static_cast<int32_t>(limit_ - sent_)};
+            return available > 0 ? static_cast<size_t>(available) : 0;
+        }
+
+        bool isKnown() const noexcept { return isKnown_; }
+
+        void reset() noexcept
+        {
+            sent_    = 0;
+            limit_   = 0;
+            isKnown_ = false;
+        }
+
+      private:
+        uint32_t sent_ {0};
+        uint32_t limit_ {0};
+        bool isKnown_ {false};
+    };
+
+} // namespace uart::flow
+
+#endif
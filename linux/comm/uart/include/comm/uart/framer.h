@@ -0,0 +1,121 @@
+/**
+ * @file framer.h
+ * @brief Reassembles DataPackets from a continuous UART byte stream
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_FRAMER_H_
+#define COMM_UART_FRAMER_H_
+
+#include "comm/uart/cobs.h"
+#include "comm/uart/config.h"
+#include "comm/uart/packet_info.h"
+#include "comm/uart/packet_view.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace uart {
+    /**
+     * @class Framer
+     * @brief Persistent ring buffer that extracts complete packets from raw reads.
+     *
+     * A single read() may return part of a packet, or several packets back to back.
+     * Bytes are pushed in as they arrive and next() is called until it returns
+     * std::nullopt. Garbage before a sync byte, and frames that fail the CRC check,
+     * are skipped one byte at a time so the framer resyncs on the next sync byte.
+     *
+     * With eWireFormat::COBS, frames are split at each 0x00 instead. A frame that fails
+     * to decode or check is dropped whole, so noise never costs more than that frame.
+     */
+    class Framer {
+      public:
+        explicit Framer(eWireFormat format = eWireFormat::SYNC_LENGTH,
+                        eChecksum checksum = eChecksum::CRC8) noexcept
+            : format_(format),
+              checksum_(checksum)
+        {
+        }
+
+        /** @brief Switches framing, dropping buffered bytes */
+        void setFormat(eWireFormat format, eChecksum checksum = eChecksum::CRC8) noexcept
+        {
+            format_   = format;
+            checksum_ = checksum;
+            reset();
+        }
+
+        /**
+         * @brief Appends bytes to the ring buffer.
+         * @param data Bytes returned by SerialUART::readData().
+         * @param len Number of bytes in data.
+         *
+         * If the buffer is full, the oldest bytes are dropped and counted as discarded.
+         */
+        void push(const uint8_t *data, size_t len);
+
+        /**
+         * @brief Extracts the next valid packet from the buffer.
+         *
+         * Frames are validated in place and only copied to scratch space when they
+         * wrap around the end of the ring. The view stays valid until the next call to
+         * push() or next(); use DataPacketView::toPacket() to keep the packet.
+         * @return A view of the packet, or std::nullopt if no complete frame is
+         *         buffered yet.
+         */
+        std::optional<DataPacketView> next();
+
+        /** @brief Drops all buffered bytes. Counters are kept. */
+        void reset() noexcept;
+
+        // Statistics
+        size_t getBufferedBytes() const noexcept { return count_; }
+        uint64_t getDiscardedBytes() const noexcept { return discardedBytes_; }
+        uint64_t getCrcErrors() const noexcept { return crcErrors_; }
+        uint64_t getFrameCount() const noexcept { return frameCount_; }
+
+      private:
+        static constexpr size_t CAPACITY {config::FRAMER_BUF_SIZE};
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of 2");
+        static_assert(CAPACITY >= 2 * cobs::MAX_FRAME_SIZE, "Capacity too small");
+
+        eWireFormat format_;
+        eChecksum checksum_;
+
+        uint8_t ring_[CAPACITY] {};
+        size_t head_ {0};  // Index of the oldest byte
+        size_t count_ {0}; // Number of buffered bytes
+
+        // Linear copy of a frame that wraps around the end of ring_, or the decoded
+        // COBS frame
+        uint8_t scratch_[MAX_RAW_FRAME_SIZE + 1] {};
+
+        // COBS: bytes from head_ known to hold no delimiter, and whether the bytes up
+        // to the next delimiter are the rest of an oversized frame
+        size_t scanned_ {0};
+        bool isDropping_ {false};
+        uint8_t encoded_[cobs::MAX_FRAME_SIZE] {}; // Linear copy of a wrapped COBS frame
+
+        uint64_t discardedBytes_ {0};
+        uint64_t crcErrors_ {0};
+        uint64_t frameCount_ {0};
+
+        uint8_t peek(size_t offset) const noexcept
+        {
+            return ring_[(head_ + offset) & (CAPACITY - 1)];
+        }
+
+        std::optional<DataPacketView> nextSyncLength();
+        std::optional<DataPacketView> nextCobs();
+
+        void consume(size_t n) noexcept;
+        void discard(size_t n) noexcept;
+        size_t skipToSync() noexcept;
+        size_t findDelimiter() noexcept;
+        void copyOut(uint8_t *dst, size_t n) const noexcept;
+    };
+
+} // namespace uart
+
+#endif
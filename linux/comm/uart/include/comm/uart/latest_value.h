@@ -0,0 +1,91 @@
+/**
+ * @file latest_value.h
+ * @brief Wait-free slot holding only the newest value, for one writer and one reader
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_LATEST_VALUE_H_
+#define COMM_UART_LATEST_VALUE_H_
+
+#include "comm/uart/config.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace uart {
+    /**
+     * @class LatestValue
+     * @brief Triple buffer: write() replaces the value, read() gets the newest one.
+     *
+     * The writer fills a back buffer and swaps it with the middle one, the reader swaps
+     * the middle one with its front buffer if it holds anything newer. Each side owns
+     * its own buffer between swaps, so neither ever waits for the other, and a reader
+     * that falls behind skips straight to the newest value instead of working through
+     * stale ones.
+     *
+     * Every write() bumps a generation counter stored with the value, so the reader can
+     * tell a new value from the one it already saw.
+     */
+    template <typename T>
+    class LatestValue {
+      public:
+        struct Slot {
+            T value {};
+            uint64_t generation {0}; // Writes so far, 0 until the first
+        };
+
+        LatestValue()                               = default;
+        LatestValue(const LatestValue &)            = delete;
+        LatestValue &operator=(const LatestValue &) = delete;
+
+        /** @brief Writer only */
+        void write(const T &value)
+        {
+            Slot &back {slots_[back_]};
+            back.value      = value;
+            back.generation = ++written_;
+
+            // Publish it as the middle buffer and take the old middle one as the back
+            uint8_t previous {middle_.exchange(static_cast<uint8_t>(back_ | FRESH_BIT),
+                                               std::memory_order_acq_rel)};
+            back_ = previous & INDEX_MASK;
+        }
+
+        /**
+         * @brief Reader only, the newest value written. Valid until the next read().
+         * @return A generation of 0 before the first write().
+         */
+        const Slot &read()
+        {
+            if (middle_.load(std::memory_order_relaxed) & FRESH_BIT) {
+                uint8_t previous {middle_.exchange(front_, std::memory_order_acq_rel)};
+                front_ = previous & INDEX_MASK;
+            }
+            return slots_[front_];
+        }
+
+        /** @brief true if read() would return a value the reader hasn't seen. Reader only. */
+        bool hasNew() const { return middle_.load(std::memory_order_acquire) & FRESH_BIT; }
+
+        /** @brief Writes so far. Writer only. */
+        uint64_t getWritten() const { return written_; }
+
+      private:
+        static constexpr uint8_t INDEX_MASK {0x3};
+        static constexpr uint8_t FRESH_BIT {0x4}; // Middle buffer was written since read
+
+        Slot slots_[3] {};
+
+        // Written by both, on its own cache line
+        alignas(config::CACHE_LINE_SIZE) std::atomic<uint8_t> middle_ {1};
+
+        alignas(config::CACHE_LINE_SIZE) uint8_t back_ {0}; // Writer's
+        uint64_t written_ {0};
+
+        alignas(config::CACHE_LINE_SIZE) uint8_t front_ {2}; // Reader's
+    };
+
+} // namespace uart
+
+#endif
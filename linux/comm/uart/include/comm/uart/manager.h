@@ -8,11 +8,13 @@
 #ifndef COMM_UART_MANAGER_H_
 #define COMM_UART_MANAGER_H_
 
+#include "comm/uart/config.h"
+
 #include <cstdint>
+#include <string>
 
 /*
  * Additional features to add in the future:
- * - Queue size limit (prevent memory leak)
  * - Give uart::manager enqueue and dequeue wrapper functions
  * - Exceptions & exception handling
  */
@@ -22,8 +24,13 @@
  * @brief Manages UART communication interface.
  *
  * This module initializes/deinitializes and start/stop both send and recv modules. To
- * send and receive message from the uart port, use send::enqueue() and recv::dequeue()
- * functions respectively.
+ * send and receive message from the uart port, use send::enqueue() and recv::subscribe()
+ * (or recv::dequeue()) functions respectively. Packets that must arrive go through
+ * reliable::enqueue().
+ * After start(), baud::negotiate() raises the link above config::BAUDRATE.
+ *
+ * send and recv either run on their own threads (THREADED), or share one epoll thread
+ * (REACTOR, see uart::reactor) which has fewer context switches and stops immediately.
  */
 namespace uart::manager {
     enum class eRunStatus {
@@ -33,11 +40,17 @@ namespace uart::manager {
         BOTH_STOPPED,
     };
 
-    void init();
+    enum class eIoMode {
+        THREADED, // Blocking port, one thread each for send and recv
+        REACTOR,  // Non-blocking port, single epoll thread
+    };
+
+    // device is the UART to open, e.g. an emulator::Stm32's pty instead of the STM32
+    void init(const std::string &device = config::UART_DEVICE);
     void deinit();
 
     // Threads management
-    void start();
+    void start(eIoMode mode = eIoMode::THREADED);
     void stop();
     eRunStatus isRunning();
 
@@ -8,101 +8,105 @@
 #ifndef COMM_UART_PACKET_INFO_H_
 #define COMM_UART_PACKET_INFO_H_
 
+#include "comm/uart/payloads.h"
+#include "comm/uart/protocol.h"
+
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <span>
-#include <vector>
 
 namespace uart {
-    /** @brief List of IDs to/from the mcu */
-    enum class ePacketID : uint8_t {
-        // Receiving (STM32 -> Radxa)
-        TELEMETRY,    // Contains sensor (imu, ultrasonic, encoder), pid(s) data
-        STATUS_STM32, // Status of the STM32
-        BATTERY,      // Measured battery voltage
-        ACK_STM32,    // Confirm receipt from STM32
-        DEBUG,        // Debugging log
-
-        // Transmitting (Radxa -> STM32)
-        CMD_MOTOR,        // Motor control
-        CMD_NAV,          // Target speed, turn, start/stop
-        CONFIG_PID_SPEED, // Tune speed PID
-        CONFIG_PID_LANE,  // Tune laning PID
-        CONFIG_SENSOR,    // Configure sensor data rate
-        STATUS_RADXA,     // Status of the Radxa
-        ACK_RADXA,        // Confirm receipt from Radxa
-    };
-
-
-    // Max data packet size
-    constexpr size_t DATA_MAX_SIZE {256};
-
-
     /** @brief Raw data packet structure from reading UART */
     struct DataPacket_raw {
         uint8_t sync {};       // Header - 0x5A (Radxa receive) or 0xA5 (Radxa transmit)
         ePacketID id {};       // Refer to ePacketID enum class
         uint32_t timestamp {}; // millisecs since program start, big enough for ~49.7 days
+                               // Little-endian on the wire
         uint8_t length {};     // Max bits length of data: 255 bytes
         uint8_t data[DATA_MAX_SIZE]; // Data
-                                     // CRC8 at data[length]
+                                     // Checksum at data[length], see eChecksum
 
-        size_t totalSize() const { return 7 + length + 1; }
+        size_t totalSize(eChecksum checksum = eChecksum::CRC8) const
+        {
+            return PACKET_HEADER_SIZE + length + checksumSize(checksum);
+        }
     } __attribute__((packed));
 
 
-    /** @brief Data packet structure for UART communication */
+    class DataPacketView;
+
+
+    /**
+     * @brief Data packet structure for UART communication
+     *
+     * The payload is stored inline, so creating, copying or queueing a packet never
+     * allocates.
+     */
     class DataPacket {
       public:
         // Constructor, meant to be used with storing received packets. Timestamp, sync,
-        // and crc8 will be auto-generated.
+        // and crc8 will be auto-generated. A payload over 255 bytes is cut short and the
+        // packet marked truncated, see isTruncated().
         DataPacket(ePacketID id, std::span<const uint8_t> data_payload);
 
-        // Convert DataPacket to a uint8_t buffer for UART transmission
-        size_t serialize(uint8_t *buf, size_t buf_size) const;
+        // Convert DataPacket to a uint8_t buffer for UART transmission. Returns 0 if
+        // buf_size is too small. A CRC32 is computed here, the crc8 is kept up to date.
+        size_t serialize(uint8_t *buf, size_t buf_size,
+                         eWireFormat format = eWireFormat::SYNC_LENGTH,
+                         eChecksum checksum = eChecksum::CRC8) const;
+
+        // Convert UART raw data to DataPacket class only if its valid. A COBS frame
+        // may include its delimiter.
+        static std::optional<DataPacket>
+        deserialize(const uint8_t *rawData, size_t length,
+                    eWireFormat format = eWireFormat::SYNC_LENGTH,
+                    eChecksum checksum = eChecksum::CRC8);
 
-        // Convert UART raw data to DataPacket class only if its valid
-        static std::optional<DataPacket> deserialize(const uint8_t *rawData,
-                                                     size_t length);
+        // Bytes serialize() writes for the packet, without serializing it. For COBS, an
+        // upper bound that's exact for frames shorter than 254 bytes.
+        size_t wireSize(eWireFormat format = eWireFormat::SYNC_LENGTH,
+                        eChecksum checksum = eChecksum::CRC8) const noexcept;
 
         // Getter methods
         uint8_t getSync() const noexcept { return sync_; }
         ePacketID getID() const noexcept { return id_; }
         uint32_t getTimestamp() const noexcept { return timestamp_; }
-        const std::vector<uint8_t> &getData() const noexcept { return data_; }
+        std::span<const uint8_t> getData() const noexcept { return {data_.data(), length_}; }
+
+        // Payload was over 255 bytes and cut short, send::enqueue() rejects such packets
+        bool isTruncated() const noexcept { return isTruncated_; }
+
+        // Restamps the packet, e.g. with the sender's own clock. Updates the crc8.
+        void setTimestamp(uint32_t timestamp);
 
       private:
+        friend class DataPacketView;
+
         DataPacket(uint8_t sync, ePacketID id, uint32_t timestamp,
-                   std::vector<uint8_t> data_payload, uint8_t crc8);
+                   std::span<const uint8_t> data_payload, uint8_t crc8);
 
         uint8_t sync_ {};       // Header - 0x5A (Radxa receive) or 0xA5 (Radxa transmit)
         ePacketID id_ {};       // Refer to ePacketID enum class
         uint32_t timestamp_ {}; // milliseconds since mcu boot, big enough for ~49.7 days
-        std::vector<uint8_t> data_; // Data
-        uint8_t crc8_ {};           // CRC8 checksum
+        uint8_t length_ {};                           // Bytes used in data_
+        std::array<uint8_t, DATA_MAX_SIZE - 1> data_; // Data, only length_ is valid
+        uint8_t crc8_ {};                             // CRC8 checksum
+        bool isTruncated_ {false};
 
         uint8_t calculate_crc8() const;
-        bool validate_crc() const;
         static uint32_t getTimeMs();
     };
 
 
-    namespace recv {
-        /** @brief IMU data structure from the telemetry packet */
-        struct IMU_data {
-            int16_t accel_x {};
-            int16_t accel_y {};
-            int16_t accel_z {};
-            int16_t gyro_x {};
-            int16_t gyro_y {};
-            int16_t gyro_z {};
-        };
-    } // namespace recv
-
-
-    // Sync bytes
-    constexpr uint8_t SYNC_RECV {0x5A};
-    constexpr uint8_t SYNC_SEND {0xA5};
+    /** @brief Builds a packet from its typed payload, checked against the ID at compile time */
+    template <ePacketID ID>
+    DataPacket makePacket(const Payload<ID> &payload)
+    {
+        uint8_t buf[schema::wireSize<Payload<ID>>()];
+        size_t len {encodePayload<ID>(payload, buf, sizeof(buf))};
+        return DataPacket(ID, std::span<const uint8_t>(buf, len));
+    }
 
 } // namespace uart
 
@@ -0,0 +1,84 @@
+/**
+ * @file packet_view.h
+ * @brief Non-owning, validated view of a packet inside a receive buffer
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_PACKET_VIEW_H_
+#define COMM_UART_PACKET_VIEW_H_
+
+#include "comm/uart/byte_order.h"
+#include "comm/uart/packet_info.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace uart {
+    /** @brief Why DataPacketView::parse() rejected a buffer */
+    enum class eParseError : uint8_t {
+        NONE,
+        TOO_SHORT,  // Not even a header, or fewer bytes than the length field says
+        BAD_SYNC,   // First byte isn't SYNC_RECV or SYNC_SEND
+        BAD_CHECKSUM,
+    };
+
+
+    /**
+     * @class DataPacketView
+     * @brief Reads packet fields in place, without copying the payload.
+     *
+     * parse() checks sync, length and CRC directly on the wire bytes, so packets that
+     * are rejected or ignored never cost a copy. Fields are decoded from little-endian
+     * byte by byte, so the buffer needn't be aligned. The view is only valid while the
+     * underlying buffer is; call toPacket() to keep the packet.
+     */
+    class DataPacketView {
+      public:
+        /**
+         * @brief Validates a frame in place.
+         * @param frame Bytes starting at the sync byte, may extend past the frame.
+         * @param error Optional, set to the reason when std::nullopt is returned.
+         * @param checksum What the frame ends with.
+         * @return A view of the frame, or std::nullopt if it's invalid.
+         */
+        static std::optional<DataPacketView> parse(std::span<const uint8_t> frame,
+                                                   eParseError *error = nullptr,
+                                                   eChecksum checksum = eChecksum::CRC8) noexcept;
+
+        // Getter methods
+        uint8_t getSync() const noexcept { return frame_[0]; }
+        ePacketID getID() const noexcept { return static_cast<ePacketID>(frame_[1]); }
+        uint32_t getTimestamp() const noexcept { return byte_order::loadLe32(&frame_[2]); }
+        std::span<const uint8_t> getData() const noexcept
+        {
+            return frame_.subspan(PACKET_HEADER_SIZE, frame_[PACKET_HEADER_SIZE - 1]);
+        }
+        eChecksum getChecksumType() const noexcept { return checksum_; }
+
+        // Wire bytes of the whole frame, header to checksum
+        std::span<const uint8_t> getFrame() const noexcept { return frame_; }
+        size_t totalSize() const noexcept { return frame_.size(); }
+
+        // Copy into an owning packet
+        DataPacket toPacket() const noexcept;
+
+        // Same, with a different ID and payload, e.g. after stripping a sequence
+        // number. Sync and timestamp are kept, the crc8 is recomputed.
+        DataPacket toPacket(ePacketID id, std::span<const uint8_t> data) const noexcept;
+
+      private:
+        DataPacketView(std::span<const uint8_t> frame, eChecksum checksum) noexcept
+            : frame_(frame),
+              checksum_(checksum)
+        {
+        }
+
+        std::span<const uint8_t> frame_; // Exactly one frame, including the checksum
+        eChecksum checksum_;
+    };
+
+} // namespace uart
+
+#endif
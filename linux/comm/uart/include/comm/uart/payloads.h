@@ -0,0 +1,346 @@
+/**
+ * @file payloads.h
+ * @brief Typed payload for every ePacketID, with generated codecs and dispatch
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Single definition of the payload layouts for both ends of the link. Each struct's
+ * fields tuple (see schema.h) generates its packed encoder/decoder, and PayloadOf
+ * maps each ePacketID to its struct at compile time.
+ *
+ * Decoding a received packet:
+ *
+ *     uart::dispatch(packet, uart::Overloaded {
+ *         [](uart::PacketTag<uart::ePacketID::TELEMETRY>, const uart::payload::Telemetry &t) {},
+ *         [](uart::PacketTag<uart::ePacketID::BATTERY>, const uart::payload::Battery &b) {},
+ *     });
+ *
+ * IDs without a matching handler are ignored.
+ */
+
+#ifndef COMM_UART_PAYLOADS_H_
+#define COMM_UART_PAYLOADS_H_
+
+#include "comm/uart/protocol.h"
+#include "comm/uart/schema.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace uart {
+    namespace recv {
+        /** @brief IMU data structure from the telemetry packet */
+        struct IMU_data {
+            int16_t accel_x {};
+            int16_t accel_y {};
+            int16_t accel_z {};
+            int16_t gyro_x {};
+            int16_t gyro_y {};
+            int16_t gyro_z {};
+
+            static constexpr auto fields
+                = std::make_tuple(&IMU_data::accel_x, &IMU_data::accel_y, &IMU_data::accel_z,
+                                  &IMU_data::gyro_x, &IMU_data::gyro_y, &IMU_data::gyro_z);
+        };
+    } // namespace recv
+
+
+    namespace payload {
+        // Receiving (STM32 -> Radxa)
+
+        /** @brief TELEMETRY - sensor readings and PID outputs */
+        struct Telemetry {
+            recv::IMU_data imu {};      // Raw MPU-6050 counts
+            int16_t speed_left_mmps {}; // Encoder speed, mm/s
+            int16_t speed_right_mmps {};
+            uint16_t ultrasonic_mm {};
+            int16_t pid_speed_out {}; // Duty, permille
+            int16_t pid_lane_out {};  // Duty difference, permille
+
+            static constexpr auto fields
+                = std::make_tuple(&Telemetry::imu, &Telemetry::speed_left_mmps,
+                                  &Telemetry::speed_right_mmps, &Telemetry::ultrasonic_mm,
+                                  &Telemetry::pid_speed_out, &Telemetry::pid_lane_out);
+        };
+
+
+        /** @brief STATUS_STM32 */
+        struct StatusStm32 {
+            uint8_t state {};
+            uint8_t error_flags {};
+            uint16_t rx_errors {}; // UART frames the MCU rejected
+            uint32_t rx_bytes {};  // Flow control credit, see flow_control.h
+            uint16_t rx_free {};
+
+            static constexpr auto fields
+                = std::make_tuple(&StatusStm32::state, &StatusStm32::error_flags,
+                                  &StatusStm32::rx_errors, &StatusStm32::rx_bytes,
+                                  &StatusStm32::rx_free);
+        };
+
+
+        /** @brief BATTERY */
+        struct Battery {
+            uint16_t millivolts {};
+            uint8_t percent {};
+
+            static constexpr auto fields
+                = std::make_tuple(&Battery::millivolts, &Battery::percent);
+        };
+
+
+        /** @brief ACK_STM32 and ACK_RADXA - acknowledges reliable frames, see arq.h */
+        struct Ack {
+            uint8_t next_seq {};   // Every sequence number before this was received
+            uint32_t sack_mask {}; // Bit i set: next_seq + 1 + i was received too
+
+            static constexpr auto fields = std::make_tuple(&Ack::next_seq, &Ack::sack_mask);
+        };
+
+
+        /**
+         * @brief DEBUG and TELEMETRY_COMPACT - not decoded by the schema. Points into
+         *        the packet. TELEMETRY_COMPACT goes through TelemetryDecoder instead.
+         */
+        struct RawBytes {
+            const uint8_t *data {};
+            size_t length {};
+        };
+
+
+        // Transmitting (Radxa -> STM32)
+
+        /** @brief CMD_MOTOR - direct duty cycle, permille (-1000 to 1000) */
+        struct CmdMotor {
+            int16_t left_permille {};
+            int16_t right_permille {};
+
+            static constexpr auto fields
+                = std::make_tuple(&CmdMotor::left_permille, &CmdMotor::right_permille);
+        };
+
+
+        enum class eNavAction : uint8_t {
+            NONE,
+            START,
+            STOP,
+            E_STOP,
+        };
+
+        /** @brief CMD_NAV */
+        struct CmdNav {
+            uint16_t target_speed_mmps {};
+            int16_t turn_centideg {};
+            eNavAction action {};
+
+            static constexpr auto fields
+                = std::make_tuple(&CmdNav::target_speed_mmps, &CmdNav::turn_centideg,
+                                  &CmdNav::action);
+        };
+
+
+        /** @brief CONFIG_PID_SPEED and CONFIG_PID_LANE */
+        struct ConfigPid {
+            float kp {};
+            float ki {};
+            float kd {};
+            float output_limit {};
+
+            static constexpr auto fields = std::make_tuple(&ConfigPid::kp, &ConfigPid::ki,
+                                                           &ConfigPid::kd,
+                                                           &ConfigPid::output_limit);
+        };
+
+
+        /** @brief CONFIG_SENSOR */
+        struct ConfigSensor {
+            uint16_t telemetry_period_ms {};
+            uint8_t imu_enabled {};
+            uint8_t ultrasonic_enabled {};
+
+            static constexpr auto fields
+                = std::make_tuple(&ConfigSensor::telemetry_period_ms,
+                                  &ConfigSensor::imu_enabled, &ConfigSensor::ultrasonic_enabled);
+        };
+
+
+        /** @brief STATUS_RADXA */
+        struct StatusRadxa {
+            uint8_t state {};
+            uint8_t error_flags {};
+
+            static constexpr auto fields
+                = std::make_tuple(&StatusRadxa::state, &StatusRadxa::error_flags);
+        };
+
+
+        // Link management (both directions)
+
+        enum class eBaudAction : uint8_t {
+            PROPOSE, // Radxa: switch to baudrate for a trial
+            ACCEPT,  // STM32: switching after this reply
+            REJECT,  // STM32: rate unsupported or request out of order
+            COMMIT,  // Radxa: echo test passed, keep the rate. STM32 echoes it back.
+        };
+
+        /** @brief CONFIG_BAUD */
+        struct ConfigBaud {
+            uint32_t baudrate {};
+            eBaudAction action {};
+
+            static constexpr auto fields
+                = std::make_tuple(&ConfigBaud::baudrate, &ConfigBaud::action);
+        };
+
+
+        /** @brief LINK_TEST - pattern the STM32 echoes back unchanged */
+        struct LinkTest {
+            uint16_t seq {};
+            std::array<uint8_t, 62> pattern {};
+
+            static constexpr auto fields = std::make_tuple(&LinkTest::seq, &LinkTest::pattern);
+        };
+
+    } // namespace payload
+
+
+    /** @brief Maps a packet ID to its payload struct */
+    template <ePacketID ID>
+    struct PayloadOf;
+
+    // clang-format off
+    template <> struct PayloadOf<ePacketID::TELEMETRY>        { using type = payload::Telemetry; };
+    template <> struct PayloadOf<ePacketID::STATUS_STM32>     { using type = payload::StatusStm32; };
+    template <> struct PayloadOf<ePacketID::BATTERY>          { using type = payload::Battery; };
+    template <> struct PayloadOf<ePacketID::ACK_STM32>        { using type = payload::Ack; };
+    template <> struct PayloadOf<ePacketID::DEBUG>            { using type = payload::RawBytes; };
+    template <> struct PayloadOf<ePacketID::CMD_MOTOR>        { using type = payload::CmdMotor; };
+    template <> struct PayloadOf<ePacketID::CMD_NAV>          { using type = payload::CmdNav; };
+    template <> struct PayloadOf<ePacketID::CONFIG_PID_SPEED> { using type = payload::ConfigPid; };
+    template <> struct PayloadOf<ePacketID::CONFIG_PID_LANE>  { using type = payload::ConfigPid; };
+    template <> struct PayloadOf<ePacketID::CONFIG_SENSOR>    { using type = payload::ConfigSensor; };
+    template <> struct PayloadOf<ePacketID::STATUS_RADXA>     { using type = payload::StatusRadxa; };
+    template <> struct PayloadOf<ePacketID::ACK_RADXA>        { using type = payload::Ack; };
+    template <> struct PayloadOf<ePacketID::CONFIG_BAUD>      { using type = payload::ConfigBaud; };
+    template <> struct PayloadOf<ePacketID::LINK_TEST>        { using type = payload::LinkTest; };
+    template <> struct PayloadOf<ePacketID::TELEMETRY_COMPACT> { using type = payload::RawBytes; };
+    // clang-format on
+
+    template <ePacketID ID>
+    using Payload = typename PayloadOf<ID>::type;
+
+    /** @brief Passed to handlers so one handler type can tell IDs with the same payload apart */
+    template <ePacketID ID>
+    using PacketTag = std::integral_constant<ePacketID, ID>;
+
+
+    // Wire sizes are part of the protocol, changing one needs a firmware update too
+    static_assert(schema::wireSize<recv::IMU_data>() == 12);
+    static_assert(schema::wireSize<payload::Telemetry>() == 22);
+    static_assert(schema::wireSize<payload::StatusStm32>() == 10);
+    static_assert(schema::wireSize<payload::Battery>() == 3);
+    static_assert(schema::wireSize<payload::Ack>() == 5);
+    static_assert(schema::wireSize<payload::CmdMotor>() == 4);
+    static_assert(schema::wireSize<payload::CmdNav>() == 5);
+    static_assert(schema::wireSize<payload::ConfigPid>() == 16);
+    static_assert(schema::wireSize<payload::ConfigSensor>() == 4);
+    static_assert(schema::wireSize<payload::StatusRadxa>() == 2);
+    static_assert(schema::wireSize<payload::ConfigBaud>() == 5);
+    static_assert(schema::wireSize<payload::LinkTest>() == 64);
+
+
+    /**
+     * @brief Packs a payload for the given ID. The payload type is checked at compile time.
+     * @return Bytes written, or 0 if buf is too small.
+     */
+    template <ePacketID ID>
+    size_t encodePayload(const Payload<ID> &payload, uint8_t *buf, size_t bufSize) noexcept
+    {
+        static_assert(schema::wireSize<Payload<ID>>() < DATA_MAX_SIZE, "Payload too large");
+        return schema::encode(payload, buf, bufSize);
+    }
+
+
+    /** @brief Calls handlers with each struct in turn, e.g. a set of lambdas */
+    template <typename... Handlers>
+    struct Overloaded : Handlers... {
+        using Handlers::operator()...;
+    };
+
+    template <typename... Handlers>
+    Overloaded(Handlers...) -> Overloaded<Handlers...>;
+
+
+    namespace detail {
+        template <ePacketID ID, typename Handler>
+        bool decodeAndCall(Handler &handler, const uint8_t *data, size_t len) noexcept
+        {
+            using Type = Payload<ID>;
+
+            if constexpr (!std::is_invocable_v<Handler &, PacketTag<ID>, const Type &>) {
+                return false; // Handler doesn't care about this ID
+            } else if constexpr (std::is_same_v<Type, payload::RawBytes>) {
+                handler(PacketTag<ID> {}, Type {data, len});
+                return true;
+            } else {
+                Type payload {};
+                if (!schema::decode(data, len, payload)) {
+                    return false;
+                }
+                handler(PacketTag<ID> {}, payload);
+                return true;
+            }
+        }
+
+
+        template <typename Handler, size_t... Index>
+        constexpr auto makeDispatchTable(std::index_sequence<Index...>) noexcept
+        {
+            using Entry = bool (*)(Handler &, const uint8_t *, size_t) noexcept;
+            return std::array<Entry, sizeof...(Index)> {
+                &decodeAndCall<static_cast<ePacketID>(Index), Handler>...};
+        }
+
+    } // namespace detail
+
+
+    /**
+     * @brief Decodes a payload and calls the handler overload for its ID.
+     *
+     * The ID indexes a table of decoders generated at compile time, one per ID, so
+     * there is no runtime switch over the raw bytes.
+     * @return true if a handler ran, false if the ID is unknown or unhandled, or the
+     *         payload size doesn't match its schema.
+     */
+    template <typename Handler>
+    bool dispatch(ePacketID id, const uint8_t *data, size_t len, Handler &&handler) noexcept
+    {
+        using HandlerType = std::remove_reference_t<Handler>;
+        static constexpr auto table
+            = detail::makeDispatchTable<HandlerType>(std::make_index_sequence<PACKET_ID_COUNT> {});
+
+        auto index {static_cast<size_t>(id)};
+        if (index >= table.size()) {
+            return false;
+        }
+        return table[index](handler, data, len);
+    }
+
+
+    /** @brief dispatch() for anything with getID() and getData(), e.g. DataPacket */
+    template <typename Packet, typename Handler>
+    auto dispatch(const Packet &packet, Handler &&handler) noexcept
+        -> decltype(packet.getID(), packet.getData().data(), bool())
+    {
+        auto data = packet.getData();
+        return dispatch(packet.getID(), data.data(), data.size(),
+                        std::forward<Handler>(handler));
+    }
+
+} // namespace uart
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file protocol.h
+ * @brief Packet IDs and framing constants shared by the Radxa and the STM32
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * The firmware includes this header directly, along with the others listed in
+ * stm32/Firmware/comm/uart/CMakeLists.txt, so all of them are kept to C++17 without
+ * exceptions or RTTI.
+ */
+
+#ifndef COMM_UART_PROTOCOL_H_
+#define COMM_UART_PROTOCOL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace uart {
+    /** @brief List of IDs to/from the mcu */
+    enum class ePacketID : uint8_t {
+        // Receiving (STM32 -> Radxa)
+        TELEMETRY,    // Contains sensor (imu, ultrasonic, encoder), pid(s) data
+        STATUS_STM32, // Status of the STM32
+        BATTERY,      // Measured battery voltage
+        ACK_STM32,    // Confirm receipt from STM32
+        DEBUG,        // Debugging log
+
+        // Transmitting (Radxa -> STM32)
+        CMD_MOTOR,        // Motor control
+        CMD_NAV,          // Target speed, turn, start/stop
+        CONFIG_PID_SPEED, // Tune speed PID
+        CONFIG_PID_LANE,  // Tune laning PID
+        CONFIG_SENSOR,    // Configure sensor data rate
+        STATUS_RADXA,     // Status of the Radxa
+        ACK_RADXA,        // Confirm receipt from Radxa
+
+        // Link management (both directions)
+        CONFIG_BAUD, // Baud rate handshake, see baud_negotiation.h
+        LINK_TEST,   // Echoed back by the STM32 to test the link
+
+        // Receiving (STM32 -> Radxa), added after the above so their IDs stay put
+        TELEMETRY_COMPACT, // Batch of TELEMETRY samples, delta-encoded (telemetry_codec.h)
+    };
+
+    // Number of IDs above, update when adding one
+    constexpr size_t PACKET_ID_COUNT {15};
+
+
+    // Max data packet size
+    constexpr size_t DATA_MAX_SIZE {256};
+
+    // Bytes before the data: sync (1), id (1), timestamp (4), length (1)
+    constexpr size_t PACKET_HEADER_SIZE {7};
+
+
+    // Flags in the ID byte of frames sent through uart::reliable. The first payload byte
+    // of such a frame is its sequence number, see arq.h.
+    constexpr uint8_t RELIABLE_FLAG {0x80};
+    constexpr uint8_t RELIABLE_SYN_FLAG {0x40}; // Sender hasn't been acked yet, see arq.h
+    constexpr uint8_t PACKET_ID_MASK {0x3F};
+
+
+    // Sync bytes
+    constexpr uint8_t SYNC_RECV {0x5A};
+    constexpr uint8_t SYNC_SEND {0xA5};
+
+
+    /** @brief How frames are delimited on the wire, both ends must use the same one */
+    enum class eWireFormat : uint8_t {
+        SYNC_LENGTH, // Found by sync byte and length field, see DataPacket_raw
+        COBS,        // Same frame COBS-encoded and ended by 0x00, see cobs.h
+    };
+
+
+    /** @brief Checksum ending each frame, both ends must use the same one */
+    enum class eChecksum : uint8_t {
+        CRC8,  // 1 byte, OpenSAFETY
+        CRC32, // 4 bytes little-endian, as computed by the STM32's CRC unit
+    };
+
+    constexpr size_t checksumSize(eChecksum checksum) noexcept
+    {
+        return checksum == eChecksum::CRC32 ? 4 : 1;
+    }
+
+    // Longest frame before COBS: header, 255 bytes of data and a CRC32
+    constexpr size_t MAX_RAW_FRAME_SIZE {PACKET_HEADER_SIZE + 255 + 4};
+
+} // namespace uart
+
+#endif
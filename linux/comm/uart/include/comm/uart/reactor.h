@@ -0,0 +1,39 @@
+/**
+ * @file reactor.h
+ * @brief Single-threaded epoll loop driving both UART send and recv
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_REACTOR_H_
+#define COMM_UART_REACTOR_H_
+
+#include "hal/SerialUART.h"
+
+#include <memory>
+
+/**
+ * @namespace uart::reactor
+ * @brief Alternative to the dedicated send and recv threads.
+ *
+ * One thread waits in epoll on the (non-blocking) serial port and an eventfd. RX
+ * readiness is handed to recv::onReadable(), TX readiness and wakeups from
+ * send::enqueue() to send::flush(). Retransmit timers of uart::reliable set the epoll
+ * timeout. stop() signals the eventfd, so shutdown doesn't wait out the port's read
+ * timeout. Started through uart::manager::start().
+ */
+namespace uart::reactor {
+    void init(std::shared_ptr<SerialUART> uartPtr);
+    void deinit();
+
+    // Thread management
+    void start();
+    void stop();
+    bool isRunning();
+
+    // Wakes the loop to flush the send queue, safe from any thread
+    void wakeup();
+
+} // namespace uart::reactor
+
+#endif
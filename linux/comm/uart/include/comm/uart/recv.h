@@ -8,13 +8,55 @@
 #ifndef COMM_UART_RECV_H_
 #define COMM_UART_RECV_H_
 
+#include "comm/uart/bounded_queue.h"
 #include "comm/uart/packet_info.h"
 #include "hal/SerialUART.h"
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 
+/**
+ * @namespace uart::recv
+ * @brief Reads and frames packets from the STM32 and hands them to the app.
+ *
+ * Packets reach the app in one of three ways. subscribe() registers a handler for a
+ * packet ID, which runs as soon as the packet is read, on the executor it asks for.
+ * A conflated ID (setConflated()) keeps only its newest packet, for readLatest().
+ * Packets of other IDs nobody subscribed to go to a queue for dequeue(), or with
+ * setQueueEnabled(false) are dropped before they're copied out of the read buffer.
+ */
 namespace uart::recv {
-    void init(std::shared_ptr<SerialUART> uartPtr);
+    /** @brief Where a subscribed handler runs */
+    enum class eExecutor : uint8_t {
+        INLINE,  // On the I/O thread as the packet is read. Must be quick and not block.
+        POOL,    // On one of config::RX_POOL_THREADS workers, not necessarily in order
+        MAILBOX, // On whichever thread calls pollMailbox(), e.g. the control loop
+    };
+
+    using Handler        = std::function<void(const DataPacket &)>;
+    using SubscriptionId = uint32_t;
+
+    /** @brief Newest packet of a conflated ID, see readLatest() */
+    struct Latest {
+        std::optional<DataPacket> packet; // nullopt until the first
+        uint64_t generation {0};          // Packets of the ID received so far
+    };
+
+    struct DispatchStats {
+        uint64_t delivered {0};        // Packets handed to at least one subscriber
+        uint64_t dropped {0};          // Unsubscribed while the queue was disabled
+        uint64_t poolOverflows {0};    // Oldest POOL packet evicted, workers fell behind
+        uint64_t mailboxOverflows {0}; // Oldest MAILBOX packet evicted, not polled enough
+    };
+
+
+    // format and checksum must match the STM32's, see eWireFormat and eChecksum
+    void init(std::shared_ptr<SerialUART> uartPtr,
+              eWireFormat format = eWireFormat::SYNC_LENGTH,
+              eChecksum checksum = eChecksum::CRC8);
     void deinit();
 
     // Thread management
@@ -22,12 +64,66 @@ namespace uart::recv {
     void stop();
     bool isRunning();
 
+    // Reads and frames everything available on a non-blocking port. Called by
+    // uart::reactor when running in reactor mode.
+    void onReadable();
+
+    // Bytes dropped while resyncing to the next valid frame
+    uint64_t getDiscardedBytes();
+
+    // Frames that failed the CRC check
+    uint64_t getCrcErrors();
+
+    // Drops any partly received frame before framing the next read, e.g. when the
+    // baud rate changed and it was garbage. Safe to call from any thread.
+    void resync();
+
     // Queue management
     std::optional<DataPacket> dequeue();
     size_t getQueueSize();
     bool isQueueEmpty();
     void clearQueue();
 
+    // Overflow handling, the queue holds at most config::MAX_RX_QUEUE_SIZE packets
+    uint64_t getOverflowCount();
+    void setOverflowPolicy(eOverflowPolicy policy);
+
+    // Packets of IDs without a subscriber are queued for dequeue() if enabled (the
+    // default), or dropped without a copy
+    void setQueueEnabled(bool isEnabled);
+
+    /**
+     * @brief Runs handler for every packet of id from now on, in subscription order
+     *        with the ID's other handlers. Safe from any thread, including a handler.
+     * @return Id to unsubscribe() with.
+     */
+    SubscriptionId subscribe(ePacketID id, Handler handler,
+                             eExecutor executor = eExecutor::INLINE);
+
+    // A POOL or MAILBOX handler may still run for packets received before this
+    void unsubscribe(SubscriptionId subscription);
+
+    /**
+     * @brief Runs the MAILBOX handlers of packets received so far, on this thread.
+     * @param timeout How long to wait for the first packet if there are none yet.
+     * @return Handlers run.
+     */
+    size_t pollMailbox(std::chrono::microseconds timeout = std::chrono::microseconds {0});
+
+    DispatchStats getDispatchStats();
+
+    // Keeps only the newest packet of id for readLatest(), instead of queueing every
+    // one for dequeue(), e.g. TELEMETRY for a control loop. Subscribers still get all.
+    void setConflated(ePacketID id, bool isConflated);
+
+    /**
+     * @brief Newest packet of a conflated id. Wait-free, for one reader per id.
+     *
+     * Compare generation with the last one read to tell new data from a repeat, the
+     * difference is how many packets were skipped plus one.
+     */
+    Latest readLatest(ePacketID id);
+
 } // namespace uart::recv
 
 #endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+/**
+ * @file reliable.h
+ * @brief Acknowledged, retransmitted delivery on top of uart::send and uart::recv
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_RELIABLE_H_
+#define COMM_UART_RELIABLE_H_
+
+#include "comm/uart/packet_info.h"
+#include "comm/uart/packet_view.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @namespace uart::reliable
+ * @brief Opt-in reliable channel, e.g. for CONFIG_* and CMD_NAV.
+ *
+ * Packets passed to enqueue() get a sequence number (see arq.h) and stay in a window
+ * until the STM32 acknowledges them with ACK_STM32. Up to config::RELIABLE_WINDOW
+ * frames are in flight at once, so the link isn't idle while waiting for each Ack.
+ * Acks are selective: only the frames that were lost are sent again, either as soon as
+ * a frame written after them is acked (the UART keeps bytes in order, so a gap is a
+ * loss) or when the retransmit timer expires. Frames go out in their send lane, so a
+ * later one may overtake an earlier one; send reports each as it's written (see
+ * onWritten()), and only frames written before the acked one count as lost. The timer
+ * runs from when the frame leaves the wire, follows the measured round trip (RFC 6298,
+ * without sampling retransmitted frames) and doubles on each timeout. A frame still
+ * waiting in its lane isn't sent again, nor counted against its transmissions.
+ *
+ * Reliable frames from the STM32 are unwrapped by recv, deduplicated and acknowledged
+ * with ACK_RADXA. Packets sent with send::enqueue(), like TELEMETRY, are unaffected.
+ */
+namespace uart::reliable {
+    struct Stats {
+        uint64_t sent {0};          // Packets accepted by enqueue()
+        uint64_t acked {0};
+        uint64_t retransmits {0};
+        uint64_t failed {0};        // Given up after config::RELIABLE_MAX_TRANSMISSIONS
+        uint64_t received {0};      // Reliable frames delivered to recv
+        uint64_t duplicates {0};    // Reliable frames received again and dropped
+        std::chrono::microseconds srtt {0}; // Smoothed round trip, 0 before a sample
+        std::chrono::microseconds rto {0};  // Current retransmit timeout
+    };
+
+    void init();
+    void deinit();
+
+    // Retransmit timer thread, only used when send and recv run on their own threads
+    void start();
+    void stop();
+    bool isRunning();
+
+    // Sends the packet reliably. Returns false if the window and backlog are full.
+    bool enqueue(DataPacket packet);
+
+    // Frames in flight at once, at most config::RELIABLE_WINDOW. 1 is stop-and-wait.
+    void setWindowSize(size_t size);
+
+    // Called by recv for a frame with RELIABLE_FLAG. Returns the unwrapped packet
+    // unless it's a duplicate.
+    std::optional<DataPacket> onFrame(const DataPacketView &view);
+
+    // Called by recv after a read, acknowledges the frames passed to onFrame()
+    void flushAck();
+
+    // Called by recv for ACK_STM32
+    void onAck(const DataPacketView &view);
+
+    // Called by send for a frame with RELIABLE_FLAG as it's serialized for the port, in
+    // write order, with when its last byte is expected to leave the wire
+    void onWritten(const DataPacket &frame, std::chrono::steady_clock::time_point onWire);
+
+    // Retransmits timed out frames. Returns when it next needs to run. Called by the
+    // timer thread, or by uart::reactor when running in reactor mode.
+    std::chrono::steady_clock::time_point poll();
+
+    Stats getStats();
+
+} // namespace uart::reliable
+
+#endif
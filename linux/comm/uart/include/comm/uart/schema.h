@@ -0,0 +1,221 @@
+/**
+ * @file schema.h
+ * @brief Compile-time field schemas and the packed codecs generated from them
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A payload struct lists its members in order as a tuple of member pointers:
+ *
+ *     struct Battery {
+ *         uint16_t millivolts {};
+ *         uint8_t percent {};
+ *         static constexpr auto fields = std::make_tuple(&Battery::millivolts,
+ *                                                        &Battery::percent);
+ *     };
+ *
+ * encode()/decode() walk that list at compile time and read/write each field as
+ * packed little-endian bytes, independent of the struct's padding or the host byte
+ * order. Supported field types are integers, enums, float, std::array of those,
+ * and other structs with a fields tuple.
+ */
+
+#ifndef COMM_UART_SCHEMA_H_
+#define COMM_UART_SCHEMA_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace uart::schema {
+    namespace detail {
+        // Used in decltype only, to get a member's type from a member pointer
+        template <typename Class, typename Member>
+        Member memberType(Member Class::*);
+
+        template <typename T, typename = void>
+        struct hasFields : std::false_type {};
+
+        template <typename T>
+        struct hasFields<T, std::void_t<decltype(T::fields)>> : std::true_type {};
+
+        template <typename T>
+        struct isArray : std::false_type {};
+
+        template <typename T, size_t N>
+        struct isArray<std::array<T, N>> : std::true_type {};
+
+        // Unsigned integer with the same width as a scalar field
+        template <size_t Size>
+        struct UintOfSize;
+        template <>
+        struct UintOfSize<1> {
+            using type = uint8_t;
+        };
+        template <>
+        struct UintOfSize<2> {
+            using type = uint16_t;
+        };
+        template <>
+        struct UintOfSize<4> {
+            using type = uint32_t;
+        };
+        template <>
+        struct UintOfSize<8> {
+            using type = uint64_t;
+        };
+
+        template <typename T>
+        using Bits = typename UintOfSize<sizeof(T)>::type;
+
+    } // namespace detail
+
+
+    /** @brief Number of bytes T occupies on the wire */
+    template <typename T>
+    constexpr size_t wireSize() noexcept
+    {
+        if constexpr (detail::hasFields<T>::value) {
+            return std::apply(
+                [](auto... member) {
+                    return (size_t {0} + ...
+                            + wireSize<decltype(detail::memberType(member))>());
+                },
+                T::fields);
+        } else if constexpr (detail::isArray<T>::value) {
+            return std::tuple_size<T>::value * wireSize<typename T::value_type>();
+        } else {
+            static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>,
+                          "Field must be a number, enum, std::array or struct with fields");
+            return sizeof(T);
+        }
+    }
+
+
+    /** @brief Writes value at dst and advances dst past it */
+    template <typename T>
+    void encodeValue(uint8_t *&dst, const T &value) noexcept
+    {
+        if constexpr (detail::hasFields<T>::value) {
+            std::apply([&](auto... member) { (encodeValue(dst, value.*member), ...); },
+                       T::fields);
+        } else if constexpr (detail::isArray<T>::value) {
+            for (const auto &element : value) {
+                encodeValue(dst, element);
+            }
+        } else {
+            // Copy the bit pattern (handles float and enums), then store little-endian
+            detail::Bits<T> bits {};
+            std::memcpy(&bits, &value, sizeof(T));
+            for (size_t i = 0; i < sizeof(T); i++) {
+                *dst++ = static_cast<uint8_t>(bits >> (8 * i));
+            }
+        }
+    }
+
+
+    /** @brief Reads value from src and advances src past it */
+    template <typename T>
+    void decodeValue(const uint8_t *&src, T &value) noexcept
+    {
+        if constexpr (detail::hasFields<T>::value) {
+            std::apply([&](auto... member) { (decodeValue(src, value.*member), ...); },
+                       T::fields);
+        } else if constexpr (detail::isArray<T>::value) {
+            for (auto &element : value) {
+                decodeValue(src, element);
+            }
+        } else {
+            detail::Bits<T> bits {};
+            for (size_t i = 0; i < sizeof(T); i++) {
+                bits |= static_cast<detail::Bits<T>>(static_cast<detail::Bits<T>>(*src++)
+                                                     << (8 * i));
+            }
+            std::memcpy(&value, &bits, sizeof(T));
+        }
+    }
+
+
+    /**
+     * @brief Calls fn on every scalar field of value, in wire order.
+     *
+     * Lets generic code treat a payload as a flat list of numbers, e.g. to delta-encode
+     * one sample against the previous. Works on const and non-const values.
+     */
+    template <typename T, typename Fn>
+    void forEachScalar(T &value, Fn &&fn) noexcept
+    {
+        using Type = std::remove_const_t<T>;
+
+        if constexpr (detail::hasFields<Type>::value) {
+            std::apply([&](auto... member) { (forEachScalar(value.*member, fn), ...); },
+                       Type::fields);
+        } else if constexpr (detail::isArray<Type>::value) {
+            for (auto &element : value) {
+                forEachScalar(element, fn);
+            }
+        } else {
+            fn(value);
+        }
+    }
+
+
+    /** @brief Number of scalar fields forEachScalar() visits */
+    template <typename T>
+    constexpr size_t scalarCount() noexcept
+    {
+        if constexpr (detail::hasFields<T>::value) {
+            return std::apply(
+                [](auto... member) {
+                    return (size_t {0} + ...
+                            + scalarCount<decltype(detail::memberType(member))>());
+                },
+                T::fields);
+        } else if constexpr (detail::isArray<T>::value) {
+            return std::tuple_size<T>::value * scalarCount<typename T::value_type>();
+        } else {
+            return 1;
+        }
+    }
+
+
+    /**
+     * @brief Packs a payload struct into buf.
+     * @return Bytes written, or 0 if buf is too small.
+     */
+    template <typename T>
+    size_t encode(const T &payload, uint8_t *buf, size_t bufSize) noexcept
+    {
+        static_assert(detail::hasFields<T>::value, "Payload needs a fields tuple");
+        if (bufSize < wireSize<T>()) {
+            return 0;
+        }
+
+        uint8_t *cursor {buf};
+        encodeValue(cursor, payload);
+        return wireSize<T>();
+    }
+
+
+    /**
+     * @brief Unpacks a payload struct from data.
+     * @return false if len doesn't match the schema size, out is left untouched.
+     */
+    template <typename T>
+    bool decode(const uint8_t *data, size_t len, T &out) noexcept
+    {
+        static_assert(detail::hasFields<T>::value, "Payload needs a fields tuple");
+        if (len != wireSize<T>()) {
+            return false;
+        }
+
+        decodeValue(data, out);
+        return true;
+    }
+
+} // namespace uart::schema
+
+#endif
@@ -8,13 +8,65 @@
 #ifndef COMM_UART_SEND_H_
 #define COMM_UART_SEND_H_
 
+#include "comm/uart/bounded_queue.h"
 #include "comm/uart/packet_info.h"
 #include "hal/SerialUART.h"
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 
 namespace uart::send {
-    void init(std::shared_ptr<SerialUART> uartPtr);
+    /** @brief Transmit lanes, highest first. A lane only sends once the lanes above are empty. */
+    enum class ePriority : uint8_t {
+        SAFETY, // E-stop and stop commands
+        MOTION, // Setpoints and acks
+        CONFIG, // PID and sensor configuration
+        STATUS, // Everything else
+    };
+
+    constexpr size_t PRIORITY_COUNT {4};
+
+    /** @brief Latency histogram buckets, bucket i counts latencies below 2^i us */
+    constexpr size_t LATENCY_BUCKETS {24};
+
+    /** @brief Snapshot of one lane's counters */
+    struct LaneStats {
+        uint64_t sent {0};
+        uint64_t droppedStale {0};     // Past their deadline when their turn came
+        uint64_t droppedFull {0};      // Rejected by enqueue() because the lane was full
+        uint64_t droppedTruncated {0}; // Rejected by enqueue(), see DataPacket::isTruncated()
+        uint64_t latencyMaxUs {0};
+        uint64_t latencyTotalUs {0};
+
+        // Enqueue to estimated last byte on the wire
+        std::array<uint64_t, LATENCY_BUCKETS> latencyHistUs {};
+
+        /** @brief Upper bound of the bucket holding the given percentile (0-100), in us */
+        uint64_t percentileUs(double percentile) const noexcept;
+    };
+
+    /** @brief Result of flush() */
+    enum class eFlushStatus : uint8_t {
+        DONE,      // Every lane drained
+        PORT_FULL, // Port would block, retry when writable
+        PACING,    // Link budget used up, retry at getResumeTime()
+        NO_CREDIT, // STM32's receive buffer is full, retry after the next onCredit()
+    };
+
+    /** @brief Snapshot of the flow control state, see flow_control.h */
+    struct FlowStats {
+        bool isLimited {false}; // The STM32 has advertised credit
+        size_t available {0};   // Bytes that may be sent now, if isLimited
+        uint64_t stalls {0};    // Times flush() stopped for credit
+    };
+
+
+    // format and checksum must match the STM32's, see eWireFormat and eChecksum
+    void init(std::shared_ptr<SerialUART> uartPtr,
+              eWireFormat format = eWireFormat::SYNC_LENGTH,
+              eChecksum checksum = eChecksum::CRC8);
     void deinit();
 
     // Thread management
@@ -22,12 +74,48 @@ namespace uart::send {
     void stop();
     bool isRunning();
 
+    // Writes pending packets, highest lane first, until the lanes are empty, the port
+    // would block, or the link budget is used up. Called by the send thread, or by
+    // uart::reactor when running in reactor mode.
+    eFlushStatus flush();
+    std::chrono::steady_clock::time_point getResumeTime();
+
+    // Link rate used to pace writes, in bits per second. 0 disables pacing, e.g. for
+    // a pty or USB adapter that doesn't drain at the baud rate.
+    void setLinkRate(uint32_t bitsPerSec);
+    uint32_t getLinkRate();
+
+    // Flow control. Called by recv with the credit of each STATUS_STM32, see
+    // flow_control.h. Packets in the SAFETY lane are sent regardless of credit.
+    void onCredit(uint32_t rxBytes, uint16_t rxFree,
+                  std::chrono::steady_clock::time_point received);
+    FlowStats getFlowStats();
+
+    // Lane the packet goes to when enqueued without an explicit priority
+    ePriority classify(const DataPacket &packet);
+
+    // Bytes the packet takes on the wire, in the format and checksum passed to init()
+    size_t wireSize(const DataPacket &packet);
+
     // Queue management
-    void enqueue(DataPacket packet);
+    // Returns false if the packet was dropped because its lane is full, or because it's
+    // truncated (see DataPacket::isTruncated()). With a non-zero maxAge the packet is
+    // dropped instead of sent once it is that old.
+    bool enqueue(DataPacket packet);
+    bool enqueue(DataPacket packet, ePriority priority,
+                 std::chrono::milliseconds maxAge = std::chrono::milliseconds {0});
     size_t getQueueSize();
     bool isQueueEmpty();
     void clearQueue();
 
+    // Overflow handling, each lane holds at most config::MAX_TX_QUEUE_SIZE packets
+    uint64_t getOverflowCount();
+    void setOverflowPolicy(eOverflowPolicy policy);
+
+    // Per-lane statistics
+    LaneStats getLaneStats(ePriority priority);
+    void resetLaneStats();
+
 } // namespace uart::send
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,232 @@
+/**
+ * @file telemetry_codec.h
+ * @brief Delta and varint encoding of TELEMETRY samples for TELEMETRY_COMPACT
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * A TELEMETRY frame spends 30 bytes on 22 bytes of readings, most of which barely move
+ * between samples. TELEMETRY_COMPACT batches samples into one frame and sends each as
+ * the difference to the sample before it:
+ *
+ *     flags (1) | seq (1) | sample | sample | ...
+ *     sample:   timestamp varint | one zig-zag varint per Telemetry field, wire order
+ *
+ * With KEYFRAME_FLAG set, the first sample holds absolute values and the frame decodes
+ * on its own. Otherwise the first sample is relative to the last sample of frame seq - 1,
+ * so after a lost frame the receiver drops delta frames until the next keyframe. The
+ * Encoder sends one every keyframeInterval frames, capping the loss.
+ *
+ * Zig-zag maps small negative and positive deltas alike to small unsigned numbers, and
+ * LEB128 varints store those in 7 bits per byte, so a steady field costs a single byte.
+ */
+
+#ifndef COMM_UART_TELEMETRY_CODEC_H_
+#define COMM_UART_TELEMETRY_CODEC_H_
+
+#include "comm/uart/payloads.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace uart::compact {
+    constexpr uint8_t KEYFRAME_FLAG {0x01};
+
+    // Bytes before the first sample: flags, seq
+    constexpr size_t HEADER_SIZE {2};
+
+    // Largest TELEMETRY_COMPACT payload
+    constexpr size_t MAX_PAYLOAD_SIZE {255};
+
+    // Scalars per sample, see schema::forEachScalar()
+    constexpr size_t FIELD_COUNT {schema::scalarCount<payload::Telemetry>()};
+
+    // Longest a sample can get: 32-bit timestamp, then 16-bit fields whose delta needs
+    // 17 bits, i.e. 3 varint bytes
+    constexpr size_t MAX_SAMPLE_SIZE {5 + FIELD_COUNT * 3};
+    static_assert(schema::wireSize<payload::Telemetry>() == FIELD_COUNT * 2,
+                  "MAX_SAMPLE_SIZE assumes 16-bit fields");
+
+    constexpr uint8_t DEFAULT_KEYFRAME_INTERVAL {8};
+
+
+    /** @brief One TELEMETRY reading and when it was taken */
+    struct Sample {
+        uint32_t timestamp_ms {};
+        payload::Telemetry telemetry {};
+    };
+
+
+    constexpr uint32_t zigzag(int32_t value) noexcept
+    {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+
+    constexpr int32_t unzigzag(uint32_t value) noexcept
+    {
+        return static_cast<int32_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+
+    /** @brief Writes value as a LEB128 varint, advancing dst */
+    inline void writeVarint(uint8_t *&dst, uint32_t value) noexcept
+    {
+        while (value >= 0x80) {
+            *dst++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *dst++ = static_cast<uint8_t>(value);
+    }
+
+
+    /**
+     * @brief Reads a LEB128 varint of up to 5 bytes, advancing src.
+     * @return false if it runs past end or is too long.
+     */
+    inline bool readVarint(const uint8_t *&src, const uint8_t *end, uint32_t &value) noexcept
+    {
+        // One byte covers almost every field
+        if (src < end && *src < 0x80) {
+            value = *src++;
+            return true;
+        }
+
+        value = 0;
+        for (uint32_t shift = 0; shift < 35 && src < end; shift += 7) {
+            uint8_t byte {*src++};
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (byte < 0x80) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    /** @brief Sample's fields in wire order, widened for delta arithmetic */
+    inline std::array<int32_t, FIELD_COUNT> flatten(const payload::Telemetry &telemetry) noexcept
+    {
+        std::array<int32_t, FIELD_COUNT> values {};
+        size_t i {0};
+        schema::forEachScalar(telemetry, [&](const auto &field) {
+            values[i++] = static_cast<int32_t>(field);
+        });
+        return values;
+    }
+
+
+    /** @brief Inverse of flatten(), narrowing each value back to its field's type */
+    inline payload::Telemetry unflatten(const std::array<int32_t, FIELD_COUNT> &values) noexcept
+    {
+        payload::Telemetry telemetry {};
+        size_t i {0};
+        schema::forEachScalar(telemetry, [&](auto &field) {
+            field = static_cast<std::remove_reference_t<decltype(field)>>(values[i++]);
+        });
+        return telemetry;
+    }
+
+
+    /**
+     * @class Encoder
+     * @brief Builds TELEMETRY_COMPACT payloads one sample at a time.
+     *
+     * add() samples until it returns false or the batch is due, send data()/size() as a
+     * TELEMETRY_COMPACT packet, then finish() to start the next frame. No allocation.
+     */
+    class Encoder {
+      public:
+        explicit Encoder(uint8_t keyframeInterval = DEFAULT_KEYFRAME_INTERVAL) noexcept
+            : keyframeInterval_ {keyframeInterval == 0 ? uint8_t {1} : keyframeInterval}
+        {
+            begin();
+        }
+
+
+        /** @brief Appends sample, or returns false if it might not fit */
+        bool add(const Sample &sample) noexcept
+        {
+            if (size_ + MAX_SAMPLE_SIZE > MAX_PAYLOAD_SIZE) {
+                return false;
+            }
+
+            uint8_t *dst {&buf_[size_]};
+            auto values = flatten(sample.telemetry);
+
+            if (isKeyframe_ && count_ == 0) {
+                writeVarint(dst, sample.timestamp_ms);
+                for (int32_t value : values) {
+                    writeVarint(dst, zigzag(value));
+                }
+            } else {
+                writeVarint(dst, sample.timestamp_ms - prevTimestamp_);
+                for (size_t i = 0; i < FIELD_COUNT; i++) {
+                    writeVarint(dst, zigzag(values[i] - prev_[i]));
+                }
+            }
+
+            size_          = static_cast<size_t>(dst - buf_.data());
+            prevTimestamp_ = sample.timestamp_ms;
+            prev_          = values;
+            count_++;
+            return true;
+        }
+
+
+        /** @brief Ends the current frame, whether it was sent or not */
+        void finish() noexcept
+        {
+            if (count_ == 0) {
+                return;
+            }
+
+            seq_++;
+            framesSinceKeyframe_ = isKeyframe_ ? 1 : framesSinceKeyframe_ + 1;
+            begin();
+        }
+
+
+        /** @brief Makes the next frame a keyframe, e.g. when the receiver asks for one */
+        void requestKeyframe() noexcept
+        {
+            framesSinceKeyframe_ = keyframeInterval_;
+            if (count_ == 0) {
+                begin();
+            }
+        }
+
+
+        const uint8_t *data() const noexcept { return buf_.data(); }
+        size_t size() const noexcept { return size_; }
+        size_t getSampleCount() const noexcept { return count_; }
+        bool isEmpty() const noexcept { return count_ == 0; }
+
+      private:
+        void begin() noexcept
+        {
+            isKeyframe_ = framesSinceKeyframe_ >= keyframeInterval_;
+            buf_[0]     = isKeyframe_ ? KEYFRAME_FLAG : 0;
+            buf_[1]     = seq_;
+            size_       = HEADER_SIZE;
+            count_      = 0;
+        }
+
+
+        std::array<uint8_t, MAX_PAYLOAD_SIZE> buf_ {};
+        size_t size_ {0};
+        size_t count_ {0};
+
+        std::array<int32_t, FIELD_COUNT> prev_ {};
+        uint32_t prevTimestamp_ {0};
+
+        uint8_t keyframeInterval_;
+        uint8_t framesSinceKeyframe_ {0xFF}; // First frame is a keyframe
+        uint8_t seq_ {0};
+        bool isKeyframe_ {true};
+    };
+
+} // namespace uart::compact
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * @file telemetry_decoder.h
+ * @brief Rebuilds absolute TELEMETRY samples from TELEMETRY_COMPACT payloads
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_TELEMETRY_DECODER_H_
+#define COMM_UART_TELEMETRY_DECODER_H_
+
+#include "comm/uart/telemetry_codec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace uart {
+    /**
+     * @class TelemetryDecoder
+     * @brief Receiving end of compact::Encoder, see telemetry_codec.h.
+     *
+     * Keeps the last sample of the previous frame to resolve the next frame's deltas.
+     * After a gap in the frame sequence, delta frames are dropped until a keyframe
+     * arrives, as their values would be relative to a sample that was never seen.
+     */
+    class TelemetryDecoder {
+      public:
+        // Most samples a single payload can hold
+        static constexpr size_t MAX_SAMPLES {
+            (compact::MAX_PAYLOAD_SIZE - compact::HEADER_SIZE) / (1 + compact::FIELD_COUNT)};
+
+        /**
+         * @brief Decodes one TELEMETRY_COMPACT payload.
+         * @param payload DataPacketView::getData() of the frame.
+         * @param out Receives the samples, in order. MAX_SAMPLES always fit.
+         * @return Samples written, 0 if the frame was malformed or had to be dropped. out
+         *         may be overwritten either way.
+         */
+        size_t decode(std::span<const uint8_t> payload, std::span<compact::Sample> out) noexcept;
+
+        /** @brief Forgets the previous frame, e.g. after the link restarts */
+        void reset() noexcept { isSynced_ = false; }
+
+        // Frames decoded, and frames dropped for a missing reference or bad encoding
+        uint64_t getDecodedFrames() const noexcept { return decodedFrames_; }
+        uint64_t getDroppedFrames() const noexcept { return droppedFrames_; }
+
+        // Frames the sequence number shows were lost before reaching the decoder
+        uint64_t getLostFrames() const noexcept { return lostFrames_; }
+
+      private:
+        size_t dropMalformed() noexcept;
+
+        std::array<int32_t, compact::FIELD_COUNT> prev_ {};
+        uint32_t prevTimestamp_ {0};
+        uint8_t nextSeq_ {0};
+        bool isSynced_ {false};
+
+        uint64_t decodedFrames_ {0};
+        uint64_t droppedFrames_ {0};
+        uint64_t lostFrames_ {0};
+    };
+
+} // namespace uart
+
+#endif
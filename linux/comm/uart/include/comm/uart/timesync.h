@@ -0,0 +1,74 @@
+/**
+ * @file timesync.h
+ * @brief Maps STM32 packet timestamps onto the Radxa's steady_clock
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_TIMESYNC_H_
+#define COMM_UART_TIMESYNC_H_
+
+#include "comm/uart/clock_sync.h"
+#include "comm/uart/packet_view.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @namespace uart::timesync
+ * @brief Radxa side of the exchange in clock_sync.h.
+ *
+ * Once send and recv (or the reactor) are running, poll() pings the STM32 every
+ * config::TIMESYNC_PERIOD_MS and recv feeds the pongs to an Estimator. From the first
+ * pong on, toHostTime() turns a packet's timestamp into the steady_clock time the
+ * STM32 took it, e.g. to measure how old a TELEMETRY reading is when it's acted on.
+ */
+namespace uart::timesync {
+    using Clock = std::chrono::steady_clock;
+
+    void init();
+    void deinit();
+
+    // Called by recv for LINK_TEST frames, true if it's a pong
+    bool isPong(const DataPacketView &view);
+    void onPong(const DataPacketView &view, Clock::time_point received);
+
+    // Sends pings. Returns when it next needs to run.
+    // Called by recv after every read, or by uart::reactor in reactor mode.
+    Clock::time_point poll();
+
+    bool isSynced();
+
+    /**
+     * @brief steady_clock time of an STM32 packet timestamp.
+     *
+     * The STM32 stamps whole milliseconds, so this is the middle of that millisecond
+     * and up to 0.5 ms off on top of the sync error. Timestamps are unwrapped against
+     * the latest pong, within about 24 days of it.
+     * @return nullopt until the first pong.
+     */
+    std::optional<Clock::time_point> toHostTime(uint32_t mcuMs);
+
+    // Same for an STM32 time with microseconds, e.g. from SysTick
+    std::optional<Clock::time_point> toHostTime(McuTime mcuTime);
+
+    // STM32 time at a steady_clock time, as a packet timestamp
+    std::optional<uint32_t> toMcuMs(Clock::time_point time);
+
+    struct Status {
+        bool isSynced {false};
+        double driftPpm {0};         // STM32 clock rate error, positive if it runs fast
+        Clock::duration residual {}; // RMS error of the pongs in use, about the sync error
+        Clock::duration minRtt {};   // Fastest round trip in the window, less the turnaround
+        size_t pongsUsed {0};        // Pongs in the window close enough to minRtt
+        uint64_t pingsSent {0};
+        uint64_t pongsReceived {0};
+    };
+
+    Status getStatus();
+
+} // namespace uart::timesync
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file trace.h
+ * @brief Per-packet latency of each stage of the send and receive pipelines
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef COMM_UART_TRACE_H_
+#define COMM_UART_TRACE_H_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @namespace uart::trace
+ * @brief Latency histograms filled by send and recv as packets pass through.
+ *
+ * recv timestamps every packet when the read holding its first byte completes, when the
+ * read completing it returns, once the framer has checked its CRC, when it's queued and
+ * when recv::dequeue() or a subscribed handler gets it. send timestamps it at enqueue,
+ * when it's serialized into a batch and when the write of that batch completes. Each
+ * gap between stamps is an eSpan with its own Histogram.
+ *
+ * Recording is a few relaxed atomic adds per packet and never locks or allocates, so it
+ * is left on. snapshot() reads a span from any thread; dump() prints all of them and is
+ * async-signal-safe, see dumpOnSignal().
+ */
+namespace uart::trace {
+    using Clock = std::chrono::steady_clock;
+
+    enum class eSpan : uint8_t {
+        RX_ASSEMBLE, // Read with the first byte -> read with the last byte
+        RX_FRAME,    // Read with the last byte -> framer returned it, CRC checked
+        RX_ENQUEUE,  // CRC checked -> in the recv queue, or routed to its subscribers
+        RX_QUEUE,    // Then -> recv::dequeue() returned it, or a handler was called
+        RX_TOTAL,    // Read with the first byte -> recv::dequeue() or a handler
+        TX_QUEUE,    // send::enqueue() -> serialized into a batch
+        TX_WRITE,    // Serialized -> write() of its batch completed
+        TX_TOTAL,    // send::enqueue() -> write() of its batch completed
+    };
+
+    constexpr size_t SPAN_COUNT {8};
+
+
+    /**
+     * @class Histogram
+     * @brief Lock-free log-linear (HDR-style) histogram of nanosecond durations.
+     *
+     * Each power of two is split into 2^SUB_BUCKET_BITS linear buckets, so any recorded
+     * value is reported within 1/32 (about 3%) of itself from 0 ns up to MAX_NS.
+     * Concurrent record() calls are safe; readers may see a record half applied.
+     */
+    class Histogram {
+      public:
+        static constexpr unsigned SUB_BUCKET_BITS {5};
+        static constexpr unsigned MAX_BITS {40};
+        static constexpr uint64_t MAX_NS {(uint64_t {1} << MAX_BITS) - 1}; // About 18 min
+        static constexpr size_t BUCKET_COUNT {(MAX_BITS - SUB_BUCKET_BITS + 1)
+                                              << SUB_BUCKET_BITS};
+
+        void record(uint64_t ns) noexcept
+        {
+            ns = ns < MAX_NS ? ns : MAX_NS;
+            buckets_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            total_.fetch_add(ns, std::memory_order_relaxed);
+
+            uint64_t max {max_.load(std::memory_order_relaxed)};
+            while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+        }
+
+        void record(Clock::duration duration) noexcept
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            record(static_cast<uint64_t>(ns > 0 ? ns : 0));
+        }
+
+        uint64_t getCount() const noexcept { return count_.load(std::memory_order_relaxed); }
+        uint64_t getMaxNs() const noexcept { return max_.load(std::memory_order_relaxed); }
+        uint64_t getTotalNs() const noexcept { return total_.load(std::memory_order_relaxed); }
+
+        /** @brief Value at or below which percentile (0-100) of the records fall, in ns */
+        uint64_t percentileNs(double percentile) const noexcept
+        {
+            uint64_t count {getCount()};
+            if (count == 0) {
+                return 0;
+            }
+
+            auto target {static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count))};
+            uint64_t seen {0};
+            for (size_t i = 0; i < BUCKET_COUNT; i++) {
+                seen += buckets_[i].load(std::memory_order_relaxed);
+                if (seen > target) {
+                    return highestOf(i) < getMaxNs() ? highestOf(i) : getMaxNs();
+                }
+            }
+            return getMaxNs();
+        }
+
+        void reset() noexcept
+        {
+            for (auto &bucket : buckets_) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            count_.store(0, std::memory_order_relaxed);
+            total_.store(0, std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+        static constexpr size_t bucketOf(uint64_t ns) noexcept
+        {
+            unsigned msb {static_cast<unsigned>(std::bit_width(ns | 1)) - 1};
+            if (msb <= SUB_BUCKET_BITS) {
+                return static_cast<size_t>(ns); // Exact below 2^(SUB_BUCKET_BITS + 1)
+            }
+            unsigned shift {msb - SUB_BUCKET_BITS};
+            return (size_t {shift} << SUB_BUCKET_BITS) + static_cast<size_t>(ns >> shift);
+        }
+
+        /** @brief Largest value that lands in bucket index */
+        static constexpr uint64_t highestOf(size_t index) noexcept
+        {
+            if (index < (size_t {2} << SUB_BUCKET_BITS)) {
+                return index;
+            }
+            unsigned shift {static_cast<unsigned>(index >> SUB_BUCKET_BITS) - 1};
+            uint64_t base {(index & ((size_t {1} << SUB_BUCKET_BITS) - 1))
+                           + (uint64_t {1} << SUB_BUCKET_BITS)};
+            return ((base + 1) << shift) - 1;
+        }
+
+      private:
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_ {};
+        std::atomic<uint64_t> count_ {0};
+        std::atomic<uint64_t> total_ {0};
+        std::atomic<uint64_t> max_ {0};
+    };
+
+
+    /** @brief Summary of one span, see snapshot() */
+    struct Snapshot {
+        uint64_t count {0};
+        uint64_t meanNs {0};
+        uint64_t p50Ns {0};
+        uint64_t p90Ns {0};
+        uint64_t p99Ns {0};
+        uint64_t p999Ns {0};
+        uint64_t maxNs {0};
+    };
+
+
+    // Filled by send and recv. Only packets recv hands to the app and send writes are
+    // traced.
+    Histogram &get(eSpan span);
+    Snapshot snapshot(eSpan span);
+    void reset();
+
+    const char *toString(eSpan span);
+
+    // Off skips the clock reads too. On by default.
+    void setEnabled(bool isEnabled);
+    bool isEnabled();
+
+    /** @brief Writes a table of every span to fd. Async-signal-safe. */
+    void dump(int fd);
+
+    /** @brief Dumps to stderr whenever the process receives signum, e.g. SIGUSR1 */
+    void dumpOnSignal(int signum);
+
+} // namespace uart::trace
+
+#endif
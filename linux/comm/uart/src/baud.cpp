@@ -0,0 +1,301 @@
+/**
+ * @file baud.cpp
+ * @brief Raises the UART baud rate at runtime and falls back when the link degrades
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/baud.h"
+#include "comm/uart/baud_negotiation.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/send.h"
+
+#include "hal/exception/SerialException.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <optional>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    static_assert(uart::baud::LINK_TEST_COUNT <= 32, "Echoes are tracked in a 32-bit mask");
+
+    bool isInitialized_ {false};
+
+    // Shared pointer to the serial port
+    std::shared_ptr<SerialUART> uartPtr_ {nullptr};
+
+    // Shared by negotiate() on the app's thread and the recv or reactor thread
+    std::mutex mtx_;
+    std::condition_variable cv_;
+
+    std::atomic<uint32_t> rate_ {uart::config::BAUDRATE};
+    bool isNegotiating_ {false}; // ErrorMonitor is ignored while set
+
+    // Current request and its answer
+    uint32_t requestedRate_ {0};
+    std::optional<uart::payload::ConfigBaud> reply_ {};
+
+    // Current echo test, sequence numbers testSeq_ to testSeq_ + LINK_TEST_COUNT - 1
+    uint16_t testSeq_ {0};
+    uint32_t echoMask_ {0};
+    bool isEchoCorrupt_ {false};
+
+    uart::baud::ErrorMonitor monitor_;
+    Clock::time_point nextKeepalive_ {};
+    std::atomic<uint64_t> fallbacks_ {0};
+
+
+    uint32_t nowMs()
+    {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         Clock::now().time_since_epoch())
+                                         .count());
+    }
+
+
+    // Switches this end. Caller holds mtx_.
+    void applyRate(uint32_t rate)
+    {
+        uartPtr_->setBaudrate(rate);
+        rate_ = rate;
+
+        // Whatever arrived so far was at the old rate. A garbled length could
+        // otherwise hold the framer waiting for up to 255 more bytes.
+        uart::recv::resync();
+
+        // Keep pacing in step with the wire, unless it was turned off
+        if (uart::send::getLinkRate() != 0) {
+            uart::send::setLinkRate(rate);
+        }
+        monitor_.reset(nowMs());
+    }
+
+
+    // Sends a CONFIG_BAUD until it's answered. Caller holds mtx_ through lock.
+    bool request(std::unique_lock<std::mutex> &lock, uart::payload::ConfigBaud message)
+    {
+        constexpr auto TIMEOUT = std::chrono::milliseconds(uart::config::BAUD_REPLY_TIMEOUT_MS);
+        requestedRate_ = message.baudrate;
+
+        for (int attempt = 0; attempt < uart::config::BAUD_REQUEST_ATTEMPTS; attempt++) {
+            reply_.reset();
+            uart::send::enqueue(uart::makePacket<uart::ePacketID::CONFIG_BAUD>(message));
+
+            if (cv_.wait_for(lock, TIMEOUT, []() { return reply_.has_value(); })) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+
+    // Echoes LINK_TEST_COUNT frames through the peer. Caller holds mtx_ through lock.
+    bool echoTest(std::unique_lock<std::mutex> &lock)
+    {
+        // Late echoes of an earlier test don't count. Stays clear of KEEPALIVE_SEQ.
+        testSeq_       = static_cast<uint16_t>((testSeq_ + uart::baud::LINK_TEST_COUNT) & 0x7FFF);
+        echoMask_      = 0;
+        isEchoCorrupt_ = false;
+
+        for (size_t i = 0; i < uart::baud::LINK_TEST_COUNT; i++) {
+            auto seq {static_cast<uint16_t>(testSeq_ + i)};
+            uart::send::enqueue(
+                uart::makePacket<uart::ePacketID::LINK_TEST>(uart::baud::makeLinkTest(seq)));
+        }
+
+        constexpr uint32_t ALL_ECHOED {(uint64_t {1} << uart::baud::LINK_TEST_COUNT) - 1};
+        bool isDone {cv_.wait_for(lock,
+                                  std::chrono::milliseconds(uart::config::BAUD_REPLY_TIMEOUT_MS),
+                                  []() { return echoMask_ == ALL_ECHOED || isEchoCorrupt_; })};
+        return isDone && !isEchoCorrupt_;
+    }
+
+
+    // Moves both ends to rate, or leaves them where they were. Caller holds mtx_.
+    bool tryRate(std::unique_lock<std::mutex> &lock, uint32_t rate)
+    {
+        using uart::payload::eBaudAction;
+        uint32_t previous {rate_};
+
+        if (!request(lock, {rate, eBaudAction::PROPOSE})
+            || reply_->action != eBaudAction::ACCEPT) {
+            return false; // Still talking at the old rate
+        }
+
+        // The peer switches right after its ACCEPT
+        applyRate(rate);
+        cv_.wait_for(lock, std::chrono::milliseconds(uart::baud::SETTLE_MS),
+                     []() { return false; });
+
+        if (echoTest(lock) && request(lock, {rate, eBaudAction::COMMIT})
+            && reply_->action == eBaudAction::COMMIT) {
+            return true;
+        }
+
+        // Go back once the peer's trial has timed out too
+        cv_.wait_for(lock, std::chrono::milliseconds(uart::baud::TRIAL_TIMEOUT_MS),
+                     []() { return false; });
+        applyRate(previous);
+        return false;
+    }
+
+
+    // Drops back to the starting rate. Caller holds mtx_.
+    void fallback()
+    {
+        try {
+            applyRate(uart::config::BAUDRATE);
+            fallbacks_++;
+        } catch (const SerialException &e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
+    }
+
+} // namespace
+
+
+namespace uart::baud {
+    void init(std::shared_ptr<SerialUART> uartPtr)
+    {
+        assert(!isInitialized_);
+
+        // Share ownership of pointer
+        uartPtr_ = uartPtr;
+        assert(uartPtr_ != nullptr);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        rate_          = uartPtr_->getBaudrate();
+        isNegotiating_ = false;
+        reply_.reset();
+        monitor_.reset(nowMs());
+        fallbacks_ = 0;
+
+        isInitialized_ = true;
+    }
+
+
+    void deinit()
+    {
+        assert(isInitialized_);
+
+        // Releases ownership of object
+        uartPtr_.reset();
+
+        isInitialized_ = false;
+    }
+
+
+    uint32_t negotiate(std::span<const uint32_t> candidates)
+    {
+        assert(isInitialized_);
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        isNegotiating_ = true;
+
+        for (uint32_t rate : candidates) {
+            if (rate <= rate_) {
+                break; // Nothing faster left to try
+            }
+
+            try {
+                if (tryRate(lock, rate)) {
+                    break;
+                }
+            } catch (const SerialException &e) {
+                // This port can't do it, the peer reverts on its own
+                std::cerr << "Error: " << e.what() << std::endl;
+            }
+        }
+
+        isNegotiating_ = false;
+        monitor_.reset(nowMs());
+        nextKeepalive_ = Clock::now();
+        return rate_;
+    }
+
+
+    void onFrame(const DataPacketView &view)
+    {
+        assert(isInitialized_);
+        auto data = view.getData();
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (view.getID() == ePacketID::CONFIG_BAUD) {
+            payload::ConfigBaud reply {};
+            if (schema::decode(data.data(), data.size(), reply)
+                && reply.baudrate == requestedRate_) {
+                reply_ = reply;
+                cv_.notify_all();
+            }
+            return;
+        }
+
+        payload::LinkTest echo {};
+        if (!schema::decode(data.data(), data.size(), echo)) {
+            return;
+        }
+
+        auto index {static_cast<uint16_t>(echo.seq - testSeq_)};
+        if (index >= LINK_TEST_COUNT) {
+            return; // Keepalive, or left over from an earlier test
+        }
+
+        // The CRC passed, but a pattern error would still mean an unusable link
+        if (echo.pattern != makeLinkTest(echo.seq).pattern) {
+            isEchoCorrupt_ = true;
+        }
+        echoMask_ |= uint32_t {1} << index;
+        cv_.notify_all();
+    }
+
+
+    void onRxStats(size_t goodBytes, size_t badBytes)
+    {
+        assert(isInitialized_);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        bool isTripped {monitor_.update(static_cast<uint32_t>(goodBytes),
+                                        static_cast<uint32_t>(badBytes), nowMs())};
+        if (isTripped && !isNegotiating_ && rate_ != config::BAUDRATE) {
+            fallback();
+        }
+    }
+
+
+    std::chrono::steady_clock::time_point poll()
+    {
+        assert(isInitialized_);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (isNegotiating_ || rate_ == config::BAUDRATE) {
+            return Clock::time_point::max();
+        }
+
+        // Nothing valid for too long
+        if (monitor_.update(0, 0, nowMs())) {
+            fallback();
+            return Clock::time_point::max();
+        }
+
+        // Keep the STM32's monitor fed, its echo feeds ours
+        auto now = Clock::now();
+        if (now >= nextKeepalive_) {
+            send::enqueue(makePacket<ePacketID::LINK_TEST>(makeLinkTest(KEEPALIVE_SEQ)));
+            nextKeepalive_ = now + std::chrono::milliseconds(KEEPALIVE_MS);
+        }
+        return nextKeepalive_;
+    }
+
+
+    uint32_t getRate() { return rate_; }
+
+
+    uint64_t getFallbackCount() { return fallbacks_; }
+
+} // namespace uart::baud
@@ -0,0 +1,302 @@
+/**
+ * @file crc.cpp
+ * @brief Checksums used by the UART packet protocol
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/byte_order.h"
+#include "comm/uart/crc.h"
+
+#include <array>
+#include <cassert>
+#include <string.h>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+
+namespace {
+    // CRC8 Opensafety (0x2F)
+    constexpr uint8_t CRC8_TABLE[256] = {
+        0x00, 0x2F, 0x5E, 0x71, 0xBC, 0x93, 0xE2, 0xCD, 0x57, 0x78, 0x09, 0x26, 0xEB,
+        0xC4, 0xB5, 0x9A, 0xAE, 0x81, 0xF0, 0xDF, 0x12, 0x3D, 0x4C, 0x63, 0xF9, 0xD6,
+        0xA7, 0x88, 0x45, 0x6A, 0x1B, 0x34, 0x73, 0x5C, 0x2D, 0x02, 0xCF, 0xE0, 0x91,
+        0xBE, 0x24, 0x0B, 0x7A, 0x55, 0x98, 0xB7, 0xC6, 0xE9, 0xDD, 0xF2, 0x83, 0xAC,
+        0x61, 0x4E, 0x3F, 0x10, 0x8A, 0xA5, 0xD4, 0xFB, 0x36, 0x19, 0x68, 0x47, 0xE6,
+        0xC9, 0xB8, 0x97, 0x5A, 0x75, 0x04, 0x2B, 0xB1, 0x9E, 0xEF, 0xC0, 0x0D, 0x22,
+        0x53, 0x7C, 0x48, 0x67, 0x16, 0x39, 0xF4, 0xDB, 0xAA, 0x85, 0x1F, 0x30, 0x41,
+        0x6E, 0xA3, 0x8C, 0xFD, 0xD2, 0x95, 0xBA, 0xCB, 0xE4, 0x29, 0x06, 0x77, 0x58,
+        0xC2, 0xED, 0x9C, 0xB3, 0x7E, 0x51, 0x20, 0x0F, 0x3B, 0x14, 0x65, 0x4A, 0x87,
+        0xA8, 0xD9, 0xF6, 0x6C, 0x43, 0x32, 0x1D, 0xD0, 0xFF, 0x8E, 0xA1, 0xE3, 0xCC,
+        0xBD, 0x92, 0x5F, 0x70, 0x01, 0x2E, 0xB4, 0x9B, 0xEA, 0xC5, 0x08, 0x27, 0x56,
+        0x79, 0x4D, 0x62, 0x13, 0x3C, 0xF1, 0xDE, 0xAF, 0x80, 0x1A, 0x35, 0x44, 0x6B,
+        0xA6, 0x89, 0xF8, 0xD7, 0x90, 0xBF, 0xCE, 0xE1, 0x2C, 0x03, 0x72, 0x5D, 0xC7,
+        0xE8, 0x99, 0xB6, 0x7B, 0x54, 0x25, 0x0A, 0x3E, 0x11, 0x60, 0x4F, 0x82, 0xAD,
+        0xDC, 0xF3, 0x69, 0x46, 0x37, 0x18, 0xD5, 0xFA, 0x8B, 0xA4, 0x05, 0x2A, 0x5B,
+        0x74, 0xB9, 0x96, 0xE7, 0xC8, 0x52, 0x7D, 0x0C, 0x23, 0xEE, 0xC1, 0xB0, 0x9F,
+        0xAB, 0x84, 0xF5, 0xDA, 0x17, 0x38, 0x49, 0x66, 0xFC, 0xD3, 0xA2, 0x8D, 0x40,
+        0x6F, 0x1E, 0x31, 0x76, 0x59, 0x28, 0x07, 0xCA, 0xE5, 0x94, 0xBB, 0x21, 0x0E,
+        0x7F, 0x50, 0x9D, 0xB2, 0xC3, 0xEC, 0xD8, 0xF7, 0x86, 0xA9, 0x64, 0x4B, 0x3A,
+        0x15, 0x8F, 0xA0, 0xD1, 0xFE, 0x33, 0x1C, 0x6D, 0x42};
+
+
+    // CRC-32 of the STM32's CRC unit (MPEG-2 without the final XOR), see crc.h
+    constexpr uint32_t CRC32_POLY {0x04C11DB7};
+
+    using Crc32Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+    /**
+     * @brief Table n holds the CRC of each byte followed by n zero bytes, so 8 bytes can
+     *        be folded in with 8 independent lookups instead of 8 dependent ones.
+     */
+    constexpr Crc32Tables makeCrc32Tables()
+    {
+        Crc32Tables tables {};
+        for (uint32_t byte = 0; byte < 256; byte++) {
+            uint32_t crc {byte << 24};
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 0x80000000) ? (crc << 1) ^ CRC32_POLY : crc << 1;
+            }
+            tables[0][byte] = crc;
+        }
+
+        for (size_t n = 1; n < tables.size(); n++) {
+            for (size_t byte = 0; byte < 256; byte++) {
+                uint32_t previous {tables[n - 1][byte]};
+                tables[n][byte] = (previous << 8) ^ tables[0][previous >> 24];
+            }
+        }
+        return tables;
+    }
+
+    constexpr Crc32Tables CRC32_TABLES {makeCrc32Tables()};
+
+
+    // One word, fed in MSB first. Also the last word of slicing-by-8, hence the offset.
+    inline uint32_t crc32Word(uint32_t crc, uint32_t word, size_t table = 0) noexcept
+    {
+        uint32_t x {crc ^ word};
+        return CRC32_TABLES[table + 3][x >> 24] ^ CRC32_TABLES[table + 2][(x >> 16) & 0xFF]
+             ^ CRC32_TABLES[table + 1][(x >> 8) & 0xFF] ^ CRC32_TABLES[table][x & 0xFF];
+    }
+
+
+    uint32_t crc32Table(const uint8_t *data, size_t len, uint32_t crc) noexcept
+    {
+        using uart::byte_order::loadLe32;
+
+        for (; len >= 8; data += 8, len -= 8) {
+            crc = crc32Word(crc, loadLe32(data), 4) ^ crc32Word(0, loadLe32(data + 4));
+        }
+
+        if (len >= 4) {
+            crc = crc32Word(crc, loadLe32(data));
+            data += 4;
+            len -= 4;
+        }
+
+        // The STM32 can only feed whole words, the last one is padded with zeros
+        if (len > 0) {
+            uint8_t last[4] {};
+            memcpy(last, data, len);
+            crc = crc32Word(crc, loadLe32(last));
+        }
+
+        return crc;
+    }
+
+
+#if defined(__x86_64__)
+    // x^n mod P
+    constexpr uint32_t xPowMod(size_t n)
+    {
+        uint32_t rem {1};
+        for (size_t i = 0; i < n; i++) {
+            rem = (rem & 0x80000000) ? (rem << 1) ^ CRC32_POLY : rem << 1;
+        }
+        return rem;
+    }
+
+
+    /**
+     * @brief Folds the data 16 bytes at a time with carry-less multiplies.
+     *
+     * The 16 bytes are 4 words fed in first to last, so as a 128-bit polynomial the
+     * first word is the top one. Folding H * x^64 + L over the next 16 bytes gives
+     * H * (x^192 mod P) + L * (x^128 mod P), under 96 bits and congruent mod P, so
+     * what's left at the end has the same CRC as everything folded into it.
+     */
+    __attribute__((target("pclmul")))
+    uint32_t crc32Pclmul(const uint8_t *data, size_t len, uint32_t crc) noexcept
+    {
+        // Not worth the setup for a couple of folds
+        if (len < 64) {
+            return crc32Table(data, len, crc);
+        }
+
+        constexpr int REVERSE_WORDS {0x1B};
+        const __m128i constants {_mm_set_epi64x(xPowMod(192), xPowMod(128))};
+
+        auto load = [](const uint8_t *bytes) {
+            auto *vector = reinterpret_cast<const __m128i *>(bytes);
+            return _mm_shuffle_epi32(_mm_loadu_si128(vector), REVERSE_WORDS);
+        };
+
+        // Starting from crc is the same as starting from 0 with crc XORed into the
+        // first word
+        __m128i folded {_mm_xor_si128(load(data), _mm_set_epi32(static_cast<int>(crc), 0, 0, 0))};
+        data += 16;
+        len -= 16;
+
+        for (; len >= 16; data += 16, len -= 16) {
+            __m128i high {_mm_clmulepi64_si128(folded, constants, 0x11)};
+            __m128i low {_mm_clmulepi64_si128(folded, constants, 0x00)};
+            folded = _mm_xor_si128(_mm_xor_si128(high, low), load(data));
+        }
+
+        // Back into wire order to finish with the tables
+        uint8_t rest[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(rest),
+                         _mm_shuffle_epi32(folded, REVERSE_WORDS));
+        crc = crc32Table(rest, sizeof(rest), 0);
+        return crc32Table(data, len, crc);
+    }
+
+#elif defined(__aarch64__)
+    inline uint32_t reverseBits(uint32_t value) noexcept
+    {
+        uint32_t reversed;
+        asm("rbit %w0, %w1" : "=r"(reversed) : "r"(value));
+        return reversed;
+    }
+
+
+    inline uint64_t reverseBits(uint64_t value) noexcept
+    {
+        uint64_t reversed;
+        asm("rbit %0, %1" : "=r"(reversed) : "r"(value));
+        return reversed;
+    }
+
+
+    /**
+     * @brief ARMv8 CRC32 instructions.
+     *
+     * They compute the bit-reflected CRC with the same polynomial, feeding data LSB
+     * first. Reflecting the running value and each word turns that into the STM32's
+     * MSB-first CRC, at one extra instruction per 8 bytes.
+     */
+    __attribute__((target("+crc")))
+    uint32_t crc32Armv8(const uint8_t *data, size_t len, uint32_t crc) noexcept
+    {
+        using uart::byte_order::loadLe32;
+
+        uint32_t reflected {reverseBits(crc)};
+        for (; len >= 8; data += 8, len -= 8) {
+            // First word in the high half, so reflecting puts its MSB in bit 0
+            uint64_t words {(uint64_t {loadLe32(data)} << 32) | loadLe32(data + 4)};
+            reflected = __crc32d(reflected, reverseBits(words));
+        }
+
+        if (len >= 4) {
+            reflected = __crc32w(reflected, reverseBits(loadLe32(data)));
+            data += 4;
+            len -= 4;
+        }
+
+        if (len > 0) {
+            uint8_t last[4] {};
+            memcpy(last, data, len);
+            reflected = __crc32w(reflected, reverseBits(loadLe32(last)));
+        }
+
+        return reverseBits(reflected);
+    }
+#endif
+
+
+    uint32_t compute(uart::crc::eCrc32Impl impl, const uint8_t *data, size_t len,
+                     uint32_t crc) noexcept
+    {
+        switch (impl) {
+#if defined(__x86_64__)
+        case uart::crc::eCrc32Impl::PCLMUL:
+            return crc32Pclmul(data, len, crc);
+#elif defined(__aarch64__)
+        case uart::crc::eCrc32Impl::ARMV8:
+            return crc32Armv8(data, len, crc);
+#endif
+        default:
+            return crc32Table(data, len, crc);
+        }
+    }
+
+} // namespace
+
+
+namespace uart::crc {
+    uint8_t crc8(const uint8_t *data, size_t len, uint8_t crc) noexcept
+    {
+        for (size_t i = 0; i < len; i++) {
+            crc = CRC8_TABLE[crc ^ data[i]];
+        }
+
+        return crc;
+    }
+
+
+    uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc) noexcept
+    {
+        return compute(getCrc32Impl(), data, len, crc);
+    }
+
+
+    uint32_t crc32(eCrc32Impl impl, const uint8_t *data, size_t len, uint32_t crc) noexcept
+    {
+        assert(isSupported(impl));
+        return compute(impl, data, len, crc);
+    }
+
+
+    bool isSupported(eCrc32Impl impl) noexcept
+    {
+        switch (impl) {
+        case eCrc32Impl::TABLE:
+            return true;
+        case eCrc32Impl::PCLMUL:
+#if defined(__x86_64__)
+            return __builtin_cpu_supports("pclmul");
+#else
+            return false;
+#endif
+        case eCrc32Impl::ARMV8:
+#if defined(__aarch64__)
+            return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+            return false;
+#endif
+        }
+
+        return false;
+    }
+
+
+    eCrc32Impl getCrc32Impl() noexcept
+    {
+        static const eCrc32Impl impl {[] {
+            for (auto candidate : {eCrc32Impl::PCLMUL, eCrc32Impl::ARMV8}) {
+                if (isSupported(candidate)) {
+                    return candidate;
+                }
+            }
+            return eCrc32Impl::TABLE;
+        }()};
+
+        return impl;
+    }
+
+} // namespace uart::crc
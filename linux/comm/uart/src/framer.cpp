@@ -0,0 +1,207 @@
+/**
+ * @file framer.cpp
+ * @brief Reassembles DataPackets from a continuous UART byte stream
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/framer.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string.h>
+
+namespace {
+    bool isSyncByte(uint8_t byte)
+    {
+        return byte == uart::SYNC_RECV || byte == uart::SYNC_SEND;
+    }
+
+} // namespace
+
+
+namespace uart {
+    void Framer::push(const uint8_t *data, size_t len)
+    {
+        // Only the newest CAPACITY bytes can be kept
+        if (len > CAPACITY) {
+            discardedBytes_ += len - CAPACITY;
+            data += len - CAPACITY;
+            len = CAPACITY;
+        }
+
+        // Make room by dropping the oldest bytes
+        if (count_ + len > CAPACITY) {
+            discard(count_ + len - CAPACITY);
+        }
+
+        // Copy in at most two chunks (before and after the wrap point)
+        size_t tail {(head_ + count_) & (CAPACITY - 1)};
+        size_t first {std::min(len, CAPACITY - tail)};
+        memcpy(&ring_[tail], data, first);
+        memcpy(&ring_[0], data + first, len - first);
+        count_ += len;
+    }
+
+
+    std::optional<DataPacketView> Framer::next()
+    {
+        return format_ == eWireFormat::COBS ? nextCobs() : nextSyncLength();
+    }
+
+
+    void Framer::reset() noexcept
+    {
+        head_       = 0;
+        count_      = 0;
+        scanned_    = 0;
+        isDropping_ = false;
+    }
+
+
+    std::optional<DataPacketView> Framer::nextSyncLength()
+    {
+        constexpr size_t LENGTH_OFFSET {offsetof(DataPacket_raw, length)};
+
+        while (skipToSync() > 0) {
+            // Wait for the length byte
+            if (count_ <= LENGTH_OFFSET) {
+                return std::nullopt;
+            }
+
+            // Wait for the rest of the frame
+            size_t frameSize {PACKET_HEADER_SIZE + peek(LENGTH_OFFSET) + checksumSize(checksum_)};
+            if (count_ < frameSize) {
+                return std::nullopt;
+            }
+
+            // Parse straight out of the ring unless the frame wraps
+            const uint8_t *frame {&ring_[head_]};
+            if (head_ + frameSize > CAPACITY) {
+                copyOut(scratch_, frameSize);
+                frame = scratch_;
+            }
+
+            // Bytes stay untouched until the next push(), so the view outlives consume()
+            auto view = DataPacketView::parse({frame, frameSize}, nullptr, checksum_);
+            if (view.has_value()) {
+                consume(frameSize);
+                frameCount_++;
+                return view;
+            }
+
+            // Bad frame, the sync byte was probably noise. Resync from the next one.
+            crcErrors_++;
+            discard(1);
+        }
+
+        return std::nullopt;
+    }
+
+
+    std::optional<DataPacketView> Framer::nextCobs()
+    {
+        while (count_ > 0) {
+            size_t end {findDelimiter()};
+
+            if (end == count_) {
+                // No frame is this long, so these bytes are the tail of a frame whose
+                // start was lost. Drop them now and the rest at the next delimiter.
+                if (count_ >= cobs::MAX_FRAME_SIZE) {
+                    discard(count_);
+                    isDropping_ = true;
+                }
+                return std::nullopt;
+            }
+
+            // Back to back delimiters are allowed, e.g. to flush the line
+            if (end == 0 && !isDropping_) {
+                consume(1);
+                continue;
+            }
+
+            if (isDropping_ || end >= cobs::MAX_FRAME_SIZE) {
+                isDropping_ = false;
+                discard(end + 1);
+                continue;
+            }
+
+            // Decode straight out of the ring unless the frame wraps
+            const uint8_t *encoded {&ring_[head_]};
+            if (head_ + end > CAPACITY) {
+                copyOut(encoded_, end);
+                encoded = encoded_;
+            }
+
+            // The view points into scratch_, valid until the next call like a wrapped frame
+            size_t size {cobs::decode(encoded, end, scratch_, sizeof(scratch_))};
+            auto view = DataPacketView::parse({scratch_, size}, nullptr, checksum_);
+            if (view.has_value() && view->totalSize() == size) {
+                consume(end + 1);
+                frameCount_++;
+                return view;
+            }
+
+            // Corrupted somewhere in this frame, the next one starts after the delimiter
+            crcErrors_++;
+            discard(end + 1);
+        }
+
+        return std::nullopt;
+    }
+
+
+    void Framer::consume(size_t n) noexcept
+    {
+        head_ = (head_ + n) & (CAPACITY - 1);
+        count_ -= n;
+        scanned_ = scanned_ > n ? scanned_ - n : 0;
+    }
+
+
+    void Framer::discard(size_t n) noexcept
+    {
+        consume(n);
+        discardedBytes_ += n;
+    }
+
+
+    size_t Framer::skipToSync() noexcept
+    {
+        size_t skipped {0};
+        while (skipped < count_ && !isSyncByte(peek(skipped))) {
+            skipped++;
+        }
+
+        discard(skipped);
+        return count_;
+    }
+
+
+    size_t Framer::findDelimiter() noexcept
+    {
+        // memchr scans a word or vector at a time, in at most two runs (before and
+        // after the wrap point). Bytes scanned by an earlier call aren't looked at again.
+        while (scanned_ < count_) {
+            size_t start {(head_ + scanned_) & (CAPACITY - 1)};
+            size_t run {std::min(count_ - scanned_, CAPACITY - start)};
+
+            auto *found = static_cast<const uint8_t *>(memchr(&ring_[start], cobs::DELIMITER, run));
+            if (found != nullptr) {
+                return scanned_ + static_cast<size_t>(found - &ring_[start]);
+            }
+            scanned_ += run;
+        }
+
+        return count_;
+    }
+
+
+    void Framer::copyOut(uint8_t *dst, size_t n) const noexcept
+    {
+        size_t first {std::min(n, CAPACITY - head_)};
+        memcpy(dst, &ring_[head_], first);
+        memcpy(dst + first, &ring_[0], n - first);
+    }
+
+} // namespace uart
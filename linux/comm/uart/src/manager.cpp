@@ -5,10 +5,14 @@
  * @date Oct-17-2025
  */
 
+#include "comm/uart/baud.h"
 #include "comm/uart/config.h"
 #include "comm/uart/manager.h"
+#include "comm/uart/reactor.h"
 #include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
 #include "comm/uart/send.h"
+#include "comm/uart/timesync.h"
 
 #include "hal/SerialUART.h"
 
@@ -21,26 +25,32 @@
 
 namespace {
     bool isInitialized_ {false};
+    uart::manager::eIoMode ioMode_ {uart::manager::eIoMode::THREADED};
 
     // Shared pointer for recv and send modules to access
-    auto uartPtr_ = std::make_shared<SerialUART>(
-        uart::config::UART_DEVICE, uart::config::BAUDRATE, uart::config::TIMEOUT_SEC);
+    std::shared_ptr<SerialUART> uartPtr_ {nullptr};
 
 } // namespace
 
 
 namespace uart::manager {
-    void init()
+    void init(const std::string &device)
     {
         assert(!isInitialized_);
 
         // Initialize & open UART
         try {
-            assert(uartPtr_ != nullptr);
+            uartPtr_ = std::make_shared<SerialUART>(device, config::BAUDRATE,
+                                                    config::TIMEOUT_SEC);
+            uartPtr_->setHardwareFlowControl(config::HW_FLOW_CONTROL);
             uartPtr_->openPort();
 
-            send::init(uartPtr_);
-            recv::init(uartPtr_);
+            send::init(uartPtr_, config::WIRE_FORMAT, config::CHECKSUM);
+            recv::init(uartPtr_, config::WIRE_FORMAT, config::CHECKSUM);
+            reliable::init();
+            baud::init(uartPtr_);
+            timesync::init();
+            reactor::init(uartPtr_);
             isInitialized_ = true;
 
         } catch (const std::exception &e) {
@@ -58,6 +68,11 @@ namespace uart::manager {
 
             send::deinit();
             recv::deinit();
+            reliable::deinit();
+            baud::deinit();
+            timesync::deinit();
+            reactor::deinit();
+            uartPtr_.reset();
             isInitialized_ = false;
 
         } catch (const std::exception &e) {
@@ -66,17 +81,32 @@ namespace uart::manager {
     }
 
 
-    void start()
+    void start(eIoMode mode)
     {
         assert(isInitialized_);
+        ioMode_ = mode;
+
+        if (ioMode_ == eIoMode::REACTOR) {
+            reactor::start();
+            return;
+        }
+
         recv::start();
         send::start();
+        reliable::start();
     }
 
 
     void stop()
     {
         assert(isInitialized_);
+
+        if (ioMode_ == eIoMode::REACTOR) {
+            reactor::stop();
+            return;
+        }
+
+        reliable::stop();
         recv::stop();
         send::stop();
     }
@@ -85,6 +115,12 @@ namespace uart::manager {
     eRunStatus isRunning()
     {
         assert(isInitialized_);
+
+        // Reactor runs both directions on one thread
+        if (ioMode_ == eIoMode::REACTOR) {
+            return reactor::isRunning() ? eRunStatus::RUNNING : eRunStatus::BOTH_STOPPED;
+        }
+
         bool recvStatus {recv::isRunning()};
         bool sendStatus {send::isRunning()};
 
@@ -0,0 +1,73 @@
+/**
+ * @file packet_view.cpp
+ * @brief Non-owning, validated view of a packet inside a receive buffer
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/packet_view.h"
+#include "comm/uart/crc.h"
+
+namespace uart {
+    std::optional<DataPacketView> DataPacketView::parse(std::span<const uint8_t> frame,
+                                                        eParseError *error,
+                                                        eChecksum checksum) noexcept
+    {
+        eParseError ignored {};
+        eParseError &result {error ? *error : ignored};
+        size_t checksum_size {checksumSize(checksum)};
+
+        if (frame.size() < PACKET_HEADER_SIZE + checksum_size) {
+            result = eParseError::TOO_SHORT;
+            return std::nullopt;
+        }
+
+        // Validate sync byte
+        if (frame[0] != SYNC_RECV && frame[0] != SYNC_SEND) {
+            result = eParseError::BAD_SYNC;
+            return std::nullopt;
+        }
+
+        // Check raw packet length
+        size_t covered {PACKET_HEADER_SIZE + frame[PACKET_HEADER_SIZE - 1]};
+        if (frame.size() < covered + checksum_size) {
+            result = eParseError::TOO_SHORT;
+            return std::nullopt;
+        }
+
+        // CRC covers everything before the checksum, as laid out on the wire
+        bool isValid {};
+        if (checksum == eChecksum::CRC32) {
+            isValid = crc::crc32(frame.data(), covered) == byte_order::loadLe32(&frame[covered]);
+        } else {
+            isValid = crc::crc8(frame.data(), covered) == frame[covered];
+        }
+        if (!isValid) {
+            result = eParseError::BAD_CHECKSUM;
+            return std::nullopt;
+        }
+
+        result = eParseError::NONE;
+        return DataPacketView(frame.first(covered + checksum_size), checksum);
+    }
+
+
+    DataPacket DataPacketView::toPacket() const noexcept
+    {
+        // The crc8 comes for free with a CRC8 frame, otherwise it's computed for the copy
+        if (checksum_ == eChecksum::CRC8) {
+            return DataPacket(getSync(), getID(), getTimestamp(), getData(), frame_.back());
+        }
+        return toPacket(getID(), getData());
+    }
+
+
+    DataPacket DataPacketView::toPacket(ePacketID id,
+                                        std::span<const uint8_t> data) const noexcept
+    {
+        DataPacket packet(getSync(), id, getTimestamp(), data, 0);
+        packet.crc8_ = packet.calculate_crc8();
+        return packet;
+    }
+
+} // namespace uart
@@ -0,0 +1,214 @@
+/**
+ * @file reactor.cpp
+ * @brief Single-threaded epoll loop driving both UART send and recv
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/baud.h"
+#include "comm/uart/reactor.h"
+#include "comm/uart/recv.h"
+#include "comm/uart/reliable.h"
+#include "comm/uart/send.h"
+#include "comm/uart/timesync.h"
+
+#include "hal/exception/SerialException.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace {
+    bool isInitialized_ {false};
+
+    // Shared pointer to the serial port
+    std::shared_ptr<SerialUART> uartPtr_ {nullptr};
+
+    int epollFd_ {-1};
+    int eventFd_ {-1};
+
+    // Threading
+    std::atomic_bool isThreadRunning_ {false};
+    std::atomic_bool isWakePending_ {false}; // Coalesces wakeups into one eventfd write
+    std::thread thread_;
+
+    // Whether the port is registered for EPOLLOUT
+    bool isWatchingTx_ {false};
+
+
+    void watchTx(bool enable)
+    {
+        if (enable == isWatchingTx_) {
+            return;
+        }
+
+        epoll_event event {};
+        event.events  = enable ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        event.data.fd = uartPtr_->getFd();
+        epoll_ctl(epollFd_, EPOLL_CTL_MOD, uartPtr_->getFd(), &event);
+        isWatchingTx_ = enable;
+    }
+
+
+    void thread_loop()
+    {
+        constexpr int MAX_EVENTS {4};
+        epoll_event events[MAX_EVENTS];
+
+        // Set while send::flush() is waiting out the link's pacing delay
+        bool isPacing {false};
+
+        while (isThreadRunning_) {
+            // Sleep until the next retransmit, keepalive, ping or end of pacing
+            auto wakeAt = std::min(
+                {uart::reliable::poll(), uart::baud::poll(), uart::timesync::poll()});
+            if (isPacing) {
+                wakeAt = std::min(wakeAt, uart::send::getResumeTime());
+            }
+
+            int timeoutMs {-1};
+            if (wakeAt != std::chrono::steady_clock::time_point::max()) {
+                auto wait = std::chrono::ceil<std::chrono::milliseconds>(
+                    wakeAt - std::chrono::steady_clock::now());
+                timeoutMs = static_cast<int>(std::max<int64_t>(wait.count(), 0));
+            }
+
+            int count = epoll_wait(epollFd_, events, MAX_EVENTS, timeoutMs);
+            if (count < 0) {
+                continue; // EINTR
+            }
+
+            bool canWrite {isPacing
+                           && std::chrono::steady_clock::now() >= uart::send::getResumeTime()};
+            for (int i = 0; i < count; i++) {
+                if (events[i].data.fd == eventFd_) {
+                    // Wakeup from send::enqueue() or stop()
+                    uint64_t value {};
+                    read(eventFd_, &value, sizeof(value));
+                    isWakePending_ = false;
+                    canWrite       = true;
+                    continue;
+                }
+
+                if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                    uart::recv::onReadable();
+                }
+
+                if (events[i].events & EPOLLOUT) {
+                    canWrite = true;
+                }
+            }
+
+            // Only ask for EPOLLOUT while a write is stuck on a full port
+            if (canWrite && isThreadRunning_) {
+                auto status = uart::send::flush();
+                watchTx(status == uart::send::eFlushStatus::PORT_FULL);
+                isPacing = status == uart::send::eFlushStatus::PACING;
+            }
+        }
+    }
+
+} // namespace
+
+
+namespace uart::reactor {
+    void init(std::shared_ptr<SerialUART> uartPtr)
+    {
+        assert(!isInitialized_);
+
+        // Share ownership of pointer
+        uartPtr_ = uartPtr;
+        assert(uartPtr_ != nullptr);
+
+        epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+        eventFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epollFd_ == -1 || eventFd_ == -1) {
+            throw SerialException("Failed to create reactor: "
+                                  + std::string(strerror(errno)));
+        }
+
+        epoll_event event {};
+        event.events  = EPOLLIN;
+        event.data.fd = eventFd_;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, eventFd_, &event);
+
+        isInitialized_ = true;
+    }
+
+
+    void deinit()
+    {
+        assert(isInitialized_);
+
+        close(eventFd_);
+        close(epollFd_);
+        eventFd_ = -1;
+        epollFd_ = -1;
+
+        // Releases ownership of object
+        uartPtr_.reset();
+
+        isInitialized_ = false;
+    }
+
+
+    void start()
+    {
+        assert(isInitialized_);
+
+        // Port must be open by now, register it for reads
+        uartPtr_->setNonBlocking(true);
+        epoll_event event {};
+        event.events  = EPOLLIN;
+        event.data.fd = uartPtr_->getFd();
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, uartPtr_->getFd(), &event) == -1) {
+            throw SerialException("Failed to watch UART port: "
+                                  + std::string(strerror(errno)));
+        }
+        isWatchingTx_ = false;
+
+        isThreadRunning_ = true;
+        thread_          = std::thread(thread_loop);
+
+        // Flush anything enqueued before the loop started
+        wakeup();
+    }
+
+
+    void stop()
+    {
+        assert(isInitialized_);
+        isThreadRunning_ = false;
+
+        // Unblock epoll_wait() straight away
+        uint64_t value {1};
+        write(eventFd_, &value, sizeof(value));
+        thread_.join();
+
+        epoll_ctl(epollFd_, EPOLL_CTL_DEL, uartPtr_->getFd(), nullptr);
+        uartPtr_->setNonBlocking(false);
+    }
+
+
+    bool isRunning() { return isThreadRunning_; }
+
+
+    void wakeup()
+    {
+        if (isWakePending_.exchange(true)) {
+            return; // Loop hasn't consumed the previous wakeup yet
+        }
+
+        uint64_t value {1};
+        write(eventFd_, &value, sizeof(value));
+    }
+
+} // namespace uart::reactor
@@ -5,15 +5,28 @@
  * @date Oct-30-2025
  */
 
+#include "comm/uart/baud.h"
+#include "comm/uart/bounded_queue.h"
 #include "comm/uart/config.h"
+#include "comm/uart/framer.h"
+#include "comm/uart/latest_value.h"
+#include "comm/uart/payloads.h"
 #include "comm/uart/recv.h"
-
+#include "comm/uart/reliable.h"
+#include "comm/uart/schema.h"
+#include "comm/uart/send.h"
+#include "comm/uart/timesync.h"
+#include "comm/uart/trace.h"
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <condition_variable>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace {
     bool isInitialized_ {false};
@@ -21,24 +34,289 @@ namespace {
     // Shared pointer to the serial port
     std::shared_ptr<SerialUART> uartPtr_ {nullptr};
 
-    // Queue for storing messages
-    std::queue<uart::DataPacket> queue_;
+    using Clock = uart::trace::Clock;
+
+    struct RxItem {
+        uart::DataPacket packet;
+        Clock::time_point firstRead; // Read that delivered its first byte, for uart::trace
+        Clock::time_point enqueued;
+    };
+
+    // Queue for storing messages. Keep the freshest packets if the app falls behind.
+    uart::BoundedQueue<RxItem, uart::config::MAX_RX_QUEUE_SIZE> queue_ {
+        uart::eOverflowPolicy::DROP_OLDEST};
+
+    // Reassembles packets split across, or coalesced within, reads
+    uart::Framer framer_;
+    std::atomic<uint64_t> discardedBytes_ {0}; // Published copies of framer_ stats
+    std::atomic<uint64_t> crcErrors_ {0};
+    std::atomic_bool isResyncPending_ {false};
+    Clock::time_point partialSince_ {}; // Read that started the bytes left in framer_
 
     // Threading
     std::atomic_bool isThreadRunning_ {false};
     std::thread thread_;
-    std::mutex queue_mtx_;
 
+    // Subscribers by packet ID. Replaced whole on every change, so the I/O thread reads
+    // them without a lock, and a handler lives on while packets for it are queued.
+    struct Subscriber {
+        uart::recv::SubscriptionId id;
+        uart::recv::eExecutor executor;
+        uart::recv::Handler handler;
+    };
+    using SubscriberTable = std::array<std::vector<std::shared_ptr<const Subscriber>>, 256>;
+
+    std::mutex subscribeMtx_; // Serializes changes
+    std::atomic<std::shared_ptr<const SubscriberTable>> subscribers_ {};
+    uart::recv::SubscriptionId nextSubscription_ {1};
+    std::atomic_bool isQueueEnabled_ {true};
+    std::atomic<uint64_t> delivered_ {0};
+    std::atomic<uint64_t> dropped_ {0};
+
+    // Packet waiting for a POOL or MAILBOX handler
+    struct Job {
+        std::shared_ptr<const Subscriber> subscriber;
+        uart::DataPacket packet;
+        Clock::time_point firstRead; // As in RxItem
+        Clock::time_point enqueued;
+    };
+
+    // Jobs and the threads waiting for them. push() only takes the mutex when one is.
+    template <size_t Capacity>
+    struct JobQueue {
+        uart::BoundedQueue<Job, Capacity> jobs {uart::eOverflowPolicy::DROP_OLDEST};
+        std::mutex mtx;
+        std::condition_variable cv;
+        std::atomic<int> waiting {0};
+
+        void push(Job &&job)
+        {
+            jobs.push(std::move(job));
+
+            // Pairs with the fence in wait() so a push is never missed
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(mtx);
+                cv.notify_one();
+            }
+        }
+
+        // Until there's a job, isDone() or deadline
+        template <typename Predicate>
+        void wait(Clock::time_point deadline, Predicate isDone)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            waiting.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            cv.wait_until(lock, deadline, [this, &isDone]() { return !jobs.empty() || isDone(); });
+            waiting.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+
+    JobQueue<uart::config::RX_POOL_QUEUE_SIZE> pool_ {};
+    JobQueue<uart::config::RX_MAILBOX_SIZE> mailbox_ {};
+
+    // Newest packet of each conflated ID, written by the I/O thread
+    std::array<uart::LatestValue<std::optional<uart::DataPacket>>, uart::PACKET_ID_COUNT>
+        latest_ {};
+    std::array<std::atomic_bool, uart::PACKET_ID_COUNT> isConflated_ {};
+
+    // POOL workers, started by the first POOL subscription
+    std::atomic_bool isPoolRunning_ {false};
+    std::vector<std::thread> poolThreads_ {};
+
+
+    // Traces a packet that was just framed, returns when it was handed on. With tracing
+    // on, validated is when the framer returned it and firstRead and lastRead are the
+    // reads that delivered its first and last byte, otherwise it's a default time_point.
+    Clock::time_point traceReceived(Clock::time_point firstRead, Clock::time_point lastRead,
+                                    Clock::time_point validated)
+    {
+        if (validated == Clock::time_point {}) {
+            return {};
+        }
+
+        auto enqueued = Clock::now();
+        uart::trace::get(uart::trace::eSpan::RX_ASSEMBLE).record(lastRead - firstRead);
+        uart::trace::get(uart::trace::eSpan::RX_FRAME).record(validated - lastRead);
+        uart::trace::get(uart::trace::eSpan::RX_ENQUEUE).record(enqueued - validated);
+        return enqueued;
+    }
+
+
+    // Traces a packet reaching the app, from dequeue() or a handler
+    void traceDelivered(Clock::time_point firstRead, Clock::time_point enqueued)
+    {
+        if (enqueued != Clock::time_point {}) {
+            auto now = Clock::now();
+            uart::trace::get(uart::trace::eSpan::RX_QUEUE).record(now - enqueued);
+            uart::trace::get(uart::trace::eSpan::RX_TOTAL).record(now - firstRead);
+        }
+    }
+
+
+    void runJob(const Job &job)
+    {
+        traceDelivered(job.firstRead, job.enqueued);
+        job.subscriber->handler(job.packet);
+    }
+
+
+    void pool_loop()
+    {
+        while (isPoolRunning_) {
+            if (auto job = pool_.jobs.pop()) {
+                runJob(*job);
+                continue;
+            }
+            pool_.wait(Clock::time_point::max(), []() { return !isPoolRunning_; });
+        }
+    }
 
-    void parseNQueue(uint8_t *data, size_t len)
+
+    void stopPool()
     {
-        // TODO: Determine if this is correct in case where the stream is
-        // continuous? Might need to do a robust implementation if so...
-        auto packet = uart::DataPacket::deserialize(data, len);
-        if (packet.has_value()) {
-            std::lock_guard<std::mutex> lock(queue_mtx_);
-            queue_.push(packet.value());
+        isPoolRunning_ = false;
+        {
+            std::lock_guard<std::mutex> lock(pool_.mtx);
+            pool_.cv.notify_all();
+        }
+        for (auto &thread : poolThreads_) {
+            thread.join();
         }
+        poolThreads_.clear();
+        pool_.jobs.clear();
+    }
+
+
+    bool isConflated(uart::ePacketID id)
+    {
+        auto index {static_cast<size_t>(id)};
+        return index < uart::PACKET_ID_COUNT
+            && isConflated_[index].load(std::memory_order_relaxed);
+    }
+
+
+    /**
+     * Hands a packet to the subscribers of its ID and its latest-value slot if it's
+     * conflated, or else the queue. makePacket() is only called if someone takes the
+     * packet, so unwanted frames are never copied. Times are as in traceReceived().
+     */
+    template <typename MakePacket>
+    void route(const SubscriberTable &table, uart::ePacketID id, MakePacket &&makePacket,
+               Clock::time_point firstRead, Clock::time_point lastRead,
+               Clock::time_point validated)
+    {
+        const auto &subscribers = table[static_cast<uint8_t>(id)];
+        bool isLatestOnly {isConflated(id)};
+        if (subscribers.empty() && !isLatestOnly) {
+            if (!isQueueEnabled_.load(std::memory_order_relaxed)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            auto enqueued = traceReceived(firstRead, lastRead, validated);
+            queue_.push({makePacket(), firstRead, enqueued});
+            return;
+        }
+
+        uart::DataPacket packet {makePacket()};
+        if (isLatestOnly) {
+            latest_[static_cast<size_t>(id)].write(packet);
+            if (subscribers.empty()) {
+                return;
+            }
+        }
+
+        auto enqueued = traceReceived(firstRead, lastRead, validated);
+        delivered_.fetch_add(1, std::memory_order_relaxed);
+
+        for (const auto &subscriber : subscribers) {
+            switch (subscriber->executor) {
+            case uart::recv::eExecutor::INLINE:
+                traceDelivered(firstRead, enqueued);
+                subscriber->handler(packet);
+                break;
+            case uart::recv::eExecutor::POOL:
+                pool_.push({subscriber, packet, firstRead, enqueued});
+                break;
+            case uart::recv::eExecutor::MAILBOX:
+                mailbox_.push({subscriber, packet, firstRead, enqueued});
+                break;
+            }
+        }
+    }
+
+
+    // Hands the credit a STATUS_STM32 carries to send, see flow_control.h
+    void onStatus(const uart::DataPacketView &view, Clock::time_point readTime)
+    {
+        auto data = view.getData();
+
+        uart::payload::StatusStm32 status {};
+        if (uart::schema::decode(data.data(), data.size(), status)) {
+            uart::send::onCredit(status.rx_bytes, status.rx_free, readTime);
+        }
+    }
+
+
+    // readTime is when the read returning data completed
+    void parseNQueue(uint8_t *data, size_t len, Clock::time_point readTime)
+    {
+        if (isResyncPending_.exchange(false)) {
+            framer_.reset();
+        }
+
+        // One snapshot for the whole read, loading it is an atomic refcount
+        auto subscribers = subscribers_.load();
+
+        // The first frame out may have started in an earlier read
+        bool isTraced {uart::trace::isEnabled()};
+        Clock::time_point firstRead {framer_.getBufferedBytes() > 0 ? partialSince_ : readTime};
+
+        uint64_t discardedBefore {framer_.getDiscardedBytes()};
+        size_t goodBytes {0};
+        framer_.push(data, len);
+
+        // A single read can complete any number of packets
+        while (auto view = framer_.next()) {
+            auto validated = isTraced ? Clock::now() : Clock::time_point {};
+            goodBytes += view->totalSize();
+
+            if (static_cast<uint8_t>(view->getID()) & uart::RELIABLE_FLAG) {
+                if (auto packet = uart::reliable::onFrame(*view)) {
+                    route(*subscribers, packet->getID(), [&packet]() { return std::move(*packet); },
+                          firstRead, readTime, validated);
+                }
+            } else if (view->getID() == uart::ePacketID::ACK_STM32) {
+                uart::reliable::onAck(*view);
+            } else if (view->getID() == uart::ePacketID::LINK_TEST
+                       && uart::timesync::isPong(*view)) {
+                uart::timesync::onPong(*view, readTime);
+            } else if (view->getID() == uart::ePacketID::CONFIG_BAUD
+                       || view->getID() == uart::ePacketID::LINK_TEST) {
+                uart::baud::onFrame(*view);
+            } else {
+                if (view->getID() == uart::ePacketID::STATUS_STM32) {
+                    onStatus(*view, readTime);
+                }
+                route(*subscribers, view->getID(), [&view]() { return view->toPacket(); },
+                      firstRead, readTime, validated);
+            }
+
+            // Later frames started within this read
+            firstRead = readTime;
+        }
+        partialSince_ = firstRead;
+
+        // One Ack for every reliable frame in this read
+        uart::reliable::flushAck();
+
+        // Lets the link fall back to a slower rate if too much is garbage
+        uart::baud::onRxStats(goodBytes, framer_.getDiscardedBytes() - discardedBefore);
+
+        discardedBytes_.store(framer_.getDiscardedBytes(), std::memory_order_relaxed);
+        crcErrors_.store(framer_.getCrcErrors(), std::memory_order_relaxed);
     }
 
 
@@ -53,8 +331,14 @@ namespace {
             size_t bytesRead = uartPtr_->readData(buffer, sizeof(buffer));
 
             if (bytesRead > 0) {
-                parseNQueue(buffer, bytesRead);
+                parseNQueue(buffer, bytesRead, Clock::now());
+            } else {
+                uart::baud::onRxStats(0, 0); // Timed out, the link may have gone silent
             }
+
+            // Reads time out after config::TIMEOUT_SEC, often enough for keepalives
+            uart::baud::poll();
+            uart::timesync::poll();
         }
     }
 
@@ -62,13 +346,19 @@ namespace {
 
 
 namespace uart::recv {
-    void init(std::shared_ptr<SerialUART> uartPtr)
+    void init(std::shared_ptr<SerialUART> uartPtr, eWireFormat format, eChecksum checksum)
     {
         assert(!isInitialized_);
 
         // Share ownership of pointer
         uartPtr_ = uartPtr;
         assert(uartPtr_ != nullptr);
+        framer_.setFormat(format, checksum);
+        subscribers_.store(std::make_shared<const SubscriberTable>());
+        isQueueEnabled_ = true;
+        for (auto &isConflated : isConflated_) {
+            isConflated = false;
+        }
 
         isInitialized_ = true;
     }
@@ -81,6 +371,12 @@ namespace uart::recv {
         // Releases ownership of object
         uartPtr_.reset();
 
+        if (isPoolRunning_) {
+            stopPool();
+        }
+        mailbox_.jobs.clear();
+        subscribers_.store(nullptr);
+
         isInitialized_ = false;
     }
 
@@ -88,6 +384,7 @@ namespace uart::recv {
     void start()
     {
         assert(isInitialized_);
+        framer_.reset();
         isThreadRunning_ = true;
         thread_          = std::thread(thread_loop);
     }
@@ -108,25 +405,60 @@ namespace uart::recv {
     }
 
 
+    void onReadable()
+    {
+        assert(isInitialized_);
+
+        // Drain the port, a short read means the kernel buffer is empty
+        for (int i = 0; i < config::MAX_READS_PER_EVENT; i++) {
+            uint8_t buffer[config::READ_BUF_SIZE];
+            ssize_t bytesRead = uartPtr_->readData(buffer, sizeof(buffer));
+
+            if (bytesRead > 0) {
+                parseNQueue(buffer, static_cast<size_t>(bytesRead), Clock::now());
+            }
+
+            if (bytesRead < static_cast<ssize_t>(sizeof(buffer))) {
+                break;
+            }
+        }
+    }
+
+
     std::optional<DataPacket> dequeue()
     {
         assert(isInitialized_);
 
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        if (queue_.empty()) {
-            return std::nullopt; // no packets
+        auto item = queue_.pop();
+        if (!item.has_value()) {
+            return std::nullopt;
         }
 
-        DataPacket packet = std::move(queue_.front());
-        queue_.pop();
-        return packet;
+        traceDelivered(item->firstRead, item->enqueued);
+        return std::move(item->packet);
+    }
+
+
+    uint64_t getDiscardedBytes()
+    {
+        assert(isInitialized_);
+        return discardedBytes_;
+    }
+
+
+    uint64_t getCrcErrors()
+    {
+        assert(isInitialized_);
+        return crcErrors_;
     }
 
 
+    void resync() { isResyncPending_ = true; }
+
+
     size_t getQueueSize()
     {
         assert(isInitialized_);
-        std::lock_guard<std::mutex> lock(queue_mtx_);
         return queue_.size();
     }
 
@@ -134,20 +466,131 @@ namespace uart::recv {
     bool isQueueEmpty()
     {
         assert(isInitialized_);
-        std::lock_guard<std::mutex> lock(queue_mtx_);
         return queue_.empty();
     }
 
 
+    uint64_t getOverflowCount()
+    {
+        assert(isInitialized_);
+        return queue_.getOverflowCount();
+    }
+
+
+    void setOverflowPolicy(eOverflowPolicy policy)
+    {
+        assert(isInitialized_);
+        queue_.setPolicy(policy);
+    }
+
+
     void clearQueue()
     {
         assert(isInitialized_);
 
-        // Create an empty queue and swap,
         // Destructor for DataPacket objects will run
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        std::queue<DataPacket> q_empty;
-        std::swap(queue_, q_empty);
+        queue_.clear();
+    }
+
+
+    void setQueueEnabled(bool isEnabled)
+    {
+        assert(isInitialized_);
+        isQueueEnabled_ = isEnabled;
+        if (!isEnabled) {
+            queue_.clear();
+        }
+    }
+
+
+    SubscriptionId subscribe(ePacketID id, Handler handler, eExecutor executor)
+    {
+        assert(isInitialized_);
+        assert(handler);
+
+        std::lock_guard<std::mutex> lock(subscribeMtx_);
+        if (executor == eExecutor::POOL && !isPoolRunning_) {
+            isPoolRunning_ = true;
+            for (size_t i = 0; i < config::RX_POOL_THREADS; i++) {
+                poolThreads_.emplace_back(pool_loop);
+            }
+        }
+
+        auto subscriber = std::make_shared<const Subscriber>(
+            Subscriber {nextSubscription_++, executor, std::move(handler)});
+
+        auto table = std::make_shared<SubscriberTable>(*subscribers_.load());
+        (*table)[static_cast<uint8_t>(id)].push_back(subscriber);
+        subscribers_.store(std::move(table));
+        return subscriber->id;
+    }
+
+
+    void unsubscribe(SubscriptionId subscription)
+    {
+        assert(isInitialized_);
+
+        std::lock_guard<std::mutex> lock(subscribeMtx_);
+        auto table = std::make_shared<SubscriberTable>(*subscribers_.load());
+        for (auto &subscribers : *table) {
+            std::erase_if(subscribers, [subscription](const auto &subscriber) {
+                return subscriber->id == subscription;
+            });
+        }
+        subscribers_.store(std::move(table));
+    }
+
+
+    size_t pollMailbox(std::chrono::microseconds timeout)
+    {
+        assert(isInitialized_);
+
+        if (timeout.count() > 0 && mailbox_.jobs.empty()) {
+            mailbox_.wait(Clock::now() + timeout, []() { return false; });
+        }
+
+        // At most a mailbox full, so a steady stream can't keep the caller here
+        size_t count {0};
+        while (count < config::RX_MAILBOX_SIZE) {
+            auto job = mailbox_.jobs.pop();
+            if (!job.has_value()) {
+                break;
+            }
+            runJob(*job);
+            count++;
+        }
+        return count;
+    }
+
+
+    void setConflated(ePacketID id, bool isConflated)
+    {
+        assert(isInitialized_);
+        assert(static_cast<size_t>(id) < PACKET_ID_COUNT);
+        isConflated_[static_cast<size_t>(id)] = isConflated;
+    }
+
+
+    Latest readLatest(ePacketID id)
+    {
+        assert(isInitialized_);
+        assert(static_cast<size_t>(id) < PACKET_ID_COUNT);
+
+        const auto &slot = latest_[static_cast<size_t>(id)].read();
+        return {slot.value, slot.generation};
+    }
+
+
+    DispatchStats getDispatchStats()
+    {
+        assert(isInitialized_);
+
+        DispatchStats stats {};
+        stats.delivered        = delivered_.load(std::memory_order_relaxed);
+        stats.dropped          = dropped_.load(std::memory_order_relaxed);
+        stats.poolOverflows    = pool_.jobs.getOverflowCount();
+        stats.mailboxOverflows = mailbox_.jobs.getOverflowCount();
+        return stats;
     }
 
 } // namespace uart::recv
\ No newline at end of file
@@ -0,0 +1,507 @@
+/**
+ * @file reliable.cpp
+ * @brief Acknowledged, retransmitted delivery on top of uart::send and uart::recv
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/arq.h"
+#include "comm/uart/bounded_queue.h"
+#include "comm/uart/config.h"
+#include "comm/uart/reliable.h"
+#include "comm/uart/send.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::microseconds;
+
+    constexpr size_t WINDOW {uart::config::RELIABLE_WINDOW};
+    static_assert(WINDOW <= uart::arq::SACK_BITS, "Window must fit the Ack bitmap");
+    static_assert(256 % WINDOW == 0, "Window must divide the sequence space");
+
+    // Largest payload that still fits after the sequence number
+    constexpr size_t MAX_PAYLOAD {uart::DATA_MAX_SIZE - 2};
+
+    bool isInitialized_ {false};
+
+    // Everything below is shared by the app (enqueue), recv (onFrame/onAck) and the
+    // timer thread (poll)
+    std::mutex mtx_;
+
+    // A frame in flight, indexed by sequence number modulo WINDOW
+    struct Slot {
+        std::optional<uart::DataPacket> frame; // Wire frame without RELIABLE_SYN_FLAG
+        uart::send::ePriority priority {};
+        Clock::time_point sentAt {};
+        Clock::duration queueDelay {}; // Wire time of the frames in flight ahead of it
+        Clock::time_point deadline {}; // Retransmit if not acked by then
+        uint64_t writeSeq {0};         // Order its last copy was written in, 0 if none yet
+        int queued {0};                // Copies still waiting in their send lane
+        int transmissions {0};
+        bool isAcked {false};
+    };
+
+    std::array<Slot, WINDOW> window_ {};
+    uint8_t baseSeq_ {0}; // Oldest frame not yet acked
+    uint8_t nextSeq_ {0}; // Sequence number for the next new frame
+    size_t windowSize_ {WINDOW};
+    bool isSynced_ {false}; // Peer has acked at least once
+    uint64_t writeSeq_ {0}; // Frames written by send so far
+
+    // Packets waiting for room in the window
+    uart::BoundedQueue<uart::DataPacket, uart::config::MAX_TX_QUEUE_SIZE> backlog_ {
+        uart::eOverflowPolicy::DROP_NEWEST};
+
+    // Round trip estimate, RFC 6298
+    bool hasRttSample_ {false};
+    microseconds srtt_ {0};
+    microseconds rttvar_ {0};
+    microseconds rto_ {std::chrono::milliseconds(uart::config::RELIABLE_RTO_INIT_MS)};
+
+    // Receiving side
+    uart::arq::Receiver receiver_;
+    bool isAckPending_ {false};
+
+    uart::reliable::Stats stats_ {};
+
+    // Timer thread
+    std::atomic_bool isThreadRunning_ {false};
+    std::thread thread_;
+    std::mutex wake_mtx_;
+    std::condition_variable wake_cv_;
+    bool isWakePending_ {false};
+
+
+    Slot &slotOf(uint8_t seq) { return window_[seq % WINDOW]; }
+
+
+    size_t inFlight() { return static_cast<uint8_t>(nextSeq_ - baseSeq_); }
+
+
+    void wakeTimer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_mtx_);
+            isWakePending_ = true;
+        }
+        wake_cv_.notify_one();
+    }
+
+
+    // Wire bytes of every frame not yet acked
+    size_t bytesInFlight()
+    {
+        size_t bytes {0};
+        for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+            const Slot &slot {slotOf(seq)};
+            if (!slot.isAcked) {
+                bytes += uart::send::wireSize(*slot.frame);
+            }
+        }
+        return bytes;
+    }
+
+
+    Clock::duration wireTime(size_t bytes)
+    {
+        uint32_t bitsPerSec {uart::send::getLinkRate()};
+        if (bitsPerSec == 0) {
+            return Clock::duration::zero(); // Unpaced, no estimate
+        }
+        return std::chrono::nanoseconds(uint64_t {1'000'000'000} * bytes
+                                        * uart::config::TX_BITS_PER_BYTE / bitsPerSec);
+    }
+
+
+    void transmit(Slot &slot, Clock::time_point now)
+    {
+        uart::DataPacket frame {*slot.frame};
+
+        // Until the peer answers, let it know this may be a new session
+        if (!isSynced_) {
+            auto id {static_cast<uint8_t>(frame.getID()) | uart::RELIABLE_SYN_FLAG};
+            frame = uart::DataPacket(static_cast<uart::ePacketID>(id), frame.getData());
+        }
+
+        // A full lane drops it, the timer sends it again
+        if (uart::send::enqueue(std::move(frame), slot.priority)) {
+            slot.queued++;
+        }
+
+        // Until onWritten(), assume the rest of the window goes out first. Start the timer
+        // from when this frame should reach the wire, or a full window would always look
+        // timed out.
+        slot.sentAt     = now;
+        slot.queueDelay = wireTime(bytesInFlight() - uart::send::wireSize(*slot.frame));
+        slot.deadline   = now + slot.queueDelay + rto_;
+        slot.transmissions++;
+    }
+
+
+    // Moves backlog packets into the window while there is room. Caller holds mtx_.
+    void fillWindow(Clock::time_point now)
+    {
+        // One SYN frame at a time: the peer restarts its window at the first it gets, so
+        // one overtaking another in a higher lane would make the other look old
+        size_t windowSize {isSynced_ ? windowSize_ : 1};
+        while (inFlight() < windowSize) {
+            auto packet = backlog_.pop();
+            if (!packet.has_value()) {
+                break;
+            }
+
+            // Prefix the payload with the sequence number
+            uint8_t wrapped[uart::DATA_MAX_SIZE] {};
+            auto data = packet->getData();
+            wrapped[0] = nextSeq_;
+            std::copy(data.begin(), data.end(), &wrapped[1]);
+
+            auto id {static_cast<uint8_t>(packet->getID()) | uart::RELIABLE_FLAG};
+            Slot &slot {slotOf(nextSeq_)};
+            slot.frame.emplace(static_cast<uart::ePacketID>(id),
+                               std::span<const uint8_t>(wrapped, data.size() + 1));
+            slot.priority      = uart::send::classify(*packet);
+            slot.writeSeq      = 0;
+            slot.queued        = 0;
+            slot.transmissions = 0;
+            slot.isAcked       = false;
+            nextSeq_++;
+
+            transmit(slot, now);
+        }
+    }
+
+
+    // Releases acked frames at the front of the window. Caller holds mtx_.
+    void slideWindow()
+    {
+        while (baseSeq_ != nextSeq_ && slotOf(baseSeq_).isAcked) {
+            slotOf(baseSeq_).frame.reset();
+            baseSeq_++;
+        }
+    }
+
+
+    void sampleRtt(microseconds rtt)
+    {
+        if (!hasRttSample_) {
+            srtt_         = rtt;
+            rttvar_       = rtt / 2;
+            hasRttSample_ = true;
+        } else {
+            rttvar_ = (3 * rttvar_ + (srtt_ > rtt ? srtt_ - rtt : rtt - srtt_)) / 4;
+            srtt_   = (7 * srtt_ + rtt) / 8;
+        }
+
+        rto_ = std::clamp<microseconds>(
+            srtt_ + 4 * rttvar_, std::chrono::milliseconds(uart::config::RELIABLE_RTO_MIN_MS),
+            std::chrono::milliseconds(uart::config::RELIABLE_RTO_MAX_MS));
+    }
+
+
+    Clock::time_point nextDeadline()
+    {
+        Clock::time_point next {Clock::time_point::max()};
+        for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+            if (!slotOf(seq).isAcked) {
+                next = std::min(next, slotOf(seq).deadline);
+            }
+        }
+        return next;
+    }
+
+
+    void thread_loop()
+    {
+        while (isThreadRunning_) {
+            auto deadline = uart::reliable::poll();
+
+            // Sleep until the next retransmit is due, or new frames go out
+            std::unique_lock<std::mutex> lock(wake_mtx_);
+            auto isWoken = []() { return !isThreadRunning_ || isWakePending_; };
+            if (deadline == Clock::time_point::max()) {
+                wake_cv_.wait(lock, isWoken);
+            } else {
+                wake_cv_.wait_until(lock, deadline, isWoken);
+            }
+            isWakePending_ = false;
+        }
+    }
+
+} // namespace
+
+
+namespace uart::reliable {
+    void init()
+    {
+        assert(!isInitialized_);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        window_       = {};
+        baseSeq_      = 0;
+        nextSeq_      = 0;
+        isSynced_     = false;
+        writeSeq_     = 0;
+        hasRttSample_ = false;
+        rto_          = std::chrono::milliseconds(config::RELIABLE_RTO_INIT_MS);
+        receiver_     = {};
+        isAckPending_ = false;
+        stats_        = {};
+        backlog_.clear();
+
+        isInitialized_ = true;
+    }
+
+
+    void deinit()
+    {
+        assert(isInitialized_);
+        isInitialized_ = false;
+    }
+
+
+    void start()
+    {
+        assert(isInitialized_);
+        isThreadRunning_ = true;
+        thread_          = std::thread(thread_loop);
+    }
+
+
+    void stop()
+    {
+        assert(isInitialized_);
+        {
+            std::lock_guard<std::mutex> lock(wake_mtx_);
+            isThreadRunning_ = false;
+        }
+        wake_cv_.notify_one();
+        thread_.join();
+    }
+
+
+    bool isRunning()
+    {
+        assert(isInitialized_);
+        return (isThreadRunning_);
+    }
+
+
+    bool enqueue(DataPacket packet)
+    {
+        assert(isInitialized_);
+        if (packet.isTruncated() || packet.getData().size() > MAX_PAYLOAD) {
+            return false; // Cut short, or no room for the sequence number
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!backlog_.push(std::move(packet))) {
+                return false;
+            }
+            stats_.sent++;
+            fillWindow(Clock::now());
+        }
+
+        wakeTimer();
+        return true;
+    }
+
+
+    void setWindowSize(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        windowSize_ = std::clamp<size_t>(size, 1, WINDOW);
+    }
+
+
+    std::optional<DataPacket> onFrame(const DataPacketView &view)
+    {
+        assert(isInitialized_);
+
+        auto data = view.getData();
+        if (data.empty()) {
+            return std::nullopt; // No sequence number
+        }
+
+        auto id {static_cast<uint8_t>(view.getID())};
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // Ack duplicates too, the previous Ack may have been the one that got lost
+        isAckPending_ = true;
+        if (!receiver_.accept(data[0], (id & RELIABLE_SYN_FLAG) != 0)) {
+            stats_.duplicates++;
+            return std::nullopt;
+        }
+
+        stats_.received++;
+        return view.toPacket(static_cast<ePacketID>(id & PACKET_ID_MASK), data.subspan(1));
+    }
+
+
+    void flushAck()
+    {
+        assert(isInitialized_);
+
+        payload::Ack ack {};
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!isAckPending_) {
+                return;
+            }
+            ack           = receiver_.getAck();
+            isAckPending_ = false;
+        }
+
+        send::enqueue(makePacket<ePacketID::ACK_RADXA>(ack));
+    }
+
+
+    void onAck(const DataPacketView &view)
+    {
+        assert(isInitialized_);
+
+        payload::Ack ack {};
+        auto data = view.getData();
+        if (!schema::decode(data.data(), data.size(), ack)) {
+            return;
+        }
+
+        auto now = Clock::now();
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            isSynced_ = true;
+
+            // Mark what the Ack covers, and find the latest write it confirms
+            uint64_t latestAcked {0};
+            for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+                Slot &slot {slotOf(seq)};
+                auto offset {static_cast<uint8_t>(seq - ack.next_seq - 1)};
+                bool isAcked {arq::seqBefore(seq, ack.next_seq)
+                              || (offset < arq::SACK_BITS && ((ack.sack_mask >> offset) & 1))};
+                if (slot.isAcked || !isAcked) {
+                    continue;
+                }
+
+                slot.isAcked = true;
+                stats_.acked++;
+                latestAcked = std::max(latestAcked, slot.writeSeq);
+
+                // Karn: a retransmitted frame's Ack could be for either copy
+                if (slot.transmissions == 1) {
+                    auto rtt = now - slot.sentAt - slot.queueDelay;
+                    sampleRtt(std::chrono::duration_cast<microseconds>(
+                        std::max(rtt, Clock::duration::zero())));
+                }
+            }
+
+            // The UART doesn't reorder bytes, so a frame written before one that was acked
+            // is lost. One that's still queued, or sent again since, isn't.
+            for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+                Slot &slot {slotOf(seq)};
+                if (!slot.isAcked && slot.queued == 0 && slot.writeSeq != 0
+                    && slot.writeSeq < latestAcked) {
+                    transmit(slot, now);
+                    stats_.retransmits++;
+                }
+            }
+
+            slideWindow();
+            fillWindow(now);
+        }
+
+        wakeTimer();
+    }
+
+
+    void onWritten(const DataPacket &frame, std::chrono::steady_clock::time_point onWire)
+    {
+        auto data = frame.getData();
+        if (!isInitialized_ || data.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        uint8_t seq {data[0]};
+        if (static_cast<uint8_t>(seq - baseSeq_) >= inFlight()) {
+            return; // Already acked and released
+        }
+
+        Slot &slot {slotOf(seq)};
+        slot.queued = std::max(slot.queued - 1, 0);
+        if (slot.isAcked) {
+            return;
+        }
+
+        // Time it from the wire rather than the queue
+        slot.writeSeq   = ++writeSeq_;
+        slot.sentAt     = onWire;
+        slot.queueDelay = Clock::duration::zero();
+        slot.deadline   = onWire + rto_;
+    }
+
+
+    std::chrono::steady_clock::time_point poll()
+    {
+        assert(isInitialized_);
+
+        auto now = Clock::now();
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // Back off once per expiry, not once per frame
+        bool hasExpired {false};
+        for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+            const Slot &slot {slotOf(seq)};
+            hasExpired |= !slot.isAcked && slot.queued == 0 && now >= slot.deadline;
+        }
+        if (hasExpired) {
+            rto_ = std::min<microseconds>(2 * rto_, std::chrono::milliseconds(
+                                                        config::RELIABLE_RTO_MAX_MS));
+        }
+
+        for (uint8_t seq = baseSeq_; seq != nextSeq_; seq++) {
+            Slot &slot {slotOf(seq)};
+            if (slot.isAcked || now < slot.deadline) {
+                continue;
+            }
+
+            // Starved by higher lanes or held back for credit, it hasn't had its chance
+            if (slot.queued > 0) {
+                slot.deadline = now + rto_;
+                continue;
+            }
+
+            if (slot.transmissions >= config::RELIABLE_MAX_TRANSMISSIONS) {
+                slot.isAcked = true; // Give up, free the slot
+                stats_.failed++;
+                continue;
+            }
+
+            transmit(slot, now);
+            stats_.retransmits++;
+        }
+
+        slideWindow();
+        fillWindow(now);
+        return nextDeadline();
+    }
+
+
+    Stats getStats()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        Stats stats {stats_};
+        stats.srtt = srtt_;
+        stats.rto  = rto_;
+        return stats;
+    }
+
+} // namespace uart::reliable
@@ -5,54 +5,341 @@
  * @date Oct-17-2025
  */
 
+#include "comm/uart/bounded_queue.h"
 #include "comm/uart/config.h"
+#include "comm/uart/flow_control.h"
+#include "comm/uart/reactor.h"
+#include "comm/uart/reliable.h"
 #include "comm/uart/send.h"
+#include "comm/uart/trace.h"
 
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cassert>
+#include <condition_variable>
 #include <mutex>
 #include <optional>
-#include <queue>
 #include <thread>
 
 namespace {
+    using Clock = std::chrono::steady_clock;
+
     bool isInitialized_ {false};
 
     // Shared pointer to the serial port
     std::shared_ptr<SerialUART> uartPtr_ {nullptr};
 
-    // Queue for storing messages
-    std::queue<uart::DataPacket> queue_;
+    struct TxItem {
+        uart::DataPacket packet;
+        Clock::time_point enqueued;
+        Clock::time_point deadline; // Clock::time_point::max() if it never goes stale
+        uart::send::ePriority priority;
+    };
+
+    // One queue per lane, index 0 is the highest priority. Reject new packets
+    // (enqueue() returns false) if the link falls behind.
+    using Lane = uart::BoundedQueue<TxItem, uart::config::MAX_TX_QUEUE_SIZE>;
+    Lane lanes_[uart::send::PRIORITY_COUNT] {
+        Lane {uart::eOverflowPolicy::DROP_NEWEST}, Lane {uart::eOverflowPolicy::DROP_NEWEST},
+        Lane {uart::eOverflowPolicy::DROP_NEWEST}, Lane {uart::eOverflowPolicy::DROP_NEWEST}};
 
     // Threading
     std::atomic_bool isThreadRunning_ {false};
     std::thread thread_;
-    std::mutex queue_mtx_;
 
+    // Sleep/wakeup for the send thread. enqueue() only takes the mutex when the thread
+    // is asleep, and the mutex is never held while writing to the port.
+    std::mutex wake_mtx_;
+    std::condition_variable wake_cv_;
+    std::atomic_bool isSleeping_ {false};
+
+    uart::eWireFormat format_ {uart::eWireFormat::SYNC_LENGTH};
+    uart::eChecksum checksum_ {uart::eChecksum::CRC8};
+
+    // Pending packets are serialized back to back and written with one call
+    uint8_t batch_[uart::config::TX_BATCH_BUF_SIZE] {};
+    size_t batchLen_ {0};               // Bytes serialized into batch_
+    size_t batchOff_ {0};               // Bytes of batch_ already written
+    std::optional<TxItem> carry_;       // Popped but didn't fit in the last batch
+    std::optional<TxItem> safetyCarry_; // Same, for a safety packet that went past carry_
+
+    // Enqueue times of the packets in batch_, and when it was serialized, for uart::trace.
+    // The smallest frame has no data and the shortest checksum.
+    constexpr size_t MAX_BATCH_PACKETS {
+        uart::config::TX_BATCH_BUF_SIZE
+        / (uart::PACKET_HEADER_SIZE + uart::checksumSize(uart::eChecksum::CRC8))};
+    Clock::time_point batchEnqueued_[MAX_BATCH_PACKETS] {};
+    size_t batchCount_ {0};
+    Clock::time_point batchSerialized_ {};
+
+    // Pacing, the estimated time the last written byte leaves the wire
+    std::atomic<uint64_t> byteTimeNs_ {uint64_t {1'000'000'000}
+                                      * uart::config::TX_BITS_PER_BYTE
+                                      / uart::config::TX_LINK_RATE_BPS};
+    Clock::time_point busyUntil_ {};
+    Clock::time_point resumeTime_ {};
+
+    // Flow control. onCredit() posts the STM32's latest advert, flush() applies it.
+    struct Advert {
+        uint32_t rxBytes;
+        uint16_t rxFree;
+        Clock::time_point received;
+    };
+    std::mutex advertMtx_;
+    Advert advert_ {};
+    std::atomic_bool isAdvertPending_ {false};
+
+    uart::flow::Window window_ {};
+    Clock::time_point lastSent_ {}; // Estimated time the last written byte left the wire
+    bool isCreditBlocked_ {false};  // carry_ is waiting for credit
+
+    // Published by flush() for getFlowStats()
+    std::atomic_bool isFlowLimited_ {false};
+    std::atomic<size_t> creditAvailable_ {0};
+    std::atomic<uint64_t> creditStalls_ {0};
+
+    // Written by whichever thread calls flush(), read by anyone
+    struct LaneCounters {
+        std::atomic<uint64_t> sent {0};
+        std::atomic<uint64_t> droppedStale {0};
+        std::atomic<uint64_t> droppedFull {0};
+        std::atomic<uint64_t> droppedTruncated {0};
+        std::atomic<uint64_t> latencyMaxUs {0};
+        std::atomic<uint64_t> latencyTotalUs {0};
+        std::atomic<uint64_t> latencyHistUs[uart::send::LATENCY_BUCKETS] {};
+    };
+    LaneCounters stats_[uart::send::PRIORITY_COUNT] {};
+
+
+    void wakeup()
+    {
+        if (uart::reactor::isRunning()) {
+            uart::reactor::wakeup();
+            return;
+        }
 
-    void serialAndSend()
+        // Pairs with the fence in waitForWork() so a push is never missed
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (isSleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(wake_mtx_);
+            wake_cv_.notify_one();
+        }
+    }
+
+
+    bool hasWork()
     {
-        uint8_t buffer[uart::config::READ_BUF_SIZE] {};
+        if (batchOff_ < batchLen_ || carry_.has_value() || safetyCarry_.has_value()) {
+            return true;
+        }
+        return std::any_of(std::begin(lanes_), std::end(lanes_),
+                           [](const Lane &lane) { return !lane.empty(); });
+    }
 
-        // Serialize into the buffer
-        size_t packetSize = queue_.front().serialize(buffer, sizeof(buffer));
-        queue_.pop();
 
-        uartPtr_->writeData(buffer, packetSize);
+    void waitForWork()
+    {
+        std::unique_lock<std::mutex> lock(wake_mtx_);
+        isSleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        wake_cv_.wait(lock, []() { return !isThreadRunning_ || hasWork(); });
+        isSleeping_.store(false, std::memory_order_relaxed);
+    }
+
+
+    // Sleeps until the STM32 advertises more credit. Safety packets don't need any,
+    // so enqueueing one wakes it too.
+    void waitForCredit()
+    {
+        std::unique_lock<std::mutex> lock(wake_mtx_);
+        isSleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        wake_cv_.wait(lock, []() {
+            return !isThreadRunning_ || isAdvertPending_.load(std::memory_order_relaxed)
+                || !lanes_[static_cast<size_t>(uart::send::ePriority::SAFETY)].empty();
+        });
+        isSleeping_.store(false, std::memory_order_relaxed);
+    }
+
+
+    // Sleeps off the pacing delay. New packets don't cut it short, they can't go
+    // out any sooner.
+    void waitUntil(Clock::time_point time)
+    {
+        std::unique_lock<std::mutex> lock(wake_mtx_);
+        wake_cv_.wait_until(lock, time, []() { return !isThreadRunning_; });
+    }
+
+
+    // Next packet to send: the carried one, then the highest non-empty lane
+    std::optional<TxItem> popNext()
+    {
+        if (safetyCarry_.has_value()) {
+            std::optional<TxItem> item {std::move(safetyCarry_)};
+            safetyCarry_.reset();
+            return item;
+        }
+
+        // Safety packets go ahead of one held back for credit, they don't need any
+        if (isCreditBlocked_) {
+            auto item = lanes_[static_cast<size_t>(uart::send::ePriority::SAFETY)].pop();
+            if (item.has_value()) {
+                return item;
+            }
+        }
+
+        // Handed out, it's sent, dropped as stale, or carried (and blocked) again
+        if (carry_.has_value()) {
+            std::optional<TxItem> item {std::move(carry_)};
+            carry_.reset();
+            isCreditBlocked_ = false;
+            return item;
+        }
+
+        for (auto &lane : lanes_) {
+            auto item = lane.pop();
+            if (item.has_value()) {
+                return item;
+            }
+        }
+        return std::nullopt;
+    }
+
+
+    void recordSent(const TxItem &item, Clock::time_point onWire)
+    {
+        auto &stats = stats_[static_cast<size_t>(item.priority)];
+        auto latency
+            = std::chrono::duration_cast<std::chrono::microseconds>(onWire - item.enqueued);
+        auto latencyUs {static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0))};
+
+        size_t bucket {
+            std::min<size_t>(std::bit_width(latencyUs), uart::send::LATENCY_BUCKETS - 1)};
+        stats.latencyHistUs[bucket].fetch_add(1, std::memory_order_relaxed);
+        stats.latencyTotalUs.fetch_add(latencyUs, std::memory_order_relaxed);
+        stats.sent.fetch_add(1, std::memory_order_relaxed);
+        if (latencyUs > stats.latencyMaxUs.load(std::memory_order_relaxed)) {
+            stats.latencyMaxUs.store(latencyUs, std::memory_order_relaxed);
+        }
+    }
+
+
+    // Applies the STM32's latest advert, if a new one arrived
+    void applyAdvert()
+    {
+        if (isAdvertPending_.exchange(false)) {
+            Advert advert {};
+            {
+                std::lock_guard<std::mutex> lock(advertMtx_);
+                advert = advert_;
+            }
+
+            auto idle = std::chrono::milliseconds(uart::config::FLOW_IDLE_MS);
+            window_.onAdvert(advert.rxBytes, advert.rxFree, advert.received - lastSent_ > idle);
+        }
+
+        isFlowLimited_.store(window_.isKnown(), std::memory_order_relaxed);
+        creditAvailable_.store(window_.getAvailable(), std::memory_order_relaxed);
+    }
+
+
+    // Serialize pending packets into batch_ until budget bytes are used, returns the
+    // batch size. The last packet may go over budget so that one always fits, but not
+    // over the STM32's credit unless it's a safety packet.
+    size_t fillBatch(size_t budget, Clock::time_point now)
+    {
+        const uint64_t byteTimeNs {byteTimeNs_.load(std::memory_order_relaxed)};
+        const size_t credit {window_.getAvailable()};
+        size_t used {0};
+
+        while (used < budget) {
+            auto item = popNext();
+            if (!item.has_value()) {
+                break; // Nothing left
+            }
+
+            if (now > item->deadline) {
+                stats_[static_cast<size_t>(item->priority)].droppedStale.fetch_add(
+                    1, std::memory_order_relaxed);
+                continue;
+            }
+
+            size_t packetSize {item->packet.serialize(batch_ + used, sizeof(batch_) - used,
+                                                      format_, checksum_)};
+            if (packetSize == 0) {
+                // A held carry_ is still blocked, this went past it
+                (carry_.has_value() ? safetyCarry_ : carry_) = std::move(item);
+                break; // Batch full, send this one next time
+            }
+            if (used + packetSize > credit && item->priority != uart::send::ePriority::SAFETY) {
+                carry_           = std::move(item);
+                isCreditBlocked_ = true;
+                break; // STM32 has no room for it yet
+            }
+            used += packetSize;
+            if (batchCount_ < MAX_BATCH_PACKETS) {
+                batchEnqueued_[batchCount_++] = item->enqueued;
+            }
+
+            // Estimate when its last byte leaves the wire
+            Clock::time_point onWire {now};
+            if (byteTimeNs > 0) {
+                busyUntil_ = std::max(busyUntil_, now)
+                           + std::chrono::nanoseconds(packetSize * byteTimeNs);
+                onWire = busyUntil_;
+            }
+            lastSent_ = onWire;
+            recordSent(*item, onWire);
+
+            // Lanes reorder frames, reliable needs to know which went out first
+            if (static_cast<uint8_t>(item->packet.getID()) & uart::RELIABLE_FLAG) {
+                uart::reliable::onWritten(item->packet, onWire);
+            }
+        }
+
+        window_.onSent(used);
+        return used;
+    }
+
+
+    // The whole of batch_ has been written
+    void traceBatch()
+    {
+        auto written = Clock::now();
+        uart::trace::get(uart::trace::eSpan::TX_WRITE).record(written - batchSerialized_);
+
+        for (size_t i = 0; i < batchCount_; i++) {
+            uart::trace::get(uart::trace::eSpan::TX_QUEUE)
+                .record(batchSerialized_ - batchEnqueued_[i]);
+            uart::trace::get(uart::trace::eSpan::TX_TOTAL).record(written - batchEnqueued_[i]);
+        }
+        batchCount_ = 0;
     }
 
 
     void thread_loop()
     {
         while (isThreadRunning_) {
-            // Check if queue is empty:
-            // - If empty, do nothing
-            // - If not, serialize the first item in queue
-            // 		- Make sure data serialization is valid
-            //		- Send data via uart
-            std::lock_guard<std::mutex> lock(queue_mtx_);
-            if (!queue_.empty()) {
-                serialAndSend();
+            // Sleep until there is something to send, then drain the lanes:
+            // - Serialize pending packets into one batch, highest lane first
+            // - Send the batch with a single write
+            // - Hold off while the link is still busy with earlier batches
+            waitForWork();
+
+            while (isThreadRunning_) {
+                auto status = uart::send::flush();
+                if (status == uart::send::eFlushStatus::DONE) {
+                    break;
+                }
+                if (status == uart::send::eFlushStatus::PACING) {
+                    waitUntil(uart::send::getResumeTime());
+                }
+                if (status == uart::send::eFlushStatus::NO_CREDIT) {
+                    waitForCredit();
+                }
             }
         }
     }
@@ -60,13 +347,38 @@ namespace {
 } // namespace
 
 namespace uart::send {
-    void init(std::shared_ptr<SerialUART> uartPtr)
+    uint64_t LaneStats::percentileUs(double percentile) const noexcept
+    {
+        if (sent == 0) {
+            return 0;
+        }
+
+        auto target {static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(sent))};
+        uint64_t seen {0};
+        for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+            seen += latencyHistUs[i];
+            if (seen > target || seen == sent) {
+                return uint64_t {1} << i;
+            }
+        }
+        return uint64_t {1} << (LATENCY_BUCKETS - 1);
+    }
+
+
+    void init(std::shared_ptr<SerialUART> uartPtr, eWireFormat format, eChecksum checksum)
     {
         assert(!isInitialized_);
 
         // Share ownership of pointer
         uartPtr_ = uartPtr;
         assert(uartPtr_ != nullptr);
+        format_   = format;
+        checksum_ = checksum;
+
+        window_.reset();
+        isAdvertPending_ = false;
+        isCreditBlocked_ = false;
+        creditStalls_    = 0;
 
         isInitialized_ = true;
     }
@@ -94,7 +406,11 @@ namespace uart::send {
     void stop()
     {
         assert(isInitialized_);
-        isThreadRunning_ = false;
+        {
+            std::lock_guard<std::mutex> lock(wake_mtx_);
+            isThreadRunning_ = false;
+        }
+        wake_cv_.notify_one();
         thread_.join();
     }
 
@@ -106,27 +422,218 @@ namespace uart::send {
     }
 
 
-    void enqueue(DataPacket packet)
+    eFlushStatus flush()
+    {
+        assert(isInitialized_);
+
+        while (true) {
+            // Previous batch fully written, start a new one
+            if (batchOff_ == batchLen_) {
+                auto now = Clock::now();
+                size_t budget {sizeof(batch_)};
+
+                // Keep at most TX_MAX_INFLIGHT_BYTES ahead of the wire, so anything
+                // enqueued later waits behind at most that much
+                uint64_t byteTimeNs {byteTimeNs_.load(std::memory_order_relaxed)};
+                if (byteTimeNs > 0) {
+                    auto limit = std::chrono::nanoseconds(config::TX_MAX_INFLIGHT_BYTES * byteTimeNs);
+                    auto backlog = std::max(busyUntil_ - now, Clock::duration::zero());
+                    if (backlog >= limit) {
+                        if (!hasWork()) {
+                            return eFlushStatus::DONE;
+                        }
+                        resumeTime_ = busyUntil_ - limit;
+                        return eFlushStatus::PACING;
+                    }
+                    auto backlogBytes {static_cast<size_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(backlog).count()
+                        / static_cast<int64_t>(byteTimeNs))};
+                    budget = config::TX_MAX_INFLIGHT_BYTES - backlogBytes;
+                }
+
+                applyAdvert();
+                batchCount_ = 0;
+                batchLen_   = fillBatch(budget, now);
+                batchOff_   = 0;
+                if (batchLen_ == 0 && isCreditBlocked_) {
+                    creditStalls_.fetch_add(1, std::memory_order_relaxed);
+                    return eFlushStatus::NO_CREDIT;
+                }
+                if (batchLen_ == 0) {
+                    return eFlushStatus::DONE; // Lanes drained
+                }
+                if (trace::isEnabled()) {
+                    batchSerialized_ = Clock::now();
+                } else {
+                    batchCount_ = 0;
+                }
+            }
+
+            // write() may return early, or 0 when a non-blocking port is full
+            ssize_t written {uartPtr_->writeData(batch_ + batchOff_, batchLen_ - batchOff_)};
+            if (written <= 0) {
+                return eFlushStatus::PORT_FULL;
+            }
+            batchOff_ += static_cast<size_t>(written);
+
+            if (batchOff_ == batchLen_ && batchCount_ > 0) {
+                traceBatch();
+            }
+        }
+    }
+
+
+    std::chrono::steady_clock::time_point getResumeTime()
     {
         assert(isInitialized_);
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        queue_.push(std::move(packet));
+        return resumeTime_;
+    }
+
+
+    void setLinkRate(uint32_t bitsPerSec)
+    {
+        uint64_t byteTimeNs {0};
+        if (bitsPerSec > 0) {
+            byteTimeNs = uint64_t {1'000'000'000} * config::TX_BITS_PER_BYTE / bitsPerSec;
+        }
+        byteTimeNs_.store(byteTimeNs, std::memory_order_relaxed);
+    }
+
+
+    uint32_t getLinkRate()
+    {
+        uint64_t byteTimeNs {byteTimeNs_.load(std::memory_order_relaxed)};
+        if (byteTimeNs == 0) {
+            return 0;
+        }
+        return static_cast<uint32_t>(uint64_t {1'000'000'000} * config::TX_BITS_PER_BYTE
+                                     / byteTimeNs);
+    }
+
+
+    void onCredit(uint32_t rxBytes, uint16_t rxFree, std::chrono::steady_clock::time_point received)
+    {
+        {
+            std::lock_guard<std::mutex> lock(advertMtx_);
+            advert_ = {rxBytes, rxFree, received};
+        }
+        isAdvertPending_ = true;
+        wakeup();
+    }
+
+
+    FlowStats getFlowStats()
+    {
+        FlowStats stats {};
+        stats.isLimited = isFlowLimited_.load(std::memory_order_relaxed);
+        stats.available = creditAvailable_.load(std::memory_order_relaxed);
+        stats.stalls    = creditStalls_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+
+    ePriority classify(const DataPacket &packet)
+    {
+        switch (packet.getID()) {
+        case ePacketID::CMD_NAV: {
+            // Stopping must not wait behind anything
+            bool isStop {false};
+            dispatch(packet, [&](PacketTag<ePacketID::CMD_NAV>, const payload::CmdNav &nav) {
+                isStop = nav.action == payload::eNavAction::STOP
+                      || nav.action == payload::eNavAction::E_STOP;
+            });
+            return isStop ? ePriority::SAFETY : ePriority::MOTION;
+        }
+
+        case ePacketID::CMD_MOTOR:
+        case ePacketID::ACK_RADXA:
+            return ePriority::MOTION;
+
+        case ePacketID::CONFIG_PID_SPEED:
+        case ePacketID::CONFIG_PID_LANE:
+        case ePacketID::CONFIG_SENSOR:
+        case ePacketID::CONFIG_BAUD:
+        case ePacketID::LINK_TEST:
+            return ePriority::CONFIG;
+
+        default:
+            return ePriority::STATUS;
+        }
+    }
+
+
+    size_t wireSize(const DataPacket &packet)
+    {
+        return packet.wireSize(format_, checksum_);
+    }
+
+
+    bool enqueue(DataPacket packet)
+    {
+        ePriority priority {classify(packet)};
+        return enqueue(std::move(packet), priority);
+    }
+
+
+    bool enqueue(DataPacket packet, ePriority priority, std::chrono::milliseconds maxAge)
+    {
+        assert(isInitialized_);
+        auto now = Clock::now();
+        auto index {static_cast<size_t>(priority)};
+
+        // Its payload was cut short, the STM32 would get the wrong data
+        if (packet.isTruncated()) {
+            stats_[index].droppedTruncated.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        TxItem item {std::move(packet), now,
+                     maxAge.count() > 0 ? now + maxAge : Clock::time_point::max(), priority};
+        bool isQueued {lanes_[index].push(std::move(item))};
+        if (!isQueued) {
+            stats_[index].droppedFull.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        wakeup();
+        return isQueued;
     }
 
 
     size_t getQueueSize()
     {
         assert(isInitialized_);
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        return queue_.size();
+        size_t size {0};
+        for (const auto &lane : lanes_) {
+            size += lane.size();
+        }
+        return size;
     }
 
 
     bool isQueueEmpty()
     {
         assert(isInitialized_);
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        return queue_.empty();
+        return getQueueSize() == 0;
+    }
+
+
+    uint64_t getOverflowCount()
+    {
+        assert(isInitialized_);
+        uint64_t count {0};
+        for (const auto &lane : lanes_) {
+            count += lane.getOverflowCount();
+        }
+        return count;
+    }
+
+
+    void setOverflowPolicy(eOverflowPolicy policy)
+    {
+        assert(isInitialized_);
+        for (auto &lane : lanes_) {
+            lane.setPolicy(policy);
+        }
     }
 
 
@@ -134,11 +641,44 @@ namespace uart::send {
     {
         assert(isInitialized_);
 
-        // Create an empty queue and swap,
         // Destructor for DataPacket objects will run
-        std::lock_guard<std::mutex> lock(queue_mtx_);
-        std::queue<DataPacket> q_empty;
-        std::swap(queue_, q_empty);
+        for (auto &lane : lanes_) {
+            lane.clear();
+        }
+    }
+
+
+    LaneStats getLaneStats(ePriority priority)
+    {
+        const auto &counters = stats_[static_cast<size_t>(priority)];
+
+        LaneStats stats {};
+        stats.sent             = counters.sent.load(std::memory_order_relaxed);
+        stats.droppedStale     = counters.droppedStale.load(std::memory_order_relaxed);
+        stats.droppedFull      = counters.droppedFull.load(std::memory_order_relaxed);
+        stats.droppedTruncated = counters.droppedTruncated.load(std::memory_order_relaxed);
+        stats.latencyMaxUs     = counters.latencyMaxUs.load(std::memory_order_relaxed);
+        stats.latencyTotalUs   = counters.latencyTotalUs.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < LATENCY_BUCKETS; i++) {
+            stats.latencyHistUs[i] = counters.latencyHistUs[i].load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+
+    void resetLaneStats()
+    {
+        for (auto &counters : stats_) {
+            counters.sent.store(0, std::memory_order_relaxed);
+            counters.droppedStale.store(0, std::memory_order_relaxed);
+            counters.droppedFull.store(0, std::memory_order_relaxed);
+            counters.droppedTruncated.store(0, std::memory_order_relaxed);
+            counters.latencyMaxUs.store(0, std::memory_order_relaxed);
+            counters.latencyTotalUs.store(0, std::memory_order_relaxed);
+            for (auto &bucket : counters.latencyHistUs) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
     }
 
-} // namespace uart::send
\ No newline at end of file
+} // namespace uart::send
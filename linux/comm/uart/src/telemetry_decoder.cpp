@@ -0,0 +1,88 @@
+/**
+ * @file telemetry_decoder.cpp
+ * @brief Rebuilds absolute TELEMETRY samples from TELEMETRY_COMPACT payloads
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/telemetry_decoder.h"
+
+namespace uart {
+    size_t TelemetryDecoder::decode(std::span<const uint8_t> payload,
+                                    std::span<compact::Sample> out) noexcept
+    {
+        if (payload.size() < compact::HEADER_SIZE) {
+            return dropMalformed();
+        }
+
+        bool isKeyframe {(payload[0] & compact::KEYFRAME_FLAG) != 0};
+        uint8_t seq {payload[1]};
+
+        if (isSynced_ && seq != nextSeq_) {
+            lostFrames_ += static_cast<uint8_t>(seq - nextSeq_);
+        }
+        bool hasReference {isSynced_ && seq == nextSeq_};
+        nextSeq_ = static_cast<uint8_t>(seq + 1);
+
+        if (!isKeyframe && !hasReference) {
+            isSynced_ = false;
+            droppedFrames_++;
+            return 0;
+        }
+
+        // Work on copies, kept once the whole frame has decoded
+        auto prev {prev_};
+        uint32_t prevTimestamp {isKeyframe ? 0 : prevTimestamp_};
+        if (isKeyframe) {
+            prev.fill(0);
+        }
+
+        const uint8_t *src {payload.data() + compact::HEADER_SIZE};
+        const uint8_t *end {payload.data() + payload.size()};
+        size_t count {0};
+
+        while (src < end) {
+            if (count == out.size()) {
+                break; // Caller's buffer is full, the rest of the frame is lost
+            }
+
+            uint32_t value {};
+            if (!compact::readVarint(src, end, value)) {
+                return dropMalformed();
+            }
+            prevTimestamp += value;
+
+            for (size_t i = 0; i < compact::FIELD_COUNT; i++) {
+                if (!compact::readVarint(src, end, value)) {
+                    return dropMalformed();
+                }
+                // Wraps instead of overflowing on a garbled frame
+                prev[i] = static_cast<int32_t>(static_cast<uint32_t>(prev[i])
+                                               + static_cast<uint32_t>(compact::unzigzag(value)));
+            }
+
+            out[count++] = {prevTimestamp, compact::unflatten(prev)};
+        }
+
+        if (src != end) {
+            // Samples past out's size can't be referenced by the next frame
+            isSynced_ = false;
+        } else {
+            prev_          = prev;
+            prevTimestamp_ = prevTimestamp;
+            isSynced_      = true;
+        }
+        decodedFrames_++;
+        return count;
+    }
+
+
+    size_t TelemetryDecoder::dropMalformed() noexcept
+    {
+        // The next delta frame would be relative to this one
+        isSynced_ = false;
+        droppedFrames_++;
+        return 0;
+    }
+
+} // namespace uart
@@ -0,0 +1,168 @@
+/**
+ * @file timesync.cpp
+ * @brief Maps STM32 packet timestamps onto the Radxa's steady_clock
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/timesync.h"
+#include "comm/uart/config.h"
+#include "comm/uart/send.h"
+
+#include <cassert>
+#include <cmath>
+#include <mutex>
+
+namespace {
+    using uart::timesync::Clock;
+
+    bool isInitialized_ {false};
+
+    // Shared by the recv or reactor thread and the app's queries
+    std::mutex mtx_;
+    uart::timesync::Estimator estimator_ {};
+    Clock::time_point nextPing_ {};
+    uint64_t pingsSent_ {0};
+    uint64_t pongsReceived_ {0};
+
+
+    uint64_t toNs(Clock::time_point time)
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+
+
+    // Caller holds mtx_
+    Clock::time_point fromUs(double mcuUs)
+    {
+        auto ns {std::llround(estimator_.toHostNs(mcuUs))};
+        return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(ns)));
+    }
+
+} // namespace
+
+
+namespace uart::timesync {
+    void init()
+    {
+        assert(!isInitialized_);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        estimator_.reset();
+        nextPing_      = Clock::now();
+        pingsSent_     = 0;
+        pongsReceived_ = 0;
+
+        isInitialized_ = true;
+    }
+
+
+    void deinit()
+    {
+        assert(isInitialized_);
+        isInitialized_ = false;
+    }
+
+
+    bool isPong(const DataPacketView &view)
+    {
+        auto data = view.getData();
+        return data.size() >= 2 && isSyncSeq(byte_order::loadLe16(data.data()));
+    }
+
+
+    void onPong(const DataPacketView &view, Clock::time_point received)
+    {
+        assert(isInitialized_);
+        auto data = view.getData();
+
+        payload::LinkTest pong {};
+        if (!schema::decode(data.data(), data.size(), pong)) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        pongsReceived_++;
+        estimator_.add(readPong(pong), toNs(received));
+    }
+
+
+    Clock::time_point poll()
+    {
+        assert(isInitialized_);
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        auto now = Clock::now();
+        if (now < nextPing_) {
+            return nextPing_;
+        }
+
+        // Stamped as late as possible, the time spent in send's queue counts as wire time
+        send::enqueue(makePacket<ePacketID::LINK_TEST>(
+            makePing(static_cast<uint16_t>(pingsSent_), toNs(Clock::now()))));
+        pingsSent_++;
+
+        bool isWindowFull {estimator_.getCount() == Estimator::WINDOW};
+        nextPing_ = now + std::chrono::milliseconds(isWindowFull ? config::TIMESYNC_PERIOD_MS
+                                                                 : config::TIMESYNC_FAST_PERIOD_MS);
+        return nextPing_;
+    }
+
+
+    bool isSynced()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        return estimator_.isSynced();
+    }
+
+
+    std::optional<Clock::time_point> toHostTime(uint32_t mcuMs)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!estimator_.isSynced()) {
+            return std::nullopt;
+        }
+        return fromUs(static_cast<double>(estimator_.extendMs(mcuMs)) * 1000 + 500);
+    }
+
+
+    std::optional<Clock::time_point> toHostTime(McuTime mcuTime)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!estimator_.isSynced()) {
+            return std::nullopt;
+        }
+        return fromUs(static_cast<double>(estimator_.toUs(mcuTime)));
+    }
+
+
+    std::optional<uint32_t> toMcuMs(Clock::time_point time)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!estimator_.isSynced()) {
+            return std::nullopt;
+        }
+        double mcuUs {estimator_.toMcuUs(static_cast<double>(toNs(time)))};
+        return static_cast<uint32_t>(static_cast<int64_t>(std::floor(mcuUs / 1000)));
+    }
+
+
+    Status getStatus()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        Status status {};
+        status.isSynced      = estimator_.isSynced();
+        status.driftPpm      = estimator_.getDriftPpm();
+        status.residual      = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds(std::llround(estimator_.getResidualNs())));
+        status.minRtt        = std::chrono::nanoseconds(estimator_.getMinRttNs());
+        status.pongsUsed     = estimator_.getUsedCount();
+        status.pingsSent     = pingsSent_;
+        status.pongsReceived = pongsReceived_;
+        return status;
+    }
+
+} // namespace uart::timesync
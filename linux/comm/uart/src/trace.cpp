@@ -0,0 +1,190 @@
+/**
+ * @file trace.cpp
+ * @brief Per-packet latency of each stage of the send and receive pipelines
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "comm/uart/trace.h"
+
+#include <csignal>
+#include <cstring>
+
+#include <unistd.h>
+
+namespace {
+    using uart::trace::Histogram;
+
+    static_assert(Histogram::bucketOf(Histogram::MAX_NS) == Histogram::BUCKET_COUNT - 1);
+    static_assert(Histogram::highestOf(Histogram::BUCKET_COUNT - 1) == Histogram::MAX_NS);
+
+    Histogram histograms_[uart::trace::SPAN_COUNT] {};
+    std::atomic_bool isEnabled_ {true};
+
+
+    // Line builder for dump(), snprintf isn't async-signal-safe
+    struct Line {
+        char text[160] {};
+        size_t len {0};
+
+        void append(const char *str)
+        {
+            while (*str != '\0' && len < sizeof(text)) {
+                text[len++] = *str++;
+            }
+        }
+
+        // Right-aligned in width columns
+        void append(uint64_t value, size_t width)
+        {
+            char digits[21];
+            size_t count {0};
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0);
+
+            for (size_t i = count; i < width && len < sizeof(text); i++) {
+                text[len++] = ' ';
+            }
+            while (count > 0 && len < sizeof(text)) {
+                text[len++] = digits[--count];
+            }
+        }
+
+        // Nanoseconds as microseconds with one decimal, right-aligned in width columns
+        void appendUs(uint64_t ns, size_t width)
+        {
+            uint64_t tenths {ns / 100};
+            append(tenths / 10, width > 2 ? width - 2 : 0);
+            append(".");
+            append(tenths % 10, 1);
+        }
+
+        void padTo(size_t column)
+        {
+            while (len < column && len < sizeof(text)) {
+                text[len++] = ' ';
+            }
+        }
+
+        void write(int fd) const
+        {
+            size_t off {0};
+            while (off < len) {
+                ssize_t written {::write(fd, text + off, len - off)};
+                if (written <= 0) {
+                    return;
+                }
+                off += static_cast<size_t>(written);
+            }
+        }
+    };
+
+
+    void onSignal(int) { uart::trace::dump(STDERR_FILENO); }
+
+} // namespace
+
+
+namespace uart::trace {
+    Histogram &get(eSpan span) { return histograms_[static_cast<size_t>(span)]; }
+
+
+    Snapshot snapshot(eSpan span)
+    {
+        const Histogram &histogram {get(span)};
+        Snapshot result {};
+        result.count  = histogram.getCount();
+        result.meanNs = result.count > 0 ? histogram.getTotalNs() / result.count : 0;
+        result.p50Ns  = histogram.percentileNs(50);
+        result.p90Ns  = histogram.percentileNs(90);
+        result.p99Ns  = histogram.percentileNs(99);
+        result.p999Ns = histogram.percentileNs(99.9);
+        result.maxNs  = histogram.getMaxNs();
+        return result;
+    }
+
+
+    void reset()
+    {
+        for (auto &histogram : histograms_) {
+            histogram.reset();
+        }
+    }
+
+
+    const char *toString(eSpan span)
+    {
+        switch (span) {
+        case eSpan::RX_ASSEMBLE:
+            return "rx assemble";
+        case eSpan::RX_FRAME:
+            return "rx frame+crc";
+        case eSpan::RX_ENQUEUE:
+            return "rx enqueue";
+        case eSpan::RX_QUEUE:
+            return "rx queue";
+        case eSpan::RX_TOTAL:
+            return "rx total";
+        case eSpan::TX_QUEUE:
+            return "tx queue";
+        case eSpan::TX_WRITE:
+            return "tx write";
+        case eSpan::TX_TOTAL:
+            return "tx total";
+        }
+        return "?";
+    }
+
+
+    void setEnabled(bool isEnabled) { isEnabled_.store(isEnabled, std::memory_order_relaxed); }
+
+
+    bool isEnabled() { return isEnabled_.load(std::memory_order_relaxed); }
+
+
+    void dump(int fd)
+    {
+        constexpr size_t WIDTH {10};
+
+        Line header {};
+        header.append("span (us)");
+        header.padTo(14);
+        for (const char *column : {"count", "mean", "p50", "p90", "p99", "p99.9", "max"}) {
+            header.padTo(header.len + WIDTH - strlen(column));
+            header.append(column);
+        }
+        header.append("\n");
+        header.write(fd);
+
+        for (size_t i = 0; i < SPAN_COUNT; i++) {
+            auto span {static_cast<eSpan>(i)};
+            const Histogram &histogram {get(span)};
+            uint64_t count {histogram.getCount()};
+
+            Line line {};
+            line.append(toString(span));
+            line.padTo(14);
+            line.append(count, WIDTH);
+            line.appendUs(count > 0 ? histogram.getTotalNs() / count : 0, WIDTH);
+            for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+                line.appendUs(histogram.percentileNs(percentile), WIDTH);
+            }
+            line.appendUs(histogram.getMaxNs(), WIDTH);
+            line.append("\n");
+            line.write(fd);
+        }
+    }
+
+
+    void dumpOnSignal(int signum)
+    {
+        struct sigaction action {};
+        action.sa_handler = onSignal;
+        action.sa_flags   = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(signum, &action, nullptr);
+    }
+
+} // namespace uart::trace
@@ -0,0 +1,64 @@
+/**
+ * @file pty.h
+ * @brief Pseudo-terminal pair standing in for the STM32 end of the UART
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef EMULATOR_PTY_H_
+#define EMULATOR_PTY_H_
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace emulator {
+    /**
+     * @class PtyPair
+     * @brief Opens a pty master. SerialUART opens getSlavePath() like a real port, and
+     *        the emulator or a benchmark reads/writes getMasterFd() as the microcontroller.
+     */
+    class PtyPair {
+      public:
+        PtyPair()
+        {
+            masterFd_ = posix_openpt(O_RDWR | O_NOCTTY);
+            if (masterFd_ == -1 || grantpt(masterFd_) == -1 || unlockpt(masterFd_) == -1) {
+                throw std::runtime_error("Failed to open pty");
+            }
+            slavePath_ = ptsname(masterFd_);
+
+            // Raw from the start, or whatever is written before the port is configured
+            // gets echoed back with its line endings translated
+            termios tty {};
+            if (tcgetattr(masterFd_, &tty) == 0) {
+                cfmakeraw(&tty);
+                tcsetattr(masterFd_, TCSANOW, &tty);
+            }
+        }
+
+        ~PtyPair() { close(masterFd_); }
+
+        PtyPair(const PtyPair &)            = delete;
+        PtyPair &operator=(const PtyPair &) = delete;
+
+        int getMasterFd() const noexcept { return masterFd_; }
+        const std::string &getSlavePath() const noexcept { return slavePath_; }
+
+        void setNonBlocking()
+        {
+            fcntl(masterFd_, F_SETFL, fcntl(masterFd_, F_GETFL) | O_NONBLOCK);
+        }
+
+      private:
+        int masterFd_ {-1};
+        std::string slavePath_;
+    };
+
+} // namespace emulator
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file stm32.h
+ * @brief Emulated STM32 end of the UART link on a pseudo-terminal
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#ifndef EMULATOR_STM32_H_
+#define EMULATOR_STM32_H_
+
+#include "emulator/pty.h"
+
+#include "comm/uart/packet_info.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace emulator {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief What the emulated STM32 sends, and what the emulated wire does to it */
+    struct Config {
+        // Streams, in frames per second. 0 turns a stream off.
+        double telemetryHz {100};
+        double batteryHz {1};
+        double statusHz {10};
+
+        uart::eWireFormat format {uart::eWireFormat::SYNC_LENGTH};
+        uart::eChecksum checksum {uart::eChecksum::CRC8};
+
+        // Bytes leave at this rate, 10 bits per byte. 0 writes as fast as the pty takes them.
+        uint32_t linkRateBps {115200};
+
+        // Fastest rate the emulated STM32 accepts in baud negotiation. A pty has no baud
+        // rate of its own, so this only bounds the handshake.
+        uint32_t maxBaudrate {2000000};
+
+        // Impairments, applied to every frame the emulator sends
+        double corruptRate {0};                  // Share of frames with one bit flipped
+        double burstLossRate {0};                // Chance per frame of a loss burst
+        size_t burstLength {5};                  // Frames lost per burst
+        std::chrono::microseconds maxJitter {0}; // Extra delay per frame, uniform
+        uint32_t seed {1};
+
+        // The STM32's clock, which stamps packets and time sync pongs. It reads
+        // clockStartUs at start() and runs clockDriftPpm fast.
+        uint64_t clockStartUs {0};
+        double clockDriftPpm {0};
+
+        // false echoes time sync pings unchanged, as firmware without time sync would
+        bool isTimesyncSupported {true};
+
+        // The STM32's receive buffer, in wire bytes. Frames landing when it's full are
+        // lost. The application empties it at rxConsumeBps, 0 as soon as frames land.
+        // Its room is advertised in STATUS_STM32, see uart::flow, unless isCreditAdvertised
+        // is false as in firmware without flow control.
+        uint16_t rxBufferBytes {1024};
+        uint32_t rxConsumeBps {0};
+        bool isCreditAdvertised {true};
+
+        // Called on the emulator's thread for every frame it generates, before impairments,
+        // e.g. to measure latency to recv::dequeue(). Must be quick.
+        std::function<void(const uart::DataPacket &, Clock::time_point)> onGenerate {};
+    };
+
+
+    struct Stats {
+        uint64_t generatedFrames {0}; // Streams and replies, before impairments
+        uint64_t sentFrames {0};
+        uint64_t sentBytes {0};
+        uint64_t corruptedFrames {0};
+        uint64_t droppedFrames {0}; // Lost in bursts, or while the Radxa wasn't reading
+
+        uint64_t receivedFrames {0}; // Valid frames from the Radxa
+        uint64_t receivedBytes {0};  // Of those, wire bytes
+        uint64_t overrunFrames {0};  // Lost to a full receive buffer
+        uint64_t crcErrors {0};
+        uint64_t acksSent {0};      // ACK_STM32 for reliable frames
+        uint64_t echoesSent {0};    // LINK_TEST echoes
+        uint64_t pongsSent {0};     // Time sync pongs, see uart::timesync
+        uint64_t creditUpdates {0}; // STATUS_STM32 sent early to return credit
+    };
+
+
+    /**
+     * @class Stm32
+     * @brief Speaks the DataPacket protocol as the STM32 would, on one thread.
+     *
+     * Streams TELEMETRY, BATTERY and STATUS_STM32 at the configured rates, acknowledges
+     * reliable frames with ACK_STM32, echoes LINK_TEST, answers time sync pings and baud
+     * negotiation. Frames from the Radxa pass through a receive buffer of its own, whose
+     * credit STATUS_STM32 advertises.
+     * Open getDevicePath() with SerialUART, or pass it to uart::manager::init(), to run
+     * the real comm stack without hardware.
+     */
+    class Stm32 {
+      public:
+        explicit Stm32(Config config = {});
+        ~Stm32();
+
+        Stm32(const Stm32 &)            = delete;
+        Stm32 &operator=(const Stm32 &) = delete;
+
+        void start();
+        void stop();
+        bool isRunning() const noexcept { return isRunning_; }
+
+        // pty slave to open as the UART device
+        const std::string &getDevicePath() const noexcept { return pty_.getSlavePath(); }
+
+        Stats getStats() const;
+
+        // Emulated STM32 clock at time, in microseconds. Its packet timestamps are this
+        // divided by 1000 and truncated to 32 bits.
+        uint64_t getClockUs(Clock::time_point time) const;
+
+      private:
+        void threadLoop();
+
+        Config config_;
+        PtyPair pty_;
+
+        std::atomic_bool isRunning_ {false};
+        std::thread thread_;
+        Clock::time_point bootTime_ {Clock::now()};
+
+        mutable std::mutex statsMtx_;
+        Stats stats_ {};
+    };
+
+} // namespace emulator
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file main.cpp
+ * @brief Runs an emulated STM32 on a pty until interrupted
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * Prints the pty to use as the UART device, e.g. `pacerBot /dev/pts/3`.
+ *
+ * Usage: stm32Emulator [--telemetry-hz N] [--battery-hz N] [--status-hz N]
+ *                      [--link-rate BPS] [--cobs] [--crc32] [--corrupt P]
+ *                      [--burst-loss P] [--burst-length N] [--jitter-us N] [--seed N]
+ */
+
+#include "emulator/stm32.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+    std::atomic_bool isInterrupted_ {false};
+
+    void onSignal(int) { isInterrupted_ = true; }
+
+
+    bool parseArgs(int argc, char *argv[], emulator::Config &config)
+    {
+        for (int i = 1; i < argc; i++) {
+            const char *flag {argv[i]};
+            if (std::strcmp(flag, "--cobs") == 0) {
+                config.format = uart::eWireFormat::COBS;
+                continue;
+            }
+            if (std::strcmp(flag, "--crc32") == 0) {
+                config.checksum = uart::eChecksum::CRC32;
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                return false;
+            }
+            const char *value {argv[++i]};
+
+            if (std::strcmp(flag, "--telemetry-hz") == 0) {
+                config.telemetryHz = std::atof(value);
+            } else if (std::strcmp(flag, "--battery-hz") == 0) {
+                config.batteryHz = std::atof(value);
+            } else if (std::strcmp(flag, "--status-hz") == 0) {
+                config.statusHz = std::atof(value);
+            } else if (std::strcmp(flag, "--link-rate") == 0) {
+                config.linkRateBps = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else if (std::strcmp(flag, "--corrupt") == 0) {
+                config.corruptRate = std::atof(value);
+            } else if (std::strcmp(flag, "--burst-loss") == 0) {
+                config.burstLossRate = std::atof(value);
+            } else if (std::strcmp(flag, "--burst-length") == 0) {
+                config.burstLength = std::strtoul(value, nullptr, 10);
+            } else if (std::strcmp(flag, "--jitter-us") == 0) {
+                config.maxJitter = std::chrono::microseconds(std::strtoll(value, nullptr, 10));
+            } else if (std::strcmp(flag, "--seed") == 0) {
+                config.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+
+    void printStats(const emulator::Stats &stats)
+    {
+        std::printf("sent %llu frames (%llu B), corrupted %llu, dropped %llu | received %llu, "
+                    "crc errors %llu, acks %llu, echoes %llu\n",
+                    static_cast<unsigned long long>(stats.sentFrames),
+                    static_cast<unsigned long long>(stats.sentBytes),
+                    static_cast<unsigned long long>(stats.corruptedFrames),
+                    static_cast<unsigned long long>(stats.droppedFrames),
+                    static_cast<unsigned long long>(stats.receivedFrames),
+                    static_cast<unsigned long long>(stats.crcErrors),
+                    static_cast<unsigned long long>(stats.acksSent),
+                    static_cast<unsigned long long>(stats.echoesSent));
+    }
+
+} // namespace
+
+
+int main(int argc, char *argv[])
+{
+    emulator::Config config {};
+    if (!parseArgs(argc, argv, config)) {
+        std::fprintf(stderr, "Usage: %s [--telemetry-hz N] [--battery-hz N] [--status-hz N]\n"
+                             "       [--link-rate BPS] [--cobs] [--crc32] [--corrupt P]\n"
+                             "       [--burst-loss P] [--burst-length N] [--jitter-us N]\n"
+                             "       [--seed N]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    emulator::Stm32 stm32 {config};
+    stm32.start();
+    std::printf("Emulated STM32 on %s\n", stm32.getDevicePath().c_str());
+    std::fflush(stdout);
+
+    // Report every few seconds until interrupted
+    int ticks {0};
+    while (!isInterrupted_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (++ticks % 50 == 0) {
+            printStats(stm32.getStats());
+            std::fflush(stdout);
+        }
+    }
+
+    stm32.stop();
+    printStats(stm32.getStats());
+    return 0;
+}
@@ -0,0 +1,485 @@
+/**
+ * @file stm32.cpp
+ * @brief Emulated STM32 end of the UART link on a pseudo-terminal
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "emulator/stm32.h"
+
+#include "comm/uart/arq.h"
+#include "comm/uart/baud_negotiation.h"
+#include "comm/uart/clock_sync.h"
+#include "comm/uart/cobs.h"
+#include "comm/uart/flow_control.h"
+#include "comm/uart/framer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <numbers>
+#include <random>
+
+#include <poll.h>
+
+namespace {
+    using emulator::Clock;
+
+    // Longest the loop sleeps, so stop() and baud trial timeouts are noticed
+    constexpr auto MAX_IDLE = std::chrono::milliseconds(10);
+
+    // Frames waiting for the wire. More are dropped, as the STM32's TX buffer would.
+    constexpr size_t MAX_PENDING_FRAMES {256};
+
+    struct Stream {
+        uart::ePacketID id {};
+        Clock::duration period {};
+        Clock::time_point next {};
+    };
+
+    struct PendingFrame {
+        std::array<uint8_t, uart::cobs::MAX_FRAME_SIZE> bytes {};
+        size_t size {0};
+        Clock::time_point due {};    // Earliest it may start, after jitter
+        Clock::time_point doneAt {}; // Last byte on the wire, set once at the front
+    };
+
+    // Frame from the Radxa, stored once its last byte would have crossed the wire and
+    // handled once the application gets to it
+    struct ReceivedFrame {
+        uart::DataPacket packet;
+        size_t size;                    // Wire bytes
+        Clock::time_point doneAt;       // Lands in the receive buffer
+        Clock::time_point consumeAt {}; // Application is done with it
+    };
+
+    // Everything the emulator's thread owns
+    struct Link {
+        Link(const emulator::Config &linkConfig, int masterFd, Clock::time_point boot)
+            : config(linkConfig),
+              fd(masterFd),
+              rng(linkConfig.seed),
+              framer(linkConfig.format, linkConfig.checksum),
+              responder(linkConfig.maxBaudrate),
+              advertiser(linkConfig.rxBufferBytes),
+              bootTime(boot)
+        {
+        }
+
+        const emulator::Config &config;
+        int fd;
+
+        std::minstd_rand rng;
+        std::deque<PendingFrame> txQueue {};
+        Clock::time_point wireFree {};
+        size_t burstLeft {0};
+
+        // A pty delivers the Radxa's bytes at once, a UART takes as long as ours do
+        std::deque<ReceivedFrame> rxQueue {};
+        Clock::time_point rxWireFree {};
+
+        // The STM32's receive buffer, and when the application is done with its last frame
+        std::deque<ReceivedFrame> rxBuffer {};
+        size_t rxBuffered {0};
+        Clock::time_point consumerFree {};
+
+        uart::Framer framer;
+        uart::arq::Receiver receiver {};
+        uart::baud::Responder responder;
+        uart::flow::Advertiser advertiser;
+
+        Clock::time_point bootTime;
+        emulator::Stats stats {};
+    };
+
+
+    uint32_t msSince(Clock::time_point start, Clock::time_point now)
+    {
+        return static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - start).count());
+    }
+
+
+    uint64_t clockUs(const emulator::Config &config, Clock::time_point boot,
+                     Clock::time_point now)
+    {
+        double elapsedUs {std::chrono::duration<double, std::micro>(now - boot).count()};
+        return config.clockStartUs
+             + static_cast<uint64_t>(std::llround(elapsedUs * (1 + config.clockDriftPpm * 1e-6)));
+    }
+
+
+    // HAL tick and SysTick microseconds, as the firmware would read them
+    uart::timesync::McuTime mcuTime(const Link &link, Clock::time_point now)
+    {
+        uint64_t us {clockUs(link.config, link.bootTime, now)};
+        return {static_cast<uint32_t>(us / 1000), static_cast<uint16_t>(us % 1000)};
+    }
+
+
+    // Time size bytes take at bitsPerSec, 10 bits per byte
+    Clock::duration byteTime(uint32_t bitsPerSec, size_t size)
+    {
+        return std::chrono::nanoseconds(
+            bitsPerSec == 0 ? 0 : 1'000'000'000LL * 10 * static_cast<long long>(size) / bitsPerSec);
+    }
+
+
+    // Time size bytes take on the wire at the link rate
+    Clock::duration wireTime(const Link &link, size_t size)
+    {
+        return byteTime(link.config.linkRateBps, size);
+    }
+
+
+    uart::DataPacket makeStatus(Link &link)
+    {
+        uart::payload::StatusStm32 status {};
+        status.state      = 1;
+        status.rx_errors  = static_cast<uint16_t>(link.stats.crcErrors);
+        if (link.config.isCreditAdvertised) {
+            link.advertiser.fill(status);
+        }
+        return uart::makePacket<uart::ePacketID::STATUS_STM32>(status);
+    }
+
+
+    bool isChance(Link &link, double probability)
+    {
+        return probability > 0 && std::bernoulli_distribution {probability}(link.rng);
+    }
+
+
+    // Stamps packet with the STM32 clock and queues it for the wire, through the impairments
+    void transmit(Link &link, uart::DataPacket packet, Clock::time_point now)
+    {
+        const auto &config = link.config;
+        packet.setTimestamp(mcuTime(link, now).ms);
+        link.stats.generatedFrames++;
+        if (config.onGenerate) {
+            config.onGenerate(packet, now);
+        }
+
+        if (link.burstLeft == 0 && isChance(link, config.burstLossRate)) {
+            link.burstLeft = std::max<size_t>(config.burstLength, 1);
+        }
+        if (link.burstLeft > 0 || link.txQueue.size() >= MAX_PENDING_FRAMES) {
+            link.burstLeft -= link.burstLeft > 0 ? 1 : 0;
+            link.stats.droppedFrames++;
+            return;
+        }
+
+        PendingFrame frame {};
+        frame.size = packet.serialize(frame.bytes.data(), frame.bytes.size(), config.format,
+                                      config.checksum);
+
+        if (isChance(link, config.corruptRate)) {
+            size_t bit {link.rng() % (frame.size * 8)};
+            frame.bytes[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+            link.stats.corruptedFrames++;
+        }
+
+        // A late frame holds up the ones behind it, a UART sends in order
+        auto jitter = std::chrono::microseconds(
+            config.maxJitter.count() > 0 ? link.rng() % (config.maxJitter.count() + 1) : 0);
+        frame.due = now + jitter;
+        if (!link.txQueue.empty()) {
+            frame.due = std::max(frame.due, link.txQueue.back().due);
+        }
+        link.txQueue.push_back(frame);
+    }
+
+
+    // Writes frames whose last byte has reached the Radxa by now
+    void flush(Link &link, Clock::time_point now)
+    {
+        while (!link.txQueue.empty()) {
+            auto &frame = link.txQueue.front();
+            if (frame.due > now) {
+                return;
+            }
+
+            if (frame.doneAt == Clock::time_point {}) {
+                frame.doneAt  = std::max(frame.due, link.wireFree) + wireTime(link, frame.size);
+                link.wireFree = frame.doneAt;
+            }
+            if (frame.doneAt > now) {
+                return;
+            }
+
+            ssize_t written {write(link.fd, frame.bytes.data(), frame.size)};
+            if (written <= 0) {
+                return; // Radxa isn't reading, try again later
+            }
+
+            link.stats.sentBytes += static_cast<uint64_t>(written);
+            if (static_cast<size_t>(written) < frame.size) {
+                frame.size -= static_cast<size_t>(written);
+                std::copy_n(frame.bytes.begin() + written, frame.size, frame.bytes.begin());
+                return;
+            }
+            link.stats.sentFrames++;
+            link.txQueue.pop_front();
+        }
+    }
+
+
+    void onFrame(Link &link, const uart::DataPacket &frame, Clock::time_point now)
+    {
+        auto id {static_cast<uint8_t>(frame.getID())};
+        auto data = frame.getData();
+        link.stats.receivedFrames++;
+
+        if ((id & uart::RELIABLE_FLAG) && !data.empty()) {
+            link.receiver.accept(data[0], (id & uart::RELIABLE_SYN_FLAG) != 0);
+            transmit(link, uart::makePacket<uart::ePacketID::ACK_STM32>(link.receiver.getAck()),
+                     now);
+            link.stats.acksSent++;
+            return;
+        }
+
+        uart::payload::LinkTest ping {};
+        if (frame.getID() == uart::ePacketID::LINK_TEST && link.config.isTimesyncSupported
+            && uart::schema::decode(data.data(), data.size(), ping)
+            && uart::timesync::isSyncSeq(ping.seq)) {
+            uart::timesync::stampPong(ping, mcuTime(link, now), mcuTime(link, Clock::now()));
+            transmit(link, uart::makePacket<uart::ePacketID::LINK_TEST>(ping), now);
+            link.stats.pongsSent++;
+            return;
+        }
+
+        if (frame.getID() == uart::ePacketID::LINK_TEST) {
+            transmit(link, uart::DataPacket(uart::ePacketID::LINK_TEST, data), now);
+            link.stats.echoesSent++;
+            return;
+        }
+
+        uart::payload::ConfigBaud request {};
+        uart::payload::ConfigBaud reply {};
+        if (frame.getID() == uart::ePacketID::CONFIG_BAUD
+            && uart::schema::decode(data.data(), data.size(), request)
+            && link.responder.onRequest(request, msSince(link.bootTime, now), reply)) {
+            transmit(link, uart::makePacket<uart::ePacketID::CONFIG_BAUD>(reply), now);
+        }
+    }
+
+
+    // Stores a frame that came off the wire, unless the receive buffer has no room for it
+    void land(Link &link, ReceivedFrame frame)
+    {
+        if (link.rxBuffered + frame.size > link.config.rxBufferBytes) {
+            link.stats.overrunFrames++;
+            return;
+        }
+
+        frame.consumeAt   = std::max(frame.doneAt, link.consumerFree)
+                          + byteTime(link.config.rxConsumeBps, frame.size);
+        link.consumerFree = frame.consumeAt;
+        link.rxBuffered += frame.size;
+        link.advertiser.onReceived(static_cast<uint32_t>(frame.size));
+        link.rxBuffer.push_back(std::move(frame));
+    }
+
+
+    // Hands the oldest buffered frame to the application, returning credit once enough
+    // has been freed
+    void consume(Link &link, Clock::time_point now)
+    {
+        ReceivedFrame frame {std::move(link.rxBuffer.front())};
+        link.rxBuffer.pop_front();
+        link.rxBuffered -= frame.size;
+        link.advertiser.onConsumed(static_cast<uint32_t>(frame.size));
+        link.stats.receivedBytes += frame.size;
+        onFrame(link, frame.packet, now);
+
+        if (link.config.isCreditAdvertised && link.advertiser.shouldAdvertise()) {
+            transmit(link, makeStatus(link), now);
+            link.stats.creditUpdates++;
+        }
+    }
+
+
+    void receive(Link &link, Clock::time_point now)
+    {
+        uint8_t chunk[256];
+        ssize_t len {0};
+        std::array<uint8_t, uart::cobs::MAX_FRAME_SIZE> wire {};
+
+        while ((len = read(link.fd, chunk, sizeof(chunk))) > 0) {
+            link.framer.push(chunk, static_cast<size_t>(len));
+            while (auto view = link.framer.next()) {
+                auto packet = view->toPacket();
+                size_t size {packet.serialize(wire.data(), wire.size(), link.config.format,
+                                              link.config.checksum)};
+                auto doneAt     = std::max(now, link.rxWireFree) + wireTime(link, size);
+                link.rxWireFree = doneAt;
+                link.rxQueue.push_back({std::move(packet), size, doneAt});
+            }
+        }
+        link.stats.crcErrors = link.framer.getCrcErrors();
+
+        // Landing and consuming in time order, so the buffer fills as it would
+        while (true) {
+            bool canLand {!link.rxQueue.empty() && link.rxQueue.front().doneAt <= now};
+            bool canConsume {!link.rxBuffer.empty() && link.rxBuffer.front().consumeAt <= now};
+            if (canConsume && (!canLand
+                               || link.rxBuffer.front().consumeAt <= link.rxQueue.front().doneAt)) {
+                consume(link, now);
+            } else if (canLand) {
+                land(link, std::move(link.rxQueue.front()));
+                link.rxQueue.pop_front();
+            } else {
+                break;
+            }
+        }
+    }
+
+
+    // Readings that move like a robot driving laps, with sensor noise
+    uart::DataPacket makeStreamPacket(Link &link, uart::ePacketID id, Clock::time_point now)
+    {
+        double seconds {std::chrono::duration<double>(now - link.bootTime).count()};
+        std::normal_distribution<double> noise {0, 4};
+        auto noisy = [&](double value) {
+            return static_cast<int16_t>(std::lround(value + noise(link.rng)));
+        };
+
+        if (id == uart::ePacketID::BATTERY) {
+            // Drains from full over an hour
+            double percent {std::max(0.0, 100.0 - seconds / 36.0)};
+            return uart::makePacket<uart::ePacketID::BATTERY>(
+                {static_cast<uint16_t>(6600 + 18 * percent), static_cast<uint8_t>(percent)});
+        }
+
+        if (id == uart::ePacketID::STATUS_STM32) {
+            return makeStatus(link);
+        }
+
+        double speed {500 + 500 * std::sin(2 * std::numbers::pi * seconds / 10)};
+        uart::payload::Telemetry telemetry {};
+        telemetry.imu              = {noisy(0), noisy(0), noisy(16384), noisy(0), noisy(0),
+                                      noisy(0)};
+        telemetry.speed_left_mmps  = noisy(speed);
+        telemetry.speed_right_mmps = noisy(speed);
+        telemetry.ultrasonic_mm    = static_cast<uint16_t>(3000 - std::fmod(speed * seconds, 2800));
+        telemetry.pid_speed_out    = static_cast<int16_t>(speed / 2);
+        telemetry.pid_lane_out     = noisy(0);
+        return uart::makePacket<uart::ePacketID::TELEMETRY>(telemetry);
+    }
+
+} // namespace
+
+
+namespace emulator {
+    Stm32::Stm32(Config config) : config_(std::move(config))
+    {
+        pty_.setNonBlocking();
+    }
+
+
+    Stm32::~Stm32()
+    {
+        if (isRunning_) {
+            stop();
+        }
+    }
+
+
+    void Stm32::start()
+    {
+        bootTime_  = Clock::now();
+        isRunning_ = true;
+        thread_    = std::thread(&Stm32::threadLoop, this);
+    }
+
+
+    void Stm32::stop()
+    {
+        isRunning_ = false;
+        thread_.join();
+    }
+
+
+    Stats Stm32::getStats() const
+    {
+        std::lock_guard<std::mutex> lock(statsMtx_);
+        return stats_;
+    }
+
+
+    uint64_t Stm32::getClockUs(Clock::time_point time) const
+    {
+        return clockUs(config_, bootTime_, time);
+    }
+
+
+    void Stm32::threadLoop()
+    {
+        Link link {config_, pty_.getMasterFd(), bootTime_};
+
+        std::array<Stream, 3> streams {{{uart::ePacketID::TELEMETRY, {}, {}},
+                                        {uart::ePacketID::BATTERY, {}, {}},
+                                        {uart::ePacketID::STATUS_STM32, {}, {}}}};
+        const double rates[] {config_.telemetryHz, config_.batteryHz, config_.statusHz};
+        for (size_t i = 0; i < streams.size(); i++) {
+            streams[i].period = rates[i] > 0 ? std::chrono::duration_cast<Clock::duration>(
+                                                   std::chrono::duration<double>(1 / rates[i]))
+                                             : Clock::duration::max();
+            streams[i].next   = link.bootTime;
+        }
+
+        while (isRunning_) {
+            auto now = Clock::now();
+            receive(link, now);
+            link.responder.poll(msSince(link.bootTime, now));
+
+            for (auto &stream : streams) {
+                if (stream.period == Clock::duration::max()) {
+                    continue;
+                }
+                while (stream.next <= now) {
+                    transmit(link, makeStreamPacket(link, stream.id, now), now);
+                    stream.next += stream.period;
+                }
+            }
+            flush(link, now);
+
+            {
+                std::lock_guard<std::mutex> lock(statsMtx_);
+                stats_ = link.stats;
+            }
+
+            // Sleep until the next frame is due or the Radxa sends something
+            auto wakeAt = now + MAX_IDLE;
+            for (const auto &stream : streams) {
+                if (stream.period != Clock::duration::max()) {
+                    wakeAt = std::min(wakeAt, stream.next);
+                }
+            }
+            if (!link.rxQueue.empty()) {
+                wakeAt = std::min(wakeAt, link.rxQueue.front().doneAt);
+            }
+            if (!link.rxBuffer.empty()) {
+                wakeAt = std::min(wakeAt, link.rxBuffer.front().consumeAt);
+            }
+            pollfd pfd {pty_.getMasterFd(), POLLIN, 0};
+            if (!link.txQueue.empty()) {
+                const auto &front = link.txQueue.front();
+                if (front.doneAt == Clock::time_point {}) {
+                    wakeAt = std::min(wakeAt, front.due);
+                } else if (front.doneAt > now) {
+                    wakeAt = std::min(wakeAt, front.doneAt);
+                } else {
+                    pfd.events |= POLLOUT; // pty buffer was full
+                }
+            }
+
+            auto wait = std::max(Clock::duration::zero(), wakeAt - Clock::now());
+            auto ns   = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+            timespec timeout {static_cast<time_t>(ns / 1'000'000'000), ns % 1'000'000'000};
+            ppoll(&pfd, 1, &timeout, nullptr);
+        }
+    }
+
+} // namespace emulator
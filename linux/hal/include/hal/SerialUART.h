@@ -11,12 +11,12 @@
 #ifndef SERIAL_UART_H_
 #define SERIAL_UART_H_
 
+#include <atomic>
 #include <iostream>
 #include <cstdint>
 
 /**
  * A List of Functions That can be Added:
- * - Changing Baudrate
  * - Change device file
  * - UART protocol configuration (parity, stop bit, etc.)
  */
@@ -34,10 +34,11 @@ class SerialUART {
     /**
      * @brief Constructs a SerialUART object.
      * @param device Path to the UART device file (e.g. "/dev/ttyS0").
-     * @param baudrate Baud rate for the serial communication (e.g. B9600, B115200).
+     * @param baudrate Baud rate in bits per second (e.g. 115200, 921600). Any rate
+     *        the driver supports, not just the standard Bxxx ones.
      * @param timeout_sec Wait time until read or write times out.
      */
-    SerialUART(const std::string &device, int baudrate, int timeout_sec);
+    SerialUART(const std::string &device, uint32_t baudrate, int timeout_sec);
 
     /**
      * @brief Closes the port if open and destruct the object instance.
@@ -83,6 +84,43 @@ class SerialUART {
      */
     bool isOpen() const;
 
+    /**
+     * @brief Switches the port between blocking and non-blocking I/O.
+     *
+     * In non-blocking mode readData() and writeData() return 0 instead of waiting
+     * when the port isn't ready. Use getFd() to wait for readiness with epoll.
+     * @param enable true for O_NONBLOCK.
+     * @throws SerialException if the port is not open or fcntl fails.
+     */
+    void setNonBlocking(bool enable);
+
+    /**
+     * @brief Gets the file descriptor, for use with poll/epoll.
+     * @return The descriptor, or -1 if the port is not open.
+     */
+    int getFd() const;
+
+    /**
+     * @brief Changes the baud rate, after any pending output has been sent.
+     * @param baudrate Baud rate in bits per second.
+     * @throws SerialException if the driver rejects the rate.
+     */
+    void setBaudrate(uint32_t baudrate);
+
+    /**
+     * @brief Gets the baud rate, safe to call from any thread.
+     * @return Baud rate in bits per second.
+     */
+    uint32_t getBaudrate() const;
+
+    /**
+     * @brief Turns RTS/CTS hardware flow control on or off. Off by default. Applied
+     *        straight away if the port is open, otherwise by openPort().
+     * @param enable true for CRTSCTS. The other end must use it too.
+     * @throws SerialException if configuration fails.
+     */
+    void setHardwareFlowControl(bool enable);
+
 	/**
 	 * @brief Set read/write timeout if there is no data.
 	 * @param seconds Duration in seconds before timeout.
@@ -92,8 +130,9 @@ class SerialUART {
 
   private:
     std::string device_;  ///< Path to UART device file.
-    int baudrate_;        ///< Baud rate for communication.
+    std::atomic<uint32_t> baudrate_; ///< Baud rate for communication, bits/s.
     int timeout_sec_;     ///< Timeout for read & write
+    bool isHwFlowControl_ {false}; ///< RTS/CTS enabled
     int fd_ {-1};         ///< File Descriptor for the UART port.
     bool isOpen_ {false}; ///< Indicates if UART port is currently open.
 
@@ -11,6 +11,9 @@
 #include "hal/SerialUART.h"
 #include "hal/exception/SerialException.h"
 
+#include "termios2.h"
+
+#include <cerrno>
 #include <cstring>
 #include <iostream>
 
@@ -20,7 +23,7 @@
 #include <unistd.h>
 
 
-SerialUART::SerialUART(const std::string &device, int baudrate, int timeout_sec)
+SerialUART::SerialUART(const std::string &device, uint32_t baudrate, int timeout_sec)
     : device_(device), baudrate_(baudrate), timeout_sec_(timeout_sec)
 {}
 
@@ -82,6 +85,10 @@ ssize_t SerialUART::readData(uint8_t *buffer, size_t size) const
     }
 
     ssize_t bytesRead = read(fd_, buffer, size);
+    if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0; // Non-blocking mode, nothing to read yet
+    }
+
     if (bytesRead < 0) {
         throw SerialException("Failed to read from UART: "
                               + std::string(strerror(errno)));
@@ -97,6 +104,10 @@ ssize_t SerialUART::writeData(const uint8_t *data, size_t size) const
     }
 
     int bytesWritten = write(fd_, data, size);
+    if (bytesWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return 0; // Non-blocking mode, output buffer is full
+    }
+
     if (bytesWritten < 0) {
         throw SerialException("Failed to write to UART: " + std::string(strerror(errno)));
     }
@@ -108,6 +119,53 @@ ssize_t SerialUART::writeData(const uint8_t *data, size_t size) const
 bool SerialUART::isOpen() const { return isOpen_; }
 
 
+void SerialUART::setNonBlocking(bool enable)
+{
+    if (!isOpen_) {
+        throw SerialException("Attempted to set O_NONBLOCK, UART port is not open");
+    }
+
+    int flags = fcntl(fd_, F_GETFL);
+    if (flags == -1) {
+        throw SerialException("Failed to get UART flags: " + std::string(strerror(errno)));
+    }
+
+    flags = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    if (fcntl(fd_, F_SETFL, flags) == -1) {
+        throw SerialException("Failed to set UART flags: " + std::string(strerror(errno)));
+    }
+}
+
+
+int SerialUART::getFd() const { return isOpen_ ? fd_ : -1; }
+
+
+void SerialUART::setBaudrate(uint32_t baudrate)
+{
+    if (isOpen_) {
+        tcdrain(fd_); // Let queued bytes go out at the old rate
+        if (!termios_baud::setBaudrate(fd_, baudrate)) {
+            throw SerialException("Failed to set baud rate " + std::to_string(baudrate)
+                                  + ": " + strerror(errno));
+        }
+    }
+
+    baudrate_ = baudrate;
+}
+
+
+uint32_t SerialUART::getBaudrate() const { return baudrate_; }
+
+
+void SerialUART::setHardwareFlowControl(bool enable)
+{
+    isHwFlowControl_ = enable;
+    if (isOpen_) {
+        configurePort();
+    }
+}
+
+
 void SerialUART::setTimeout(int seconds)
 {
     timeout_sec_ = seconds;
@@ -120,19 +178,25 @@ void SerialUART::configurePort() const
     struct termios options;
     memset(&options, 0, sizeof(options)); // Zero out structure
 
-    constexpr int MIN_BYTES {1};
+    constexpr int MIN_BYTES {0};
     const int TIMEOUT_DS {timeout_sec_ * 10}; // Timeout in deciseconds
 
-    options.c_cflag = B115200 | CS8 | CREAD | CLOCAL; // 115200 baud, 8N1, raw mode
-    options.c_cflag &= ~PARENB;                       // No parity
-    options.c_cflag &= ~CSTOPB;                       // 1 stop bit
-    options.c_cflag &= ~CRTSCTS;                      // No hardware flow control
+    options.c_cflag = CS8 | CREAD | CLOCAL; // 8N1, raw mode, baud rate set below
+    options.c_cflag &= ~PARENB;             // No parity
+    options.c_cflag &= ~CSTOPB;             // 1 stop bit
+    if (isHwFlowControl_) {
+        options.c_cflag |= CRTSCTS; // RTS/CTS, see setHardwareFlowControl()
+    } else {
+        options.c_cflag &= ~CRTSCTS; // No hardware flow control
+    }
 
     options.c_iflag = IGNPAR; // Ignore parity errors
     options.c_oflag = 0;      // Raw output
     options.c_lflag = 0;      // Raw input
 
-    options.c_cc[VMIN]  = MIN_BYTES;  // Block until at least 1 byte
+    // Return as soon as any byte arrives, or with 0 bytes after the timeout, so the
+    // recv thread can notice a silent link and be stopped
+    options.c_cc[VMIN]  = MIN_BYTES;
     options.c_cc[VTIME] = TIMEOUT_DS; // 1 second timeout
 
     tcflush(fd_, TCIOFLUSH); // Flush buffers before applying settings
@@ -142,5 +206,11 @@ void SerialUART::configurePort() const
                               + std::string(strerror(errno)));
     }
 
+    // Any rate, not just the Bxxx constants termios offers
+    if (!termios_baud::setBaudrate(fd_, baudrate_)) {
+        throw SerialException("Failed to set baud rate " + std::to_string(baudrate_)
+                              + ": " + strerror(errno));
+    }
+
     tcdrain(fd_); // Wait for settings to apply
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+/**
+ * @file termios2.cpp
+ * @brief Arbitrary baud rates through termios2 and BOTHER
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ */
+
+#include "termios2.h"
+
+#include <asm/termbits.h>
+#include <sys/ioctl.h>
+
+namespace termios_baud {
+    bool setBaudrate(int fd, uint32_t baudrate)
+    {
+        struct termios2 options {};
+        if (ioctl(fd, TCGETS2, &options) == -1) {
+            return false;
+        }
+
+        // BOTHER takes the rate from c_ispeed/c_ospeed instead of a Bxxx constant
+        options.c_cflag &= ~CBAUD;
+        options.c_cflag |= BOTHER;
+        options.c_cflag &= ~(CBAUD << IBSHIFT);
+        options.c_cflag |= BOTHER << IBSHIFT;
+        options.c_ispeed = baudrate;
+        options.c_ospeed = baudrate;
+
+        return ioctl(fd, TCSETS2, &options) != -1;
+    }
+
+
+    uint32_t getBaudrate(int fd)
+    {
+        struct termios2 options {};
+        if (ioctl(fd, TCGETS2, &options) == -1) {
+            return 0;
+        }
+        return options.c_ospeed;
+    }
+
+} // namespace termios_baud
@@ -0,0 +1,28 @@
+/**
+ * @file termios2.h
+ * @brief Arbitrary baud rates through termios2 and BOTHER
+ * @author Hayden Mai
+ * @date Oct-17-2026
+ *
+ * <asm/termbits.h> redefines struct termios from <termios.h>, so these live in their
+ * own translation unit and only plain types cross the boundary.
+ */
+
+#ifndef HAL_TERMIOS2_H_
+#define HAL_TERMIOS2_H_
+
+#include <cstdint>
+
+namespace termios_baud {
+    /**
+     * @brief Sets input and output speed to any rate the driver supports.
+     * @return false on failure, with errno set.
+     */
+    bool setBaudrate(int fd, uint32_t baudrate);
+
+    /** @brief Current output speed in bits per second, or 0 on failure */
+    uint32_t getBaudrate(int fd);
+
+} // namespace termios_baud
+
+#endif
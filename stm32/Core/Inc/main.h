@@ -53,7 +53,7 @@ extern "C" {
 void Error_Handler(void);
 
 /* USER CODE BEGIN EFP */
-
+HAL_StatusTypeDef UART1_SetBaudRate(uint32_t baudrate);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
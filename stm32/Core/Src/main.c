@@ -390,6 +390,24 @@ static void MX_GPIO_Init(void)
 
 /* USER CODE BEGIN 4 */
 
+/**
+  * @brief  Changes the USART1 baud rate at runtime, for the baud handshake in
+  *         comm/uart/baud_negotiation.h. Call once the reply at the old rate has
+  *         been sent (UART_FLAG_TC set), as reinitialising aborts any transfer.
+  * @param  baudrate: Rate in bits per second, the Radxa only proposes up to 2000000
+  * @retval HAL status
+  */
+HAL_StatusTypeDef UART1_SetBaudRate(uint32_t baudrate)
+{
+  if (HAL_UART_DeInit(&huart1) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  huart1.Init.BaudRate = baudrate;
+  return HAL_UART_Init(&huart1);
+}
+
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartDefaultTask */